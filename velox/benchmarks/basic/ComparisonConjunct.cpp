@@ -45,6 +45,21 @@ struct PlusFunction {
   }
 };
 
+// Stands for an expensive predicate such as a regular expression match.
+template <typename T>
+struct SlowLtFunction {
+  template <typename TInput>
+  FOLLY_ALWAYS_INLINE void
+  call(bool& result, const TInput& a, const TInput& b) {
+    TInput x = a;
+    for (auto i = 0; i < 50; ++i) {
+      x = std::sqrt(x * x + 1);
+    }
+    folly::doNotOptimizeAway(x);
+    result = a < b;
+  }
+};
+
 class ComparisonBenchmark : public functions::test::FunctionBenchmarkBase {
  public:
   explicit ComparisonBenchmark(size_t vectorSize) : FunctionBenchmarkBase() {
@@ -58,6 +73,7 @@ class ComparisonBenchmark : public functions::test::FunctionBenchmarkBase {
 
     // Use it as a baseline.
     registerFunction<PlusFunction, double, double, double>({"plus"});
+    registerFunction<SlowLtFunction, bool, double, double>({"slow_lt"});
 
     // Set input schema.
     inputType_ = ROW({
@@ -94,6 +110,14 @@ class ComparisonBenchmark : public functions::test::FunctionBenchmarkBase {
         pool(), inputType_, nullptr, vectorSize, std::move(children));
   }
 
+  // Enables or disables the reordering of conjunct inputs by their cost per
+  // dropped row for the expressions compiled afterwards.
+  void setAdaptiveFilterReordering(bool enabled) {
+    queryCtx_->testingOverrideConfigUnsafe(
+        {{core::QueryConfig::kAdaptiveFilterReorderingEnabled,
+          enabled ? "true" : "false"}});
+  }
+
   // Runs `expression` `times` times.
   size_t run(const std::string& expression, size_t times = 100) {
     folly::BenchmarkSuspender suspender;
@@ -172,6 +196,39 @@ BENCHMARK(conjunctsNested) {
   benchmark->run("(d OR e) AND ((d AND (neq(d, (d OR e)))) OR (eq(a, b)))");
 }
 
+BENCHMARK_DRAW_LINE();
+
+// An expensive conjunct that drops about half of the rows is written before a
+// cheap one that also drops about half. With reordering the cheap one runs
+// first and the expensive one only sees the rows it passes.
+BENCHMARK(andExpensiveFirstNoReorder) {
+  folly::BenchmarkSuspender suspender;
+  benchmark->setAdaptiveFilterReordering(false);
+  suspender.dismiss();
+  benchmark->run("slow_lt(a, b) AND lt(c, b)");
+}
+
+BENCHMARK_RELATIVE(andExpensiveFirst) {
+  folly::BenchmarkSuspender suspender;
+  benchmark->setAdaptiveFilterReordering(true);
+  suspender.dismiss();
+  benchmark->run("slow_lt(a, b) AND lt(c, b)");
+}
+
+BENCHMARK(orExpensiveFirstNoReorder) {
+  folly::BenchmarkSuspender suspender;
+  benchmark->setAdaptiveFilterReordering(false);
+  suspender.dismiss();
+  benchmark->run("slow_lt(a, b) OR lt(c, b)");
+}
+
+BENCHMARK_RELATIVE(orExpensiveFirst) {
+  folly::BenchmarkSuspender suspender;
+  benchmark->setAdaptiveFilterReordering(true);
+  suspender.dismiss();
+  benchmark->run("slow_lt(a, b) OR lt(c, b)");
+}
+
 } // namespace
 
 int main(int argc, char* argv[]) {
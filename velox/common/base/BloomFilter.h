@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
 #include <vector>
 
@@ -133,4 +134,143 @@ class BloomFilter {
   std::vector<uint64_t, Allocator> bits_;
 };
 
+// Split block Bloom filter as described in the Parquet format specification.
+// The filter is an array of 256 bit blocks, each made of 8 32 bit words. The
+// upper 32 bits of the hash number select the block and the lower 32 bits are
+// multiplied with 8 odd salt constants to set one bit in each word of the
+// block. Testing a value touches a single cache line and the per-word
+// operations are independent, so the compiler can vectorize them. With 10
+// bits per expected entry, we get ~1% false positives. Inputs are 64 bit hash
+// numbers.
+template <typename Allocator = std::allocator<uint32_t>>
+class SplitBlockBloomFilter {
+ public:
+  static constexpr int32_t kWordsPerBlock = 8;
+  static constexpr int32_t kBytesPerBlock = kWordsPerBlock * sizeof(uint32_t);
+
+  explicit SplitBlockBloomFilter() : words_{Allocator()} {}
+  explicit SplitBlockBloomFilter(const Allocator& allocator)
+      : words_{allocator} {}
+
+  // Prepares 'this' for use with an expected 'capacity' entries. Drops any
+  // prior content.
+  void reset(int32_t capacity) {
+    words_.clear();
+    // 10 bits per value, rounded up to a power of two number of blocks.
+    const uint64_t numBlocks = bits::nextPowerOfTwo(std::max<uint64_t>(
+        1, bits::roundUp(capacity * 10ULL, kBytesPerBlock * 8) /
+            (kBytesPerBlock * 8)));
+    words_.resize(numBlocks * kWordsPerBlock);
+  }
+
+  bool isSet() const {
+    return words_.size() > 0;
+  }
+
+  // Returns the number of bytes in the filter bitmap.
+  uint64_t numBytes() const {
+    return words_.size() * sizeof(uint32_t);
+  }
+
+  // Adds 'hashCode', a hashed 64 bit value.
+  void insert(uint64_t hashCode) {
+    auto* block = blockFor(words_.data(), hashCode);
+    const auto key = static_cast<uint32_t>(hashCode);
+    for (auto i = 0; i < kWordsPerBlock; ++i) {
+      block[i] |= bitMask(key, i);
+    }
+  }
+
+  // Returns false if 'hashCode' was definitely not added to 'this'.
+  bool mayContain(uint64_t hashCode) const {
+    return test(words_.data(), words_.size() / kWordsPerBlock, hashCode);
+  }
+
+  // Tests 'hashCode' against the filter bitmap 'blocks' of 'numBlocks'
+  // blocks, e.g. one read from a Parquet file.
+  static bool
+  test(const uint32_t* blocks, uint64_t numBlocks, uint64_t hashCode) {
+    const auto* block =
+        blocks + blockIndex(numBlocks, hashCode) * kWordsPerBlock;
+    const auto key = static_cast<uint32_t>(hashCode);
+    bool result = true;
+    for (auto i = 0; i < kWordsPerBlock; ++i) {
+      const auto mask = bitMask(key, i);
+      result &= (block[i] & mask) == mask;
+    }
+    return result;
+  }
+
+  // Keeps only the bits that are set in both 'this' and 'other'. The result
+  // may contain any value that was added to both. 'other' must be of the same
+  // size.
+  void intersect(const SplitBlockBloomFilter& other) {
+    VELOX_CHECK_EQ(words_.size(), other.words_.size());
+    for (auto i = 0; i < words_.size(); ++i) {
+      words_[i] &= other.words_[i];
+    }
+  }
+
+  bool operator==(const SplitBlockBloomFilter& other) const {
+    return words_.size() == other.words_.size() &&
+        std::equal(words_.begin(), words_.end(), other.words_.begin());
+  }
+
+  uint32_t serializedSize() const {
+    return 1 /* version */
+        + 4 /* number of words */
+        + words_.size() * sizeof(uint32_t);
+  }
+
+  void serialize(char* output) const {
+    common::OutputByteStream stream(output);
+    stream.appendOne(kSplitBlockBloomFilterV1);
+    stream.appendOne((int32_t)words_.size());
+    for (auto word : words_) {
+      stream.appendOne(word);
+    }
+  }
+
+  // Replaces the content of 'this' with a filter serialized by serialize().
+  void deserialize(const char* serialized) {
+    common::InputByteStream stream(serialized);
+    auto version = stream.read<int8_t>();
+    VELOX_USER_CHECK_EQ(kSplitBlockBloomFilterV1, version);
+    auto size = stream.read<int32_t>();
+    VELOX_USER_CHECK_EQ(0, size % kWordsPerBlock);
+    words_.resize(size);
+    auto* data =
+        reinterpret_cast<const uint32_t*>(serialized + stream.offset());
+    std::copy(data, data + size, words_.begin());
+  }
+
+ private:
+  static constexpr uint32_t kSalts[kWordsPerBlock] = {
+      0x47b6137bU,
+      0x44974d91U,
+      0x8824ad5bU,
+      0xa2b7289dU,
+      0x705495c7U,
+      0x2df1424bU,
+      0x9efc4947U,
+      0x5c6bfb31U};
+
+  // Maps the upper 32 bits of the hash code to [0, numBlocks).
+  inline static uint64_t blockIndex(uint64_t numBlocks, uint64_t hashCode) {
+    return ((hashCode >> 32) * numBlocks) >> 32;
+  }
+
+  inline static uint32_t bitMask(uint32_t key, int32_t word) {
+    return 1U << ((key * kSalts[word]) >> 27);
+  }
+
+  uint32_t* blockFor(uint32_t* blocks, uint64_t hashCode) {
+    return blocks +
+        blockIndex(words_.size() / kWordsPerBlock, hashCode) * kWordsPerBlock;
+  }
+
+  static constexpr int8_t kSplitBlockBloomFilterV1 = 1;
+  std::vector<uint32_t, Allocator> words_;
+};
+
 } // namespace facebook::velox
@@ -28,6 +28,11 @@ class SelectivityInfo {
     numOut_ += numOut;
   }
 
+  /// Returns the time spent per value dropped. This is the time per value
+  /// divided by the fraction of values dropped, so ordering filters by
+  /// ascending time to drop a value orders them by descending (1 -
+  /// selectivity) / cost. A filter that drops nothing counts as dropping one
+  /// value.
   float timeToDropValue() const {
     if (numIn_ == numOut_) {
       return timeClocks_;
@@ -47,6 +52,14 @@ class SelectivityInfo {
     return numOut_;
   }
 
+  /// Halves the history so that the values recorded from now on weigh as
+  /// much as all the ones before. Lets a filter order follow changing data.
+  void decay() {
+    numIn_ /= 2;
+    numOut_ /= 2;
+    timeClocks_ /= 2;
+  }
+
  private:
   uint64_t numIn_ = 0;
   uint64_t numOut_ = 0;
@@ -90,3 +90,50 @@ TEST_F(BloomFilterTest, merge) {
 
   EXPECT_EQ(bloom.serializedSize(), merge.serializedSize());
 }
+
+TEST_F(BloomFilterTest, splitBlock) {
+  constexpr int32_t kSize = 10'000;
+  SplitBlockBloomFilter bloom;
+  ASSERT_FALSE(bloom.isSet());
+  bloom.reset(kSize);
+  ASSERT_TRUE(bloom.isSet());
+  // 10 bits per entry, rounded up to a power of two number of 32 byte blocks.
+  ASSERT_EQ(16 << 10, bloom.numBytes());
+  for (auto i = 0; i < kSize; ++i) {
+    bloom.insert(folly::hasher<int64_t>()(i));
+  }
+  int32_t numFalsePositives = 0;
+  for (auto i = 0; i < kSize; ++i) {
+    EXPECT_TRUE(bloom.mayContain(folly::hasher<int64_t>()(i)));
+    numFalsePositives += bloom.mayContain(folly::hasher<int64_t>()(i + kSize));
+  }
+  EXPECT_GT(2, 100 * numFalsePositives / kSize);
+
+  std::string data;
+  data.resize(bloom.serializedSize());
+  bloom.serialize(data.data());
+  SplitBlockBloomFilter deserialized;
+  deserialized.deserialize(data.data());
+  EXPECT_TRUE(deserialized == bloom);
+}
+
+TEST_F(BloomFilterTest, splitBlockIntersect) {
+  constexpr int32_t kSize = 1'000;
+  SplitBlockBloomFilter left;
+  SplitBlockBloomFilter right;
+  left.reset(kSize);
+  right.reset(kSize);
+  for (auto i = 0; i < kSize; ++i) {
+    left.insert(folly::hasher<int64_t>()(i));
+    right.insert(folly::hasher<int64_t>()(i + kSize / 2));
+  }
+  left.intersect(right);
+  int32_t numHits = 0;
+  for (auto i = kSize / 2; i < kSize; ++i) {
+    EXPECT_TRUE(left.mayContain(folly::hasher<int64_t>()(i)));
+  }
+  for (auto i = 0; i < kSize / 2; ++i) {
+    numHits += left.mayContain(folly::hasher<int64_t>()(i));
+  }
+  EXPECT_GT(kSize / 2, numHits);
+}
@@ -16,6 +16,7 @@
 
 #include "velox/common/caching/AsyncDataCache.h"
 #include <velox/common/base/BitUtil.h>
+#include "velox/common/caching/CompressedTier.h"
 #include "velox/common/caching/FileIds.h"
 #include "velox/common/caching/SsdCache.h"
 
@@ -59,7 +60,7 @@ void AsyncDataCacheEntry::setExclusiveToShared() {
   if (!ssdFile_ && shard_->cache()->ssdCache()) {
     auto ssdCache = shard_->cache()->ssdCache();
     assert(ssdCache); // for lint only.
-    if (ssdCache->groupStats().shouldSaveToSsd(groupId_, trackingId_)) {
+    if (ssdCache->shouldSave(groupId_, trackingId_, size_)) {
       ssdSaveable_ = true;
       shard_->cache()->possibleSsdSave(size_);
     }
@@ -138,6 +139,19 @@ std::string AsyncDataCacheEntry::toString() const {
       numPins_);
 }
 
+CacheShard::CacheShard(AsyncDataCache* cache)
+    : cache_(cache),
+      tinyLfu_(cache->options().tinyLfu),
+      protectedPct_(cache->options().protectedPct) {
+  const auto& options = cache->options();
+  if (options.compressedBytes) {
+    compressed_ = std::make_unique<CompressedTier>(
+        options.compressedBytes / options.numShards);
+  }
+}
+
+CacheShard::~CacheShard() = default;
+
 std::unique_ptr<AsyncDataCacheEntry> CacheShard::getFreeEntryWithSize(
     uint64_t /*sizeHint*/) {
   std::unique_ptr<AsyncDataCacheEntry> newEntry;
@@ -178,6 +192,11 @@ CachePin CacheShard::findOrCreate(
         } else {
           ++numHit_;
           hitBytes_ += found->size();
+          // A hit before the first reader has seen the entry, e.g. by the
+          // reader after a coalesced load, is not a reuse.
+          if (tinyLfu_ && !found->isFirstUse_) {
+            recordReuseLocked(*found, std::hash<RawFileCacheKey>()(key));
+          }
         }
         ++found->numPins_;
         CachePin pin;
@@ -193,6 +212,10 @@ CachePin CacheShard::findOrCreate(
       // entry still retain a valid read pin.
       found->key_.fileNum.clear();
     }
+    if (tinyLfu_) {
+      sketch_.ensureCapacity(entryMap_.size() + 1);
+      sketch_.increment(std::hash<RawFileCacheKey>()(key));
+    }
     auto newEntry = getFreeEntryWithSize(size);
     // Initialize the members that must be set inside 'mutex_'.
     newEntry->numPins_ = AsyncDataCacheEntry::kExclusive;
@@ -215,6 +238,34 @@ CachePin CacheShard::findOrCreate(
   return initEntry(key, entryToInit);
 }
 
+void CacheShard::recordReuseLocked(AsyncDataCacheEntry& entry, uint64_t hash) {
+  sketch_.increment(hash);
+  if (entry.isProtected_) {
+    ++numProtectedHit_;
+    return;
+  }
+  ++numProbationHit_;
+  entry.isProtected_ = true;
+  ++numProtected_;
+}
+
+void CacheShard::unprotectLocked(AsyncDataCacheEntry& entry) {
+  if (entry.isProtected_) {
+    entry.isProtected_ = false;
+    --numProtected_;
+  }
+}
+
+bool CacheShard::loadCompressed(AsyncDataCacheEntry& entry) {
+  return compressed_ && compressed_->load(entry);
+}
+
+void CacheShard::clearCompressed() {
+  if (compressed_) {
+    compressed_->clear();
+  }
+}
+
 bool CacheShard::exists(RawFileCacheKey key) const {
   std::lock_guard<std::mutex> l(mutex_);
   auto it = entryMap_.find(key);
@@ -307,6 +358,7 @@ std::unique_ptr<folly::SharedPromise<bool>> CacheShard::removeEntry(
 }
 
 void CacheShard::removeEntryLocked(AsyncDataCacheEntry* entry) {
+  unprotectLocked(*entry);
   if (entry->key_.fileNum.hasValue()) {
     auto removeIter = entryMap_.find(
         RawFileCacheKey{entry->key_.fileNum.id(), entry->key_.offset});
@@ -337,64 +389,120 @@ void CacheShard::evict(uint64_t bytesToFree, bool evictAllUnpinned) {
   bool skipSsdSaveable = ssdCache && ssdCache->writeInProgress();
   auto now = accessTime();
   std::vector<memory::Allocation> toFree;
+  // An evicted entry to keep in 'compressed_'. The data is in 'toFree' at
+  // 'dataIndex' or in 'tinyData'.
+  struct Demoted {
+    FileCacheKey key;
+    int32_t size;
+    int32_t dataIndex;
+    std::string tinyData;
+  };
+  std::vector<Demoted> demoted;
   {
     std::lock_guard<std::mutex> l(mutex_);
     int size = entries_.size();
     if (!size) {
       return;
     }
-    int32_t counter = 0;
     int32_t numChecked = 0;
-    auto entryIndex = (clockHand_ % size);
-    auto iter = entries_.begin() + entryIndex;
-    while (++counter <= size) {
-      if (++iter == entries_.end()) {
-        iter = entries_.begin();
-        entryIndex = 0;
-      } else {
-        ++entryIndex;
-      }
-      ++numEvictChecks_;
-      auto candidate = iter->get();
-      if (!candidate) {
-        continue;
-      }
-      ++numChecked;
-      ++clockHand_;
-      if (evictionThreshold_ == kNoThreshold ||
-          eventCounter_ > entries_.size() / 4 ||
-          numChecked > entries_.size() / 8) {
-        now = accessTime();
-        calibrateThreshold();
-        numChecked = 0;
-        eventCounter_ = 0;
-      }
-      int32_t score = 0;
-      if (candidate->numPins_ == 0 &&
-          (!candidate->key_.fileNum.hasValue() || evictAllUnpinned ||
-           (score = candidate->score(now)) >= evictionThreshold_)) {
+    bool done = false;
+    // With TinyLFU, the first pass only evicts from the probation segment.
+    for (auto pass = tinyLfu_ ? 0 : 1; pass < 2 && !done; ++pass) {
+      const bool probationOnly = pass == 0;
+      int32_t counter = 0;
+      auto entryIndex = (clockHand_ % size);
+      auto iter = entries_.begin() + entryIndex;
+      while (++counter <= size) {
+        if (++iter == entries_.end()) {
+          iter = entries_.begin();
+          entryIndex = 0;
+        } else {
+          ++entryIndex;
+        }
+        ++numEvictChecks_;
+        auto candidate = iter->get();
+        if (!candidate) {
+          continue;
+        }
+        ++numChecked;
+        ++clockHand_;
+        if (evictionThreshold_ == kNoThreshold ||
+            eventCounter_ > entries_.size() / 4 ||
+            numChecked > entries_.size() / 8) {
+          now = accessTime();
+          calibrateThreshold();
+          numChecked = 0;
+          eventCounter_ = 0;
+        }
+        if (candidate->numPins_ != 0) {
+          continue;
+        }
+        int32_t score = 0;
+        bool notAdmitted = false;
+        bool evictCandidate =
+            !candidate->key_.fileNum.hasValue() || evictAllUnpinned;
+        if (!evictCandidate && probationOnly) {
+          if (candidate->isProtected_) {
+            // Second chance: an old protected entry goes back to probation
+            // if the protected segment is over its share.
+            if (numProtected_ * 100L >
+                    static_cast<int64_t>(entryMap_.size()) * protectedPct_ &&
+                candidate->score(now) >= evictionThreshold_) {
+              unprotectLocked(*candidate);
+            }
+            continue;
+          }
+          notAdmitted =
+              sketch_.frequency(sketchHash(*candidate)) <= kMinAdmitFrequency;
+          evictCandidate = notAdmitted;
+        }
+        if (!evictCandidate) {
+          score = candidate->score(now);
+          evictCandidate = score >= evictionThreshold_;
+        }
+        if (!evictCandidate) {
+          continue;
+        }
         if (skipSsdSaveable && candidate->ssdSaveable_ && !evictAllUnpinned) {
           ++evictSaveableSkipped;
           continue;
         }
         largeFreed += candidate->data_.byteSize();
+        tinyFreed += candidate->tinyData_.size();
+        if (compressed_ && !evictAllUnpinned && !notAdmitted &&
+            candidate->key_.fileNum.hasValue() &&
+            candidate->accessStats_.lastUse != 0) {
+          demoted.push_back(Demoted{
+              candidate->key_,
+              candidate->size_,
+              static_cast<int32_t>(toFree.size()),
+              std::move(candidate->tinyData_)});
+        }
         toFree.push_back(std::move(candidate->data()));
         removeEntryLocked(candidate);
         freeEntries_.push_back(std::move(*iter));
         emptySlots_.push_back(entryIndex);
-        tinyFreed += candidate->tinyData_.size();
         candidate->tinyData_.clear();
         candidate->size_ = 0;
         ++numEvict_;
+        if (notAdmitted) {
+          ++numAdmissionEvict_;
+        }
         if (score) {
           sumEvictScore_ += score;
         }
         if (largeFreed + tinyFreed > bytesToFree) {
+          done = true;
           break;
         }
       }
     }
   }
+  // Compress before the data is freed.
+  for (auto& entry : demoted) {
+    compressed_->add(
+        entry.key, entry.size, toFree[entry.dataIndex], entry.tinyData);
+  }
   ClockTimer t(allocClocks_);
   freeAllocations(toFree);
   cache_->incrementCachedPages(
@@ -468,7 +576,14 @@ void CacheShard::updateStats(CacheStats& stats) {
   stats.numEvictChecks += numEvictChecks_;
   stats.numWaitExclusive += numWaitExclusive_;
   stats.sumEvictScore += sumEvictScore_;
+  stats.numProtected += numProtected_;
+  stats.numProbationHit += numProbationHit_;
+  stats.numProtectedHit += numProtectedHit_;
+  stats.numAdmissionEvict += numAdmissionEvict_;
   stats.allocClocks += allocClocks_;
+  if (compressed_) {
+    compressed_->updateStats(stats);
+  }
 }
 
 void CacheShard::appendSsdSaveable(std::vector<CachePin>& pins) {
@@ -498,32 +613,55 @@ AsyncDataCache::AsyncDataCache(
     const std::shared_ptr<MemoryAllocator>& allocator,
     uint64_t /* maxBytes */,
     std::unique_ptr<SsdCache> ssdCache)
-    : allocator_(allocator), ssdCache_(std::move(ssdCache)), cachedPages_(0) {
-  for (auto i = 0; i < kNumShards; ++i) {
-    shards_.push_back(std::make_unique<CacheShard>(this));
-  }
-}
+    : AsyncDataCache(allocator, std::move(ssdCache), Options{}) {}
 
 AsyncDataCache::AsyncDataCache(
     const std::shared_ptr<MemoryAllocator>& allocator,
     std::unique_ptr<SsdCache> ssdCache)
-    : allocator_(allocator), ssdCache_(std::move(ssdCache)), cachedPages_(0) {
-  for (auto i = 0; i < kNumShards; ++i) {
+    : AsyncDataCache(allocator, std::move(ssdCache), Options{}) {}
+
+AsyncDataCache::AsyncDataCache(
+    const std::shared_ptr<MemoryAllocator>& allocator,
+    std::unique_ptr<SsdCache> ssdCache,
+    const Options& options)
+    : options_(options),
+      allocator_(allocator),
+      ssdCache_(std::move(ssdCache)),
+      shardMask_(options.numShards - 1),
+      cachedPages_(0) {
+  VELOX_CHECK(
+      options_.protectedPct >= 0 && options_.protectedPct <= 100,
+      "protectedPct must be between 0 and 100: {}",
+      options_.protectedPct);
+  VELOX_CHECK(
+      options_.numShards > 0 && bits::isPowerOfTwo(options_.numShards),
+      "numShards must be a power of 2: {}",
+      options_.numShards);
+  const auto numShards = options_.numShards;
+  shards_.reserve(numShards);
+  for (auto i = 0; i < numShards; ++i) {
     shards_.push_back(std::make_unique<CacheShard>(this));
   }
 }
 
+CacheShard& AsyncDataCache::shard(RawFileCacheKey key) const {
+  return *shards_[std::hash<RawFileCacheKey>()(key) & shardMask_];
+}
+
 CachePin AsyncDataCache::findOrCreate(
     RawFileCacheKey key,
     uint64_t size,
     folly::SemiFuture<bool>* wait) {
-  int shard = std::hash<RawFileCacheKey>()(key) & (kShardMask);
-  return shards_[shard]->findOrCreate(key, size, wait);
+  return shard(key).findOrCreate(key, size, wait);
 }
 
 bool AsyncDataCache::exists(RawFileCacheKey key) const {
-  int shard = std::hash<RawFileCacheKey>()(key) & (kShardMask);
-  return shards_[shard]->exists(key);
+  return shard(key).exists(key);
+}
+
+bool AsyncDataCache::loadCompressed(AsyncDataCacheEntry& entry) {
+  return shard(RawFileCacheKey{entry.key().fileNum.id(), entry.offset()})
+      .loadCompressed(entry);
 }
 
 bool AsyncDataCache::makeSpace(
@@ -541,7 +679,10 @@ bool AsyncDataCache::makeSpace(
   // serialize with a mutex because memory arbitration must not be
   // called from inside a global mutex.
 
-  constexpr int32_t kMaxAttempts = kNumShards * 4;
+  // Go through all shards once before evicting all unpinned entries. The
+  // number of further attempts does not depend on the shard count.
+  const int32_t numShards = shards_.size();
+  const int32_t maxAttempts = numShards + 12;
   // If requesting less than kSmallSizePages try up to 4x more if
   // first try failed.
   constexpr int32_t kSmallSizePages = 2048; // 8MB
@@ -559,7 +700,7 @@ bool AsyncDataCache::makeSpace(
     rank = ++numThreadsInAllocate_;
     isCounted = true;
   }
-  for (auto nthAttempt = 0; nthAttempt < kMaxAttempts; ++nthAttempt) {
+  for (auto nthAttempt = 0; nthAttempt < maxAttempts; ++nthAttempt) {
     try {
       if (allocate()) {
         if (isCounted) {
@@ -578,7 +719,7 @@ bool AsyncDataCache::makeSpace(
                 << "cach write to unpin memory";
       std::this_thread::sleep_for(std::chrono::milliseconds(500)); // NOLINT
     }
-    if (nthAttempt > kMaxAttempts / 2) {
+    if (nthAttempt > maxAttempts / 2) {
       if (!isCounted) {
         rank = ++numThreadsInAllocate_;
         isCounted = true;
@@ -591,9 +732,9 @@ bool AsyncDataCache::makeSpace(
     // Evict from next shard. If we have gone through all shards once
     // and still have not made the allocation, we go to desperate mode
     // with 'evictAllUnpinned' set to true.
-    shards_[shardCounter_ & (kShardMask)]->evict(
+    shards_[static_cast<uint32_t>(shardCounter_) % numShards]->evict(
         numPages * sizeMultiplier * memory::AllocationTraits::kPageSize,
-        nthAttempt >= kNumShards);
+        nthAttempt >= numShards);
     if (numPages < kSmallSizePages && sizeMultiplier < 4) {
       sizeMultiplier *= 2;
     }
@@ -646,6 +787,8 @@ void* AsyncDataCache::allocateBytes(uint64_t bytes, uint16_t alignment) {
 }
 
 void AsyncDataCache::incrementNew(uint64_t size) {
+  // Discount of old accesses at each update of the SSD admission filter.
+  constexpr int32_t kSsdFilterDecayPct = 10;
   newBytes_ += size;
   if (!ssdCache_) {
     return;
@@ -655,7 +798,8 @@ void AsyncDataCache::incrementNew(uint64_t size) {
     nextSsdScoreSize_ = newBytes_ +
         std::max<int64_t>(cachedPages_ * memory::AllocationTraits::kPageSize,
                           1UL << 28);
-    ssdCache_->groupStats().updateSsdFilter(ssdCache_->maxBytes() * 0.9);
+    ssdCache_->groupStats().updateSsdFilter(
+        ssdCache_->maxBytes() * 0.9, kSsdFilterDecayPct);
   }
 }
 
@@ -700,6 +844,7 @@ CacheStats AsyncDataCache::refreshStats() const {
 void AsyncDataCache::clear() {
   for (auto& shard : shards_) {
     shard->evict(std::numeric_limits<int32_t>::max(), true);
+    shard->clearCompressed();
   }
 }
 
@@ -711,12 +856,28 @@ std::string AsyncDataCache::toString() const {
           stats.largePadding
       << " bytes\n"
       << "Miss: " << stats.numNew << " Hit " << stats.numHit << " evict "
-      << stats.numEvict << "\n"
+      << stats.numEvict << " hit rate "
+      << (stats.numHit + stats.numNew
+              ? 100.0 * stats.numHit / (stats.numHit + stats.numNew)
+              : 0.0)
+      << "%\n"
       << " read pins " << stats.numShared << " write pins "
       << stats.numExclusive << " unused prefetch " << stats.numPrefetch
       << " Alloc Megaclocks " << (stats.allocClocks >> 20)
       << " allocated pages " << numAllocated() << " cached pages "
       << cachedPages_;
+  if (options_.tinyLfu) {
+    out << "\nTinyLFU: protected " << stats.numProtected << " probation hit "
+        << stats.numProbationHit << " protected hit " << stats.numProtectedHit
+        << " not admitted " << stats.numAdmissionEvict;
+  }
+  if (options_.compressedBytes) {
+    out << "\nCompressed: " << stats.numCompressed << " entries "
+        << (stats.compressedBytes >> 20) << "MB from "
+        << (stats.compressedRawBytes >> 20) << "MB hit "
+        << stats.numCompressedHit << " evict " << stats.numCompressedEvict
+        << " incompressible " << stats.numIncompressible;
+  }
   out << "\nBacking: " << allocator_->toString();
   if (ssdCache_) {
     out << "\nSSD: " << ssdCache_->toString();
@@ -26,6 +26,7 @@
 #include "velox/common/base/Portability.h"
 #include "velox/common/base/SelectivityInfo.h"
 #include "velox/common/caching/FileGroupStats.h"
+#include "velox/common/caching/FrequencySketch.h"
 #include "velox/common/caching/ScanTracker.h"
 #include "velox/common/caching/StringIdMap.h"
 #include "velox/common/file/File.h"
@@ -35,6 +36,7 @@ namespace facebook::velox::cache {
 
 class AsyncDataCache;
 class CacheShard;
+class CompressedTier;
 class SsdCache;
 class SsdCacheStats;
 class SsdFile;
@@ -312,6 +314,11 @@ class AsyncDataCacheEntry {
   // True if this should be saved to SSD.
   std::atomic<bool> ssdSaveable_{false};
 
+  // True if 'this' has been reused after its first use and is in the
+  // protected segment of its CacheShard. Only used with TinyLFU eviction.
+  // Requires owning shard_->mutex_.
+  bool isProtected_{false};
+
   friend class CacheShard;
   friend class CachePin;
 };
@@ -503,6 +510,32 @@ struct CacheStats {
   // Sum of scores of evicted entries. This serves to infer an average
   // lifetime for entries in cache.
   int64_t sumEvictScore{};
+  // Number of entries in the protected segment. Only set with TinyLFU
+  // eviction.
+  int32_t numProtected{};
+  // Number of hits on entries in the probation segment, i.e. entries that had
+  // not been reused before. Only set with TinyLFU eviction.
+  int64_t numProbationHit{};
+  // Number of hits on entries in the protected segment. Only set with TinyLFU
+  // eviction.
+  int64_t numProtectedHit{};
+  // Number of entries evicted because their key was not accessed often enough
+  // to be admitted. Included in 'numEvict'.
+  int64_t numAdmissionEvict{};
+  // Number of evicted entries kept compressed. Only set with a compressed
+  // tier.
+  int32_t numCompressed{};
+  // Compressed size of the entries in 'numCompressed'.
+  int64_t compressedBytes{};
+  // Uncompressed size of the entries in 'numCompressed'.
+  int64_t compressedRawBytes{};
+  // Number of new entries filled from a compressed copy.
+  int64_t numCompressedHit{};
+  // Number of compressed copies dropped to stay within the compressed tier
+  // size.
+  int64_t numCompressedEvict{};
+  // Number of evicted entries not kept because they did not compress well.
+  int64_t numIncompressible{};
 
   std::shared_ptr<SsdCacheStats> ssdStats = nullptr;
 };
@@ -512,7 +545,9 @@ struct CacheStats {
 // and other housekeeping.
 class CacheShard {
  public:
-  explicit CacheShard(AsyncDataCache* FOLLY_NONNULL cache) : cache_(cache) {}
+  explicit CacheShard(AsyncDataCache* FOLLY_NONNULL cache);
+
+  ~CacheShard();
 
   // See AsyncDataCache::findOrCreate.
   CachePin findOrCreate(
@@ -534,9 +569,22 @@ class CacheShard {
   // not pinned. This favors first removing older and less frequently
   // used entries. If 'evictAllUnpinned' is true, anything that is
   // not pinned is evicted at first sight. This is for out of memory
-  // emergencies.
+  // emergencies. With TinyLFU eviction, a first sweep only considers
+  // the probation segment and evicts entries whose key has been accessed
+  // at most kMinAdmitFrequency times, so that a one-off scan replaces
+  // itself instead of the reused entries in the protected segment. With a
+  // compressed tier, the evicted entries are compressed into it after the
+  // shard mutex is released, except in emergencies and for entries that
+  // are not admitted or made evictable by their reader.
   void evict(uint64_t bytesToFree, bool evictAllUnpinned);
 
+  // Fills the exclusive 'entry' from the compressed tier of 'this'. Returns
+  // false if there is no compressed tier or no compressed copy of 'entry'.
+  bool loadCompressed(AsyncDataCacheEntry& entry);
+
+  // Drops the compressed copies of evicted entries.
+  void clearCompressed();
+
   // Removes 'entry' from 'this'. Removes a possible promise from the entry
   // inside the shard mutex and returns it so that it can be realized outside of
   // the mutex.
@@ -560,6 +608,23 @@ class CacheShard {
  private:
   static constexpr int32_t kNoThreshold = std::numeric_limits<int32_t>::max();
 
+  // Entries in the probation segment whose key has been accessed at most
+  // this many times are not admitted to the cache, i.e. are evicted before
+  // any other entry.
+  static constexpr int32_t kMinAdmitFrequency = 1;
+
+  // Returns the hash of the key of 'entry' for 'sketch_'.
+  static uint64_t sketchHash(const AsyncDataCacheEntry& entry) {
+    return std::hash<RawFileCacheKey>()(
+        RawFileCacheKey{entry.key_.fileNum.id(), entry.key_.offset});
+  }
+
+  // Records a reuse of 'entry' and moves it to the protected segment.
+  void recordReuseLocked(AsyncDataCacheEntry& entry, uint64_t hash);
+
+  // Moves 'entry' back to the probation segment.
+  void unprotectLocked(AsyncDataCacheEntry& entry);
+
   void calibrateThreshold();
 
   void removeEntryLocked(AsyncDataCacheEntry* entry);
@@ -582,6 +647,25 @@ class CacheShard {
   // few around to avoid allocating one inside 'mutex_'.
   std::vector<std::unique_ptr<AsyncDataCacheEntry>> freeEntries_;
   AsyncDataCache* const cache_;
+  // True if eviction is segmented and filtered by access frequency. See
+  // AsyncDataCache::Options.
+  const bool tinyLfu_;
+  // Max percentage of 'entries_' in the protected segment.
+  const int32_t protectedPct_;
+  // Approximate access counts of the keys looked up in 'this'. Only used
+  // if 'tinyLfu_' is set.
+  FrequencySketch sketch_;
+  // Number of entries with 'isProtected_' set.
+  int32_t numProtected_{};
+  // Cumulative count of hits on entries in the probation segment.
+  uint64_t numProbationHit_{};
+  // Cumulative count of hits on entries in the protected segment.
+  uint64_t numProtectedHit_{};
+  // Count of entries evicted for not passing the admission filter.
+  uint64_t numAdmissionEvict_{};
+  // Compressed copies of evicted entries. nullptr if the cache has no
+  // compressed tier.
+  std::unique_ptr<CompressedTier> compressed_;
   // Index in 'entries_' for the next eviction candidate.
   uint32_t clockHand_{};
   // Number of gets  since last stats sampling.
@@ -611,6 +695,28 @@ class CacheShard {
 
 class AsyncDataCache : public memory::MemoryAllocator {
  public:
+  struct Options {
+    // If true, each shard tracks the access frequency of keys in a count-min
+    // sketch and splits its entries into a probation and a protected
+    // segment. Entries move to the protected segment when reused.
+    // Eviction first removes probation entries whose key has not been
+    // accessed repeatedly, so that a large scan of cold data does not
+    // flush reused data (TinyLFU admission). Default is the plain
+    // clock-like score sweep.
+    bool tinyLfu{false};
+    // Max percentage of entries in the protected segment. Above this, the
+    // protected entries seen in eviction sweeps are moved back to probation.
+    int32_t protectedPct{80};
+    // Number of shards. Must be a power of 2. Each shard serializes its
+    // lookups on a mutex, so many concurrent drivers need more shards.
+    int32_t numShards{4};
+    // If non-0, entries evicted to make space are kept LZ4 compressed in up
+    // to this many bytes in total. A miss is then filled from the compressed
+    // copy before trying SSD or storage. The compressed copies are allocated
+    // outside of the MemoryAllocator of the cache.
+    uint64_t compressedBytes{0};
+  };
+
   // TODO(jtan6): Remove this constructor after Presto Native switches to below
   // constructor
   AsyncDataCache(
@@ -622,6 +728,15 @@ class AsyncDataCache : public memory::MemoryAllocator {
       const std::shared_ptr<memory::MemoryAllocator>& allocator,
       std::unique_ptr<SsdCache> ssdCache = nullptr);
 
+  AsyncDataCache(
+      const std::shared_ptr<memory::MemoryAllocator>& allocator,
+      std::unique_ptr<SsdCache> ssdCache,
+      const Options& options);
+
+  const Options& options() const {
+    return options_;
+  }
+
   // Finds or creates a cache entry corresponding to 'key'. The entry
   // is returned in 'pin'. If the entry is new, it is pinned in
   // exclusive mode and its 'data_' has uninitialized space for at
@@ -641,6 +756,12 @@ class AsyncDataCache : public memory::MemoryAllocator {
   // Returns true if there is an entry for 'key'. Updates access time.
   bool exists(RawFileCacheKey key) const;
 
+  // Fills the exclusive 'entry' returned by findOrCreate() by decompressing
+  // a copy kept when the entry was last evicted. Returns false if there is
+  // no such copy. The caller then reads the data from SSD or storage. On
+  // success, the caller sets 'entry' to shared mode.
+  bool loadCompressed(AsyncDataCacheEntry& entry);
+
   Kind kind() const override {
     return allocator_->kind();
   }
@@ -691,6 +812,10 @@ class AsyncDataCache : public memory::MemoryAllocator {
     return allocator_->numMapped();
   }
 
+  uint64_t flushCache() override {
+    return allocator_->flushCache();
+  }
+
   CacheStats refreshStats() const;
 
   std::string toString() const override;
@@ -749,7 +874,7 @@ class AsyncDataCache : public memory::MemoryAllocator {
     }
   }
 
-  // Drops all unpinned entries. Pins stay valid.
+  // Drops all unpinned entries and compressed copies. Pins stay valid.
   void clear();
 
   // Saves all entries with 'ssdSaveable_' to 'ssdCache_'.
@@ -764,8 +889,8 @@ class AsyncDataCache : public memory::MemoryAllocator {
   }
 
  private:
-  static constexpr int32_t kNumShards = 4; // Must be power of 2.
-  static constexpr int32_t kShardMask = kNumShards - 1;
+  // Returns the shard for 'key'.
+  CacheShard& shard(RawFileCacheKey key) const;
 
   // Waits a pseudorandom delay times 'counter'.
   void backoff(int32_t counter);
@@ -781,9 +906,12 @@ class AsyncDataCache : public memory::MemoryAllocator {
       memory::MachinePageCount numPages,
       std::function<bool()> allocate);
 
+  const Options options_;
   std::shared_ptr<memory::MemoryAllocator> allocator_;
   std::unique_ptr<SsdCache> ssdCache_;
   std::vector<std::unique_ptr<CacheShard>> shards_;
+  // options_.numShards - 1.
+  const int32_t shardMask_;
   std::atomic<int32_t> shardCounter_{0};
   std::atomic<memory::MachinePageCount> cachedPages_{0};
   // Number of pages that are allocated and not yet loaded or loaded
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/CompressedTier.h"
+
+#include <folly/io/Cursor.h>
+
+namespace facebook::velox::cache {
+
+CompressedTier::CompressedTier(
+    uint64_t maxBytes,
+    folly::io::CodecType codecType)
+    : maxBytes_(maxBytes), codec_(folly::io::getCodec(codecType)) {}
+
+bool CompressedTier::add(
+    const FileCacheKey& key,
+    int32_t size,
+    const memory::Allocation& data,
+    const std::string& tinyData) {
+  // Compress outside of 'mutex_'.
+  std::unique_ptr<folly::IOBuf> input;
+  if (!tinyData.empty()) {
+    input = folly::IOBuf::wrapBuffer(tinyData.data(), size);
+  } else {
+    int64_t bytesLeft = size;
+    for (auto i = 0; i < data.numRuns() && bytesLeft > 0; ++i) {
+      auto run = data.runAt(i);
+      const auto bytes = std::min<int64_t>(bytesLeft, run.numBytes());
+      auto buffer = folly::IOBuf::wrapBuffer(run.data<char>(), bytes);
+      if (input) {
+        input->prependChain(std::move(buffer));
+      } else {
+        input = std::move(buffer);
+      }
+      bytesLeft -= bytes;
+    }
+  }
+  auto compressed = codec_->compress(input.get());
+  const auto compressedSize = compressed->computeChainDataLength();
+
+  std::lock_guard<std::mutex> l(mutex_);
+  if (compressedSize * 100 > static_cast<uint64_t>(size) * kMaxCompressedPct ||
+      compressedSize > maxBytes_) {
+    ++numIncompressible_;
+    return false;
+  }
+  const RawFileCacheKey rawKey{key.fileNum.id(), key.offset};
+  auto it = copies_.find(rawKey);
+  if (it != copies_.end()) {
+    removeLocked(it);
+  }
+  lru_.push_back(rawKey);
+  copies_[rawKey] = Compressed{
+      key.fileNum,
+      size,
+      compressedSize,
+      std::move(compressed),
+      std::prev(lru_.end())};
+  bytes_ += compressedSize;
+  rawBytes_ += size;
+  while (bytes_ > maxBytes_) {
+    removeLocked(copies_.find(lru_.front()));
+    ++numEvict_;
+  }
+  return true;
+}
+
+bool CompressedTier::load(AsyncDataCacheEntry& entry) {
+  VELOX_CHECK(entry.isExclusive());
+  std::unique_ptr<folly::IOBuf> compressed;
+  int32_t size;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    auto it = copies_.find(
+        RawFileCacheKey{entry.key().fileNum.id(), entry.key().offset});
+    if (it == copies_.end() || it->second.size < entry.size()) {
+      return false;
+    }
+    // The entry goes back to the shard. Drop the copy.
+    compressed = std::move(it->second.data);
+    size = it->second.size;
+    removeLocked(it);
+    ++numHit_;
+  }
+  auto uncompressed = codec_->uncompress(compressed.get(), size);
+  folly::io::Cursor cursor(uncompressed.get());
+  if (entry.tinyData()) {
+    cursor.pull(entry.tinyData(), entry.size());
+    return true;
+  }
+  auto& data = entry.data();
+  int64_t bytesLeft = entry.size();
+  for (auto i = 0; i < data.numRuns() && bytesLeft > 0; ++i) {
+    auto run = data.runAt(i);
+    const auto bytes = std::min<int64_t>(bytesLeft, run.numBytes());
+    cursor.pull(run.data<char>(), bytes);
+    bytesLeft -= bytes;
+  }
+  return true;
+}
+
+void CompressedTier::removeLocked(
+    folly::F14FastMap<RawFileCacheKey, Compressed>::iterator it) {
+  auto& copy = it->second;
+  bytes_ -= copy.compressedSize;
+  rawBytes_ -= copy.size;
+  lru_.erase(copy.lruPosition);
+  copies_.erase(it);
+}
+
+void CompressedTier::clear() {
+  std::lock_guard<std::mutex> l(mutex_);
+  copies_.clear();
+  lru_.clear();
+  bytes_ = 0;
+  rawBytes_ = 0;
+}
+
+void CompressedTier::updateStats(CacheStats& stats) const {
+  std::lock_guard<std::mutex> l(mutex_);
+  stats.numCompressed += copies_.size();
+  stats.compressedBytes += bytes_;
+  stats.compressedRawBytes += rawBytes_;
+  stats.numCompressedHit += numHit_;
+  stats.numCompressedEvict += numEvict_;
+  stats.numIncompressible += numIncompressible_;
+}
+
+} // namespace facebook::velox::cache
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/compression/Compression.h>
+#include <folly/container/F14Map.h>
+
+#include <list>
+#include <mutex>
+
+#include "velox/common/caching/AsyncDataCache.h"
+
+namespace facebook::velox::cache {
+
+// Compressed copies of entries evicted from a CacheShard. An entry evicted
+// to make space is compressed and kept here until it is looked up again or
+// until it is the least recently added when the compressed copies exceed
+// 'maxBytes'. A lookup that misses the shard can then fill the new entry by
+// decompressing instead of reading SSD or storage. The compressed copies are
+// allocated outside of the cache's MemoryAllocator. Thread safe.
+class CompressedTier {
+ public:
+  CompressedTier(
+      uint64_t maxBytes,
+      folly::io::CodecType codecType = folly::io::CodecType::LZ4);
+
+  // Compresses the first 'size' bytes of 'data' or of 'tinyData' if this is
+  // not empty and keeps the result for 'key'. Returns false if the data does
+  // not compress well enough to be worth keeping.
+  bool add(
+      const FileCacheKey& key,
+      int32_t size,
+      const memory::Allocation& data,
+      const std::string& tinyData);
+
+  // Fills the exclusive 'entry' with the data of a compressed copy of at
+  // least the size of 'entry' and drops the copy. Returns false if there is
+  // no such copy.
+  bool load(AsyncDataCacheEntry& entry);
+
+  // Drops all compressed copies.
+  void clear();
+
+  // Adds the counters of 'this' to 'stats'.
+  void updateStats(CacheStats& stats) const;
+
+ private:
+  // A compressed copy is kept only if it is at most this percentage of the
+  // uncompressed size and fits in 'maxBytes_'.
+  static constexpr int32_t kMaxCompressedPct = 80;
+
+  struct Compressed {
+    // Keeps the file id of the key valid.
+    StringIdLease file;
+    // Uncompressed size.
+    int32_t size;
+    uint64_t compressedSize;
+    std::unique_ptr<folly::IOBuf> data;
+    // Position in 'lru_'.
+    std::list<RawFileCacheKey>::iterator lruPosition;
+  };
+
+  // Removes 'it' from 'copies_' and 'lru_'. Caller must hold 'mutex_'.
+  void removeLocked(
+      folly::F14FastMap<RawFileCacheKey, Compressed>::iterator it);
+
+  const uint64_t maxBytes_;
+  const std::unique_ptr<folly::io::Codec> codec_;
+
+  mutable std::mutex mutex_;
+  folly::F14FastMap<RawFileCacheKey, Compressed> copies_;
+  // Keys of 'copies_', most recently added last.
+  std::list<RawFileCacheKey> lru_;
+  // Sum of compressed sizes in 'copies_'.
+  uint64_t bytes_{0};
+  // Sum of uncompressed sizes in 'copies_'.
+  uint64_t rawBytes_{0};
+  // Cumulative count of entries filled from a compressed copy.
+  uint64_t numHit_{0};
+  // Cumulative count of copies dropped to stay within 'maxBytes_'.
+  uint64_t numEvict_{0};
+  // Cumulative count of evicted entries not kept for compressing poorly.
+  uint64_t numIncompressible_{0};
+};
+
+} // namespace facebook::velox::cache
@@ -0,0 +1,227 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/FileGroupStats.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <tuple>
+
+namespace facebook::velox::cache {
+
+namespace {
+// Columns whose read bytes decay below this are dropped.
+constexpr double kMinTrackedBytes = 1;
+} // namespace
+
+std::optional<int32_t> FileGroupStats::fileOpens(
+    uint64_t groupId,
+    uint64_t fileId) {
+  auto& shard = shards_[shardIndex(groupId)];
+  std::lock_guard<std::mutex> l(shard.mutex);
+  auto group = shard.groups.find(groupId);
+  if (group == shard.groups.end()) {
+    return std::nullopt;
+  }
+  auto file = group->second.files.find(fileId);
+  return file == group->second.files.end() ? 0 : file->second.numOpens;
+}
+
+void FileGroupStats::recordReference(
+    uint64_t fileId,
+    uint64_t groupId,
+    TrackingId trackingId,
+    int32_t bytes) {
+  if (minReuse_ == 0) {
+    return;
+  }
+  const auto open = fileOpens(groupId, fileId);
+  if (!open.has_value()) {
+    return;
+  }
+  const GroupColumn key(groupId, trackingId.id());
+  auto& shard = shards_[shardIndex(key)];
+  std::lock_guard<std::mutex> l(shard.mutex);
+  auto& column = shard.columns[key];
+  auto [last, inserted] = column.lastOpen.try_emplace(fileId);
+  if (inserted || last->second.open != open.value()) {
+    last->second.open = open.value();
+    ++column.numOpens;
+  }
+  last->second.lastUpdate = updates_;
+  column.referencedBytes += bytes;
+}
+
+void FileGroupStats::recordRead(
+    uint64_t /*fileId*/,
+    uint64_t groupId,
+    TrackingId trackingId,
+    int32_t bytes) {
+  if (minReuse_ == 0) {
+    return;
+  }
+  // A read follows a reference, which creates the column if its group is
+  // tracked.
+  const GroupColumn key(groupId, trackingId.id());
+  auto& shard = shards_[shardIndex(key)];
+  std::lock_guard<std::mutex> l(shard.mutex);
+  auto it = shard.columns.find(key);
+  if (it != shard.columns.end()) {
+    it->second.readBytes += bytes;
+  }
+}
+
+void FileGroupStats::recordFile(
+    uint64_t fileId,
+    uint64_t groupId,
+    int32_t /*numStripes*/) {
+  if (minReuse_ == 0) {
+    return;
+  }
+  auto& shard = shards_[shardIndex(groupId)];
+  std::lock_guard<std::mutex> l(shard.mutex);
+  auto& file = shard.groups[groupId].files[fileId];
+  ++file.numOpens;
+  file.lastUpdate = updates_;
+}
+
+bool FileGroupStats::shouldSaveToSsd(uint64_t groupId, TrackingId trackingId)
+    const {
+  if (minReuse_ == 0) {
+    return true;
+  }
+  const GroupColumn key(groupId, trackingId.id());
+  auto& shard = shards_[shardIndex(key)];
+  std::lock_guard<std::mutex> l(shard.mutex);
+  if (shard.columns.find(key) == shard.columns.end()) {
+    return true;
+  }
+  return shard.saveable.count(key) != 0;
+}
+
+float FileGroupStats::reuse(uint64_t groupId, TrackingId trackingId) const {
+  const GroupColumn key(groupId, trackingId.id());
+  auto& shard = shards_[shardIndex(key)];
+  std::lock_guard<std::mutex> l(shard.mutex);
+  auto it = shard.columns.find(key);
+  return it == shard.columns.end() ? 0 : it->second.reuse();
+}
+
+void FileGroupStats::decayLocked(
+    Shard& shard,
+    double decay,
+    std::vector<std::tuple<double, double, GroupColumn>>& candidates) {
+  const uint32_t updates = updates_;
+  auto isIdle = [&](uint32_t lastUpdate) {
+    return updates - lastUpdate > kMaxIdleUpdates;
+  };
+  for (auto it = shard.groups.begin(); it != shard.groups.end();) {
+    auto& files = it->second.files;
+    for (auto file = files.begin(); file != files.end();) {
+      file = isIdle(file->second.lastUpdate) ? files.erase(file) : ++file;
+    }
+    it = files.empty() ? shard.groups.erase(it) : ++it;
+  }
+  for (auto it = shard.columns.begin(); it != shard.columns.end();) {
+    auto& column = it->second;
+    for (auto file = column.lastOpen.begin();
+         file != column.lastOpen.end();) {
+      file = isIdle(file->second.lastUpdate) ? column.lastOpen.erase(file)
+                                             : ++file;
+    }
+    column.referencedBytes *= decay;
+    column.readBytes *= decay;
+    column.numOpens *= decay;
+    if (column.readBytes < kMinTrackedBytes || column.lastOpen.empty()) {
+      it = shard.columns.erase(it);
+      continue;
+    }
+    const auto reuse = column.reuse();
+    if (reuse >= minReuse_) {
+      candidates.emplace_back(reuse, column.footprint(), it->first);
+    }
+    ++it;
+  }
+}
+
+void FileGroupStats::updateSsdFilter(uint64_t ssdSize, int32_t decayPct) {
+  if (minReuse_ == 0) {
+    return;
+  }
+  std::lock_guard<std::mutex> updateLock(updateMutex_);
+  ++updates_;
+  const double decay = (100 - decayPct) / 100.0;
+  // Reuse, footprint and key of the columns with at least 'minReuse_' reuse.
+  std::vector<std::tuple<double, double, GroupColumn>> candidates;
+  for (auto& shard : shards_) {
+    std::lock_guard<std::mutex> l(shard.mutex);
+    decayLocked(shard, decay, candidates);
+  }
+  // The most reused first.
+  std::sort(
+      candidates.begin(), candidates.end(), [](const auto& x, const auto& y) {
+        return std::get<0>(x) > std::get<0>(y);
+      });
+  std::array<folly::F14FastSet<GroupColumn>, kNumShards> saveable;
+  numSaveable_ = 0;
+  saveableBytes_ = 0;
+  for (auto& [reuse, footprint, key] : candidates) {
+    if (saveableBytes_ + footprint > ssdSize) {
+      break;
+    }
+    saveable[shardIndex(key)].insert(key);
+    ++numSaveable_;
+    saveableBytes_ += footprint;
+  }
+  for (auto i = 0; i < kNumShards; ++i) {
+    std::lock_guard<std::mutex> l(shards_[i].mutex);
+    shards_[i].saveable = std::move(saveable[i]);
+  }
+}
+
+std::string FileGroupStats::toString(uint64_t cacheBytes) {
+  if (minReuse_ == 0) {
+    return "<FileGroupStats: no admission>";
+  }
+  std::lock_guard<std::mutex> updateLock(updateMutex_);
+  double totalBytes = 0;
+  int32_t numGroups = 0;
+  int32_t numColumns = 0;
+  for (auto& shard : shards_) {
+    std::lock_guard<std::mutex> l(shard.mutex);
+    numGroups += shard.groups.size();
+    numColumns += shard.columns.size();
+    for (auto& [key, column] : shard.columns) {
+      totalBytes += column.footprint();
+    }
+  }
+  const auto cacheablePct = totalBytes == 0
+      ? 100
+      : std::min<int32_t>(100, 100 * cacheBytes / totalBytes);
+  return fmt::format(
+      "<FileGroupStats: {} groups {} columns, {} columns {}MB qualify for "
+      "SSD, tracked working set {}MB {}% cacheable, min reuse {}>",
+      numGroups,
+      numColumns,
+      numSaveable_,
+      static_cast<int64_t>(saveableBytes_) >> 20,
+      static_cast<int64_t>(totalBytes) >> 20,
+      cacheablePct,
+      minReuse_);
+}
+
+} // namespace facebook::velox::cache
@@ -16,48 +16,166 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <optional>
+
+#include <folly/container/F14Map.h>
+#include <folly/container/F14Set.h>
+#include <folly/hash/Hash.h>
+
 #include "velox/common/caching/ScanTracker.h"
 
 namespace facebook::velox::cache {
 
-// Dummy implementation of SsdCache admission stats.
+// Predicts reuse of data for SsdCache admission. Tracks references and
+// reads of each column (TrackingId) of each file group (e.g. partition)
+// and estimates how many times the data of a column in a group has been
+// read. The columns with the highest reuse that fit in the SSD cache
+// qualify for saving to SSD. Data of groups and columns that are not
+// tracked, e.g. not read through a ScanTracker, always qualifies.
 class FileGroupStats {
  public:
+  // 'minReuse' is the least number of reads of the data of a group and
+  // column for the data to qualify for SSD. 0 means that everything
+  // qualifies and nothing is tracked.
+  explicit FileGroupStats(float minReuse = 0) : minReuse_(minReuse) {}
+
   // Records ScanTracker::recordReference at group level
   void recordReference(
-      uint64_t /*fileId*/,
-      uint64_t /*groupId*/,
-      TrackingId /*trackingId*/,
-      int32_t /*bytes*/) {}
+      uint64_t fileId,
+      uint64_t groupId,
+      TrackingId trackingId,
+      int32_t bytes);
 
   // Records ScanTracker::recordRead at group level
   void recordRead(
-      uint64_t /*fileId*/,
-      uint64_t /*groupId*/,
-      TrackingId /*trackingId*/,
-      int32_t /*bytes*/) {}
+      uint64_t fileId,
+      uint64_t groupId,
+      TrackingId trackingId,
+      int32_t bytes);
 
-  // Records the existence of a distinct file inside 'groupId'
-  void recordFile(
-      uint64_t /*fileId*/,
-      uint64_t /*groupId*/,
-      int32_t /*numStripes*/) {}
+  // Records the existence of a distinct file inside 'groupId'. Called each
+  // time a reader opens the file.
+  void recordFile(uint64_t fileId, uint64_t groupId, int32_t numStripes);
 
   // Returns true if groupId, trackingId qualify the data to be cached to SSD.
-  bool shouldSaveToSsd(uint64_t /*groupId*/, TrackingId /*trackingId*/) const {
-    return true;
-  }
+  bool shouldSaveToSsd(uint64_t groupId, TrackingId trackingId) const;
 
   // Updates the SSD selection criteria. 'ssdsize' is the capacity,
-  // 'decayPct' gives by how much old accesses are discounted.
-  void updateSsdFilter(uint64_t /*ssdSize*/, int32_t /*decayPct*/ = 0) {}
+  // 'decayPct' gives by how much old accesses are discounted. Files and
+  // columns that have not been used for a few updates are forgotten.
+  void updateSsdFilter(uint64_t ssdSize, int32_t decayPct = 0);
+
+  // Returns the estimated number of reads of the data of 'groupId' and
+  // 'trackingId'. 0 if not tracked.
+  float reuse(uint64_t groupId, TrackingId trackingId) const;
 
   // Recalculates the best groups and makes a human readable
   // summary. 'cacheBytes' is used to compute what fraction of the tracked
   // working set can be cached in 'cacheBytes'.
-  std::string toString(uint64_t /*cacheBytes*/) {
-    return "<dummy FileGroupStats>";
+  std::string toString(uint64_t cacheBytes);
+
+ private:
+  using GroupColumn = std::pair<uint64_t, int32_t>;
+
+  // Number of shards for the tracked groups and columns.
+  static constexpr int32_t kNumShards = 16;
+
+  // Files and columns not referenced in this many updateSsdFilter() calls
+  // are dropped.
+  static constexpr uint32_t kMaxIdleUpdates = 8;
+
+  // Opens of a file of a group.
+  struct FileData {
+    // Incremented at each open of the file.
+    int32_t numOpens{0};
+    // 'updates_' at the last open.
+    uint32_t lastUpdate{0};
+  };
+
+  struct GroupData {
+    folly::F14FastMap<uint64_t, FileData> files;
+  };
+
+  // Last reference to a column from a file.
+  struct FileReference {
+    // FileData::numOpens at the reference. A reference under a new value is
+    // a new pass over the file.
+    int32_t open{0};
+    // 'updates_' at the reference.
+    uint32_t lastUpdate{0};
+  };
+
+  // Access counts for a column of a group.
+  struct ColumnData {
+    double referencedBytes{0};
+    double readBytes{0};
+    // Number of file opens in which the column was referenced.
+    double numOpens{0};
+    // The last reference from each file that referenced the column in the
+    // last kMaxIdleUpdates updates.
+    folly::F14FastMap<uint64_t, FileReference> lastOpen;
+
+    // Average bytes referenced per open times the number of distinct files,
+    // i.e. the size of the column in the group.
+    double footprint() const {
+      return numOpens == 0
+          ? 0
+          : referencedBytes / numOpens * static_cast<double>(lastOpen.size());
+    }
+
+    double reuse() const {
+      const auto size = footprint();
+      return size == 0 ? 0 : readBytes / size;
+    }
+  };
+
+  // The groups and columns that hash to one mutex. The columns of a group are
+  // spread over all shards, so that concurrent scans of the same group do not
+  // serialize on one mutex.
+  struct Shard {
+    mutable std::mutex mutex;
+    folly::F14FastMap<uint64_t, GroupData> groups;
+    folly::F14FastMap<GroupColumn, ColumnData> columns;
+    // The columns of this shard that qualify for SSD as of the last
+    // updateSsdFilter().
+    folly::F14FastSet<GroupColumn> saveable;
+  };
+
+  static int32_t shardIndex(uint64_t groupId) {
+    return folly::hasher<uint64_t>()(groupId) % kNumShards;
+  }
+
+  static int32_t shardIndex(const GroupColumn& key) {
+    return folly::hasher<GroupColumn>()(key) % kNumShards;
   }
+
+  // Returns the number of opens of 'fileId' in 'groupId' or std::nullopt if
+  // the group has no recorded files.
+  std::optional<int32_t> fileOpens(uint64_t groupId, uint64_t fileId);
+
+  // Decays the counts of the columns in 'shard' and drops the files and
+  // columns idle for kMaxIdleUpdates. Adds the columns with at least
+  // 'minReuse_' reuse to 'candidates' as tuples of reuse, footprint and key.
+  void decayLocked(
+      Shard& shard,
+      double decay,
+      std::vector<std::tuple<double, double, GroupColumn>>& candidates);
+
+  const float minReuse_;
+
+  // Number of updateSsdFilter() calls.
+  std::atomic<uint32_t> updates_{0};
+
+  std::array<Shard, kNumShards> shards_;
+
+  // Serializes updateSsdFilter() and toString().
+  std::mutex updateMutex_;
+  // Count and sum of footprint() of the saveable columns of all shards.
+  int32_t numSaveable_{0};
+  double saveableBytes_{0};
 };
 
 } // namespace facebook::velox::cache
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "velox/common/base/BitUtil.h"
+
+namespace facebook::velox::cache {
+
+// Count-min sketch of access frequencies with 4 bit counters, as used for
+// TinyLFU cache admission. Estimates how often a hash was recorded within
+// roughly the last 10 x capacity accesses. All counters are halved after
+// that many increments so that the estimate follows changes in the
+// workload. Not thread safe.
+class FrequencySketch {
+ public:
+  // Maximum value of a counter.
+  static constexpr int32_t kMaxFrequency = 15;
+
+  explicit FrequencySketch(int32_t capacity = 1024) {
+    resize(capacity);
+  }
+
+  // Grows the sketch to track about 'capacity' distinct hashes. Clears the
+  // counters if the size changes. Grows at least 2x so that a filling cache
+  // does not clear the counters on every new entry.
+  void ensureCapacity(int32_t capacity) {
+    if (capacity > capacity_) {
+      resize(std::max(capacity, 2 * capacity_));
+    }
+  }
+
+  // Records one access to 'hash'.
+  void increment(uint64_t hash) {
+    bool added = false;
+    for (auto row = 0; row < kDepth; ++row) {
+      const auto index = counterIndex(hash, row);
+      auto& word = table_[index / kCountersPerWord];
+      const auto shift = (index % kCountersPerWord) * 4;
+      if (((word >> shift) & kMaxFrequency) < kMaxFrequency) {
+        word += 1ULL << shift;
+        added = true;
+      }
+    }
+    if (added && ++numIncrements_ >= sampleSize_) {
+      halve();
+    }
+  }
+
+  // Returns the estimated number of recent accesses to 'hash'.
+  int32_t frequency(uint64_t hash) const {
+    int32_t frequency = kMaxFrequency;
+    for (auto row = 0; row < kDepth; ++row) {
+      const auto index = counterIndex(hash, row);
+      const auto word = table_[index / kCountersPerWord];
+      frequency = std::min<int32_t>(
+          frequency,
+          (word >> ((index % kCountersPerWord) * 4)) & kMaxFrequency);
+    }
+    return frequency;
+  }
+
+ private:
+  static constexpr int32_t kDepth = 4;
+  static constexpr int32_t kCountersPerWord = 16;
+
+  void resize(int32_t capacity) {
+    capacity_ = capacity;
+    // One counter per tracked hash and row, rounded to a power of 2.
+    const auto numWords =
+        bits::nextPowerOfTwo(std::max<uint64_t>(1, capacity / 4));
+    table_.assign(numWords, 0);
+    counterMask_ = numWords * kCountersPerWord - 1;
+    sampleSize_ = 10 * std::max<int32_t>(capacity, 16);
+    numIncrements_ = 0;
+  }
+
+  uint32_t counterIndex(uint64_t hash, int32_t row) const {
+    static constexpr std::array<uint64_t, kDepth> kSeeds = {
+        0xc3a5c85c97cb3127ULL,
+        0xb492b66fbe98f273ULL,
+        0x9ae16a3b2f90404fULL,
+        0xcbf29ce484222325ULL};
+    auto h = (hash + kSeeds[row]) * kSeeds[row];
+    h ^= h >> 32;
+    return h & counterMask_;
+  }
+
+  // Halves all counters. 0x77... clears the bit shifted in from the next
+  // counter.
+  void halve() {
+    for (auto& word : table_) {
+      word = (word >> 1) & 0x7777777777777777ULL;
+    }
+    numIncrements_ /= 2;
+  }
+
+  int32_t capacity_{0};
+  std::vector<uint64_t> table_;
+  uint64_t counterMask_{0};
+  int32_t sampleSize_{0};
+  int32_t numIncrements_{0};
+};
+
+} // namespace facebook::velox::cache
@@ -16,6 +16,7 @@
 #include "velox/common/caching/SsdCache.h"
 #include <folly/Executor.h>
 #include <folly/portability/SysUio.h>
+#include "velox/common/base/AsyncSource.h"
 #include "velox/common/caching/FileIds.h"
 #include "velox/common/file/FileSystems.h"
 #include "velox/common/time/Timer.h"
@@ -23,6 +24,12 @@
 #include <filesystem>
 #include <numeric>
 
+DEFINE_double(
+    ssd_min_reuse,
+    0,
+    "Least number of reads of the data of a file group and column for the "
+    "data to be written to SSD cache. 0 writes all data");
+
 namespace facebook::velox::cache {
 
 SsdCache::SsdCache(
@@ -31,11 +38,17 @@ SsdCache::SsdCache(
     int32_t numShards,
     folly::Executor* executor,
     int64_t checkpointIntervalBytes,
-    bool disableFileCow)
+    bool disableFileCow,
+    float minReuse,
+    uint64_t maxWriteBytesPerSec,
+    bool checksumEnabled)
     : filePrefix_(filePrefix),
       numShards_(numShards),
-      groupStats_(std::make_unique<FileGroupStats>()),
-      executor_(executor) {
+      groupStats_(std::make_unique<FileGroupStats>(minReuse)),
+      executor_(executor),
+      maxWriteBytesPerSec_(maxWriteBytesPerSec),
+      writeTokens_(maxWriteBytesPerSec),
+      lastRefillUs_(getCurrentTimeMicro()) {
   // Make sure the given path of Ssd files has the prefix for local file system.
   // Local file system would be derived based on the prefix.
   VELOX_CHECK(
@@ -50,13 +63,37 @@ SsdCache::SsdCache(
   // size.
   uint64_t sizeQuantum = numShards_ * SsdFile::kRegionSize;
   int32_t fileMaxRegions = bits::roundUp(maxBytes, sizeQuantum) / sizeQuantum;
+  // Opening a shard reads its checkpoint and log. The shards recover in
+  // parallel on 'executor_'. If there is no executor, move() opens the
+  // shards one after the other on this thread.
+  // The openers do not reference 'this', so that a failure to open one shard
+  // does not leave the others running against a destroyed cache.
+  std::vector<std::shared_ptr<AsyncSource<SsdFile>>> openers;
+  openers.reserve(numShards_);
+  const auto shardCheckpointBytes = checkpointIntervalBytes / numShards_;
   for (auto i = 0; i < numShards_; ++i) {
-    files_.push_back(std::make_unique<SsdFile>(
-        fmt::format("{}{}", filePrefix_, i),
-        i,
-        fileMaxRegions,
-        checkpointIntervalBytes / numShards,
-        disableFileCow));
+    openers.push_back(std::make_shared<AsyncSource<SsdFile>>(
+        [fileName = fmt::format("{}{}", filePrefix_, i),
+         i,
+         fileMaxRegions,
+         shardCheckpointBytes,
+         disableFileCow,
+         checksumEnabled]() {
+          return std::make_unique<SsdFile>(
+              fileName,
+              i,
+              fileMaxRegions,
+              shardCheckpointBytes,
+              disableFileCow,
+              nullptr,
+              checksumEnabled);
+        }));
+    if (executor_) {
+      executor_->add([opener = openers.back()]() { opener->prepare(); });
+    }
+  }
+  for (auto& opener : openers) {
+    files_.push_back(opener->move());
   }
 }
 
@@ -78,8 +115,52 @@ bool SsdCache::startWrite() {
   return false;
 }
 
+bool SsdCache::shouldSave(
+    uint64_t groupId,
+    TrackingId trackingId,
+    int32_t bytes) {
+  if (groupStats_->shouldSaveToSsd(groupId, trackingId)) {
+    bytesAdmitted_ += bytes;
+    return true;
+  }
+  bytesRejected_ += bytes;
+  return false;
+}
+
+uint64_t SsdCache::throttle(std::vector<CachePin>& pins) {
+  if (!maxWriteBytesPerSec_) {
+    return 0;
+  }
+  const auto now = getCurrentTimeMicro();
+  writeTokens_ = std::min<double>(
+      maxWriteBytesPerSec_,
+      writeTokens_ + (now - lastRefillUs_) * maxWriteBytesPerSec_ / 1e6);
+  lastRefillUs_ = now;
+  uint64_t throttled = 0;
+  int32_t numKept = 0;
+  for (auto& pin : pins) {
+    const auto size = pin.checkedEntry()->size();
+    // An entry larger than one second worth of writes goes when the bucket is
+    // full. The tokens then go negative and delay the next writes.
+    if (std::min<double>(size, maxWriteBytesPerSec_) > writeTokens_) {
+      // The entry stays saveable and is offered again.
+      throttled += size;
+      continue;
+    }
+    writeTokens_ -= size;
+    if (&pins[numKept] != &pin) {
+      pins[numKept] = std::move(pin);
+    }
+    ++numKept;
+  }
+  pins.resize(numKept);
+  bytesThrottled_ += throttled;
+  return throttled;
+}
+
 void SsdCache::write(std::vector<CachePin> pins) {
   VELOX_CHECK_LE(numShards_, writesInProgress_);
+  throttle(pins);
   uint64_t bytes = 0;
   auto start = getCurrentTimeMicro();
   std::vector<std::vector<CachePin>> shards(numShards_);
@@ -130,6 +211,9 @@ SsdCacheStats SsdCache::stats() const {
   for (auto& file : files_) {
     file->updateStats(stats);
   }
+  stats.bytesAdmitted = bytesAdmitted_;
+  stats.bytesRejected = bytesRejected_;
+  stats.bytesThrottled = bytesThrottled_;
   return stats;
 }
 
@@ -147,6 +231,13 @@ std::string SsdCache::toString() const {
       << (data.bytesRead >> 20) << "MB Size " << (capacity >> 30)
       << "GB Occupied " << (data.bytesCached >> 30) << "GB";
   out << (data.entriesCached >> 10) << "K entries.";
+  out << " Admitted " << (data.bytesAdmitted >> 20) << "MB rejected "
+      << (data.bytesRejected >> 20) << "MB throttled "
+      << (data.bytesThrottled >> 20) << "MB";
+  if (data.entriesRecovered || data.readChecksumErrors) {
+    out << " Recovered " << data.entriesRecovered << " entries, "
+        << data.readChecksumErrors << " checksum errors";
+  }
   out << "\nGroupStats: " << groupStats_->toString(capacity);
   return out.str();
 }
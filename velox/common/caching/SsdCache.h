@@ -18,6 +18,8 @@
 
 #include "velox/common/caching/SsdFile.h"
 
+DECLARE_double(ssd_min_reuse);
+
 namespace facebook::velox::cache {
 
 class SsdCache {
@@ -39,13 +41,27 @@ class SsdCache {
   /// write) feature if the underlying filesystem (such as brtfs) supports it.
   /// This prevents the actual cache space usage on disk from exceeding the
   /// 'maxBytes' limit and stop working.
+  /// If 'minReuse' is non-0, only data of file groups and columns that have
+  /// been read at least 'minReuse' times according to groupStats() is
+  /// admitted. See FileGroupStats. Defaults to FLAGS_ssd_min_reuse.
+  /// If 'maxWriteBytesPerSec' is non-0, writes are limited to this rate with
+  /// bursts of up to one second worth of writes. Entries over the limit are
+  /// not written and are offered again in a later write. An entry larger
+  /// than 'maxWriteBytesPerSec' is written after one second without writes.
+  /// If 'checksumEnabled' is true, entries are written to the checkpoint with
+  /// a checksum of their data. After a restart, the data of a restored entry
+  /// is checked on first read and the entry is dropped if it does not match.
+  /// The shards recover from their checkpoints in parallel on 'executor'.
   SsdCache(
       std::string_view filePrefix,
       uint64_t maxBytes,
       int32_t numShards,
       folly::Executor* executor,
       int64_t checkpointIntervalBytes = 0,
-      bool disableFileCow = false);
+      bool disableFileCow = false,
+      float minReuse = FLAGS_ssd_min_reuse,
+      uint64_t maxWriteBytesPerSec = 0,
+      bool checksumEnabled = false);
 
   // Returns the shard corresponding to 'fileId'. 'fileId' is a
   //  file id from e.g. FileCacheKey.
@@ -72,6 +88,10 @@ class SsdCache {
   // it must have returned true.
   void write(std::vector<CachePin> pins);
 
+  // Returns true if 'bytes' of data of 'groupId' and 'trackingId' should be
+  // saved to SSD. Counts the bytes as admitted or rejected.
+  bool shouldSave(uint64_t groupId, TrackingId trackingId, int32_t bytes);
+
   // Returns  stats aggregated from all shards.
   SsdCacheStats stats() const;
 
@@ -94,6 +114,10 @@ class SsdCache {
   std::string toString() const;
 
  private:
+  // Removes the pins over the write rate limit from 'pins'. Returns the
+  // number of bytes removed.
+  uint64_t throttle(std::vector<CachePin>& pins);
+
   const std::string filePrefix_;
   const int32_t numShards_;
   std::vector<std::unique_ptr<SsdFile>> files_;
@@ -105,6 +129,18 @@ class SsdCache {
   std::unique_ptr<FileGroupStats> groupStats_;
   folly::Executor* executor_;
   std::atomic<bool> isShutdown_{false};
+
+  const uint64_t maxWriteBytesPerSec_;
+  // Token bucket for 'maxWriteBytesPerSec_'. Only accessed in write(), which
+  // is serialized by startWrite().
+  double writeTokens_;
+  uint64_t lastRefillUs_;
+
+  // Bytes that passed or failed admission in shouldSave().
+  std::atomic<uint64_t> bytesAdmitted_{0};
+  std::atomic<uint64_t> bytesRejected_{0};
+  // Bytes deferred to a later write because of 'maxWriteBytesPerSec_'.
+  std::atomic<uint64_t> bytesThrottled_{0};
 };
 
 } // namespace facebook::velox::cache
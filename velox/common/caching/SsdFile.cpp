@@ -18,6 +18,7 @@
 #include <folly/Executor.h>
 #include <folly/portability/SysUio.h>
 #include "velox/common/base/AsyncSource.h"
+#include "velox/common/base/Crc.h"
 #include "velox/common/caching/FileIds.h"
 
 #include <fcntl.h>
@@ -101,13 +102,15 @@ SsdFile::SsdFile(
     int32_t maxRegions,
     int64_t checkpointIntervalBytes,
     bool disableFileCow,
-    folly::Executor* FOLLY_NULLABLE executor)
+    folly::Executor* FOLLY_NULLABLE executor,
+    bool checksumEnabled)
     : fileName_(filename),
       shardId_(shardId),
       maxRegions_(maxRegions),
       filename_(filename),
       checkpointIntervalBytes_(checkpointIntervalBytes),
-      executor_(executor) {
+      executor_(executor),
+      checksumEnabled_(checksumEnabled) {
   int32_t oDirect = 0;
 #ifdef linux
   oDirect = FLAGS_ssd_odirect ? O_DIRECT : 0;
@@ -210,6 +213,7 @@ bool SsdFile::erase(RawFileCacheKey key) {
   if (it == entries_.end()) {
     return false;
   }
+  setChecksumLocked(it->first, 0, false);
   entries_.erase(it);
   return true;
 }
@@ -258,6 +262,51 @@ CoalesceIoStats SsdFile::load(
         read(offset, buffers);
       });
 
+  // Entries restored at startup are checked against their checksum on first
+  // read. A prefix of an entry cannot be checked. The pairs are the index in
+  // 'pins' and the expected checksum.
+  std::vector<std::pair<int32_t, uint32_t>> toVerify;
+  {
+    std::lock_guard<std::shared_mutex> l(mutex_);
+    for (auto i = 0; i < ssdPins.size() && !unverified_.empty(); ++i) {
+      auto entry = pins[i].checkedEntry();
+      if (ssdPins[i].run().size() != entry->size()) {
+        continue;
+      }
+      FileCacheKey key{
+          entry->key().fileNum, static_cast<uint64_t>(entry->offset())};
+      if (unverified_.count(key)) {
+        toVerify.emplace_back(i, checksumLocked(key));
+      }
+    }
+  }
+  int32_t numBad = 0;
+  for (auto [i, checksum] : toVerify) {
+    auto entry = pins[i].checkedEntry();
+    const bool ok = checksumEntry(*entry, entry->size()) == checksum;
+    FileCacheKey key{
+        entry->key().fileNum, static_cast<uint64_t>(entry->offset())};
+    std::lock_guard<std::shared_mutex> l(mutex_);
+    auto it = entries_.find(key);
+    if (it == entries_.end() ||
+        it->second.offset() != ssdPins[i].run().offset() ||
+        unverified_.erase(key) == 0) {
+      continue;
+    }
+    if (!ok) {
+      checksums_.erase(key);
+      entries_.erase(it);
+      ++stats_.readChecksumErrors;
+      ++numBad;
+    }
+  }
+  if (numBad) {
+    VELOX_FAIL(
+        "IOERR: {} SSD cache entries in {} do not match their checksum",
+        numBad,
+        filename_);
+  }
+
   for (auto i = 0; i < ssdPins.size(); ++i) {
     pins[i].checkedEntry()->setSsdFile(this, ssdPins[i].run().offset());
   }
@@ -344,6 +393,7 @@ void SsdFile::clearRegionEntriesLocked(
     auto region = regionIndex(it->second.offset());
     if (std::find(regionIndices.begin(), regionIndices.end(), region) !=
         regionIndices.end()) {
+      setChecksumLocked(it->first, 0, false);
       it = entries_.erase(it);
     } else {
       ++it;
@@ -380,6 +430,7 @@ void SsdFile::write(std::vector<CachePin>& pins) {
     int32_t numWritten = 0;
     int32_t bytes = 0;
     std::vector<iovec> iovecs;
+    std::vector<uint32_t> checksums;
     for (auto i = storeIndex; i < pins.size(); ++i) {
       auto entry = pins[i].checkedEntry();
       auto entrySize = entry->size();
@@ -387,6 +438,9 @@ void SsdFile::write(std::vector<CachePin>& pins) {
         break;
       }
       addEntryToIovecs(*entry, iovecs);
+      if (checksumEnabled_) {
+        checksums.push_back(checksumEntry(*entry, entrySize));
+      }
       bytes += entrySize;
       ++numWritten;
     }
@@ -407,6 +461,12 @@ void SsdFile::write(std::vector<CachePin>& pins) {
         auto size = entry->size();
         FileCacheKey key = {
             entry->key().fileNum, static_cast<uint64_t>(entry->offset())};
+        setChecksumLocked(
+            key, checksumEnabled_ ? checksums[i - storeIndex] : 0, false);
+        if (checkpointIntervalBytes_) {
+          pendingWrites_.emplace_back(key, SsdRun(offset, size));
+          pendingWriteBytes_ += size;
+        }
         entries_[std::move(key)] = SsdRun(offset, size);
         if (FLAGS_ssd_verify_write) {
           verifyWrite(*entry, SsdRun(offset, size));
@@ -420,6 +480,7 @@ void SsdFile::write(std::vector<CachePin>& pins) {
     storeIndex += numWritten;
   }
 
+  syncWrites();
   if (checkpointIntervalBytes_ &&
       bytesAfterCheckpoint_ > checkpointIntervalBytes_) {
     checkpoint();
@@ -437,6 +498,54 @@ int32_t indexOfFirstMismatch(char* x, char* y, int n) {
 }
 } // namespace
 
+// static
+uint32_t SsdFile::checksumLocked(const FileCacheKey& key) const {
+  if (checksums_.empty()) {
+    return 0;
+  }
+  auto it = checksums_.find(key);
+  return it == checksums_.end() ? 0 : it->second;
+}
+
+void SsdFile::setChecksumLocked(
+    const FileCacheKey& key,
+    uint32_t checksum,
+    bool restored) {
+  if (checksum == 0) {
+    if (!checksums_.empty()) {
+      checksums_.erase(key);
+      unverified_.erase(key);
+    }
+    return;
+  }
+  checksums_[key] = checksum;
+  if (restored) {
+    unverified_.insert(key);
+  } else {
+    unverified_.erase(key);
+  }
+}
+
+uint32_t SsdFile::checksumEntry(
+    const AsyncDataCacheEntry& entry,
+    int32_t size) {
+  bits::Crc32 crc;
+  if (entry.tinyData()) {
+    crc.process_bytes(entry.tinyData(), size);
+  } else {
+    auto& data = entry.data();
+    int64_t bytesLeft = size;
+    for (auto i = 0; i < data.numRuns() && bytesLeft > 0; ++i) {
+      auto run = data.runAt(i);
+      const auto bytes = std::min<int64_t>(bytesLeft, run.numBytes());
+      crc.process_bytes(run.data<char>(), bytes);
+      bytesLeft -= bytes;
+    }
+  }
+  // 0 means no checksum.
+  return std::max<uint32_t>(1, crc.checksum());
+}
+
 void SsdFile::verifyWrite(AsyncDataCacheEntry& entry, SsdRun ssdRun) {
   auto testData = std::make_unique<char[]>(entry.size());
   auto rc = pread(fd_, testData.get(), entry.size(), ssdRun.offset());
@@ -491,11 +600,17 @@ void SsdFile::updateStats(SsdCacheStats& stats) const {
   stats.writeCheckpointErrors += stats_.writeCheckpointErrors;
   stats.readSsdErrors += stats_.readSsdErrors;
   stats.readCheckpointErrors += stats_.readCheckpointErrors;
+  stats.readChecksumErrors += stats_.readChecksumErrors;
+  stats.entriesRecovered += stats_.entriesRecovered;
 }
 
 void SsdFile::clear() {
   std::lock_guard<std::shared_mutex> l(mutex_);
   entries_.clear();
+  checksums_.clear();
+  unverified_.clear();
+  pendingWrites_.clear();
+  pendingWriteBytes_ = 0;
   std::fill(regionSize_.begin(), regionSize_.end(), 0);
   writableRegions_.resize(numRegions_);
   std::iota(writableRegions_.begin(), writableRegions_.end(), 0);
@@ -512,13 +627,116 @@ void SsdFile::deleteFile() {
   }
 }
 
+namespace {
+template <typename T>
+void appendNumber(std::string& buffer, T value) {
+  buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+} // namespace
+
+void SsdFile::appendLog(const char* data, int32_t size, const char* what) {
+  // The log is opened in append mode, so each record goes to the end in a
+  // single write.
+  int32_t rc = ::write(evictLogFd_, data, size);
+  if (rc != size) {
+    checkpointError(rc, what);
+  }
+}
+
+void SsdFile::resetLog() {
+  ftruncate(evictLogFd_, 0);
+  appendLog(kLogMagic, sizeof(int32_t), "Failed to reset log");
+}
+
 void SsdFile::logEviction(const std::vector<int32_t>& regions) {
   if (checkpointIntervalBytes_) {
-    int32_t rc = ::write(
-        evictLogFd_, regions.data(), regions.size() * sizeof(regions[0]));
-    if (rc != regions.size() * sizeof(regions[0])) {
-      checkpointError(rc, "Failed to log eviction");
+    // {kLogEvictRecord, numRegions, regions}.
+    std::string record;
+    appendNumber<int32_t>(record, kLogEvictRecord);
+    appendNumber<int32_t>(record, regions.size());
+    record.append(
+        reinterpret_cast<const char*>(regions.data()),
+        regions.size() * sizeof(regions[0]));
+    appendLog(record.data(), record.size(), "Failed to log eviction");
+    // The regions are rewritten as soon as this returns. A write record
+    // logged before this eviction must not be replayed over the new data
+    // after a crash, so the eviction must be durable first.
+    if (checkpointIntervalBytes_) {
+      const auto rc = fsync(evictLogFd_);
+      if (rc != 0) {
+        checkpointError(rc, "Failed to sync eviction log");
+      }
+    }
+  }
+}
+
+void SsdFile::syncWrites(bool force) {
+  std::vector<std::pair<FileCacheKey, SsdRun>> writes;
+  {
+    std::lock_guard<std::shared_mutex> l(mutex_);
+    if (pendingWrites_.empty() ||
+        (!force && pendingWriteBytes_ < kRegionSize)) {
+      return;
     }
+    writes.swap(pendingWrites_);
+    pendingWriteBytes_ = 0;
+  }
+  // A write record in the log must only describe data that is on the
+  // device. Otherwise a crash could leave recovered entries pointing to
+  // data that was never written.
+  if (fsync(fd_) != 0) {
+    LOG(ERROR) << "Failed to sync SSD: " << folly::errnoStr(errno);
+    ++stats_.writeSsdErrors;
+    return;
+  }
+  std::lock_guard<std::shared_mutex> l(mutex_);
+  logWritesLocked(writes);
+}
+
+void SsdFile::logWritesLocked(
+    const std::vector<std::pair<FileCacheKey, SsdRun>>& writes) {
+  if (!checkpointIntervalBytes_) {
+    return;
+  }
+  // One {kLogWriteRecord, nameSize, name, numEntries, {offset, SsdRun bits,
+  // checksum} x numEntries} record for each run of entries of the same file.
+  // Entries that were evicted or overwritten after the write are skipped.
+  std::string record;
+  std::string entries;
+  int32_t numEntries = 0;
+  auto flushFile = [&](uint64_t fileNum) {
+    if (numEntries == 0) {
+      return;
+    }
+    const auto name = fileIds().string(fileNum);
+    appendNumber<int32_t>(record, kLogWriteRecord);
+    appendNumber<int32_t>(record, name.size());
+    record.append(name);
+    appendNumber<int32_t>(record, numEntries);
+    record.append(entries);
+    entries.clear();
+    numEntries = 0;
+  };
+  for (auto i = 0; i < writes.size(); ++i) {
+    const auto& [key, run] = writes[i];
+    const auto fileNum = key.fileNum.id();
+    if (i > 0 && writes[i - 1].first.fileNum.id() != fileNum) {
+      flushFile(writes[i - 1].first.fileNum.id());
+    }
+    auto it = entries_.find(key);
+    if (it == entries_.end() || it->second.bits() != run.bits()) {
+      continue;
+    }
+    appendNumber<uint64_t>(entries, key.offset);
+    appendNumber<uint64_t>(entries, run.bits());
+    appendNumber<uint32_t>(entries, checksumLocked(key));
+    ++numEntries;
+  }
+  if (!writes.empty()) {
+    flushFile(writes.back().first.fileNum.id());
+  }
+  if (!record.empty()) {
+    appendLog(record.data(), record.size(), "Failed to log write");
   }
 }
 
@@ -528,8 +746,7 @@ void SsdFile::deleteCheckpoint(bool keepLog) {
   }
   if (evictLogFd_) {
     if (keepLog) {
-      lseek(evictLogFd_, 0, SEEK_SET);
-      ftruncate(evictLogFd_, 0);
+      resetLog();
       fsync(evictLogFd_);
     } else {
       close(evictLogFd_);
@@ -577,6 +794,9 @@ void SsdFile::checkpoint(bool force) {
   }
   checkpointDeleted_ = false;
   bytesAfterCheckpoint_ = 0;
+  // The checkpoint covers the writes not yet logged and syncs the data.
+  pendingWrites_.clear();
+  pendingWriteBytes_ = 0;
   try {
     // We schedule the potentially ;long fsync of the cache file on
     // another thread of the cache write executor, if available. If
@@ -597,7 +817,7 @@ void SsdFile::checkpoint(bool force) {
     // regionScores from the 'tracker_',
     // {fileId, fileName} pairs,
     // kMapMarker,
-    // {fileId, offset, SSdRun} triples,
+    // {fileId, offset, SSdRun, checksum} quadruples,
     // kEndMarker.
     state.write(kCheckpointMagic, sizeof(int32_t));
     state.write(asChar(&maxRegions_), sizeof(maxRegions_));
@@ -625,6 +845,8 @@ void SsdFile::checkpoint(bool force) {
       state.write(asChar(&pair.first.offset), sizeof(pair.first.offset));
       auto offsetAndSize = pair.second.bits();
       state.write(asChar(&offsetAndSize), sizeof(offsetAndSize));
+      auto checksum = checksumLocked(pair.first);
+      state.write(asChar(&checksum), sizeof(checksum));
     }
     const auto endMarker = kCheckpointEndMarker;
     state.write(asChar(&endMarker), sizeof(endMarker));
@@ -639,7 +861,8 @@ void SsdFile::checkpoint(bool force) {
       checkRc(-1, "Writing checkpoint file");
     }
     state.close();
-    ftruncate(evictLogFd_, 0);
+    // The checkpoint covers everything in the log.
+    resetLog();
     checkRc(fsync(evictLogFd_), "Sync of evict log");
     auto syncRc = sync->move();
     checkRc(*syncRc, fmt::format("Error in cache file fsync {}", *syncRc));
@@ -675,7 +898,8 @@ void SsdFile::initializeCheckpoint() {
     LOG(INFO) << "Starting shard " << shardId_ << " without checkpoint";
   }
   auto logPath = fileName_ + kLogExtension;
-  evictLogFd_ = open(logPath.c_str(), O_CREAT | O_RDWR, S_IRUSR | S_IWUSR);
+  evictLogFd_ = open(
+      logPath.c_str(), O_CREAT | O_RDWR | O_APPEND, S_IRUSR | S_IWUSR);
   if (evictLogFd_ < 0) {
     ++stats_.openLogErrors;
   }
@@ -687,20 +911,58 @@ void SsdFile::initializeCheckpoint() {
       logPath,
       evictLogFd_);
 
+  const auto numFileRegions = numRegions_;
+  bool hasLogMagic = false;
+  const auto logSize = lseek(evictLogFd_, 0, SEEK_END);
+  if (logSize >= sizeof(int32_t)) {
+    char magic[4];
+    auto rc = ::pread(evictLogFd_, magic, sizeof(magic), 0);
+    hasLogMagic = rc == sizeof(magic) && strncmp(magic, kLogMagic, 4) == 0;
+  }
   try {
     if (hasCheckpoint) {
       state.exceptions(std::ifstream::failbit);
       readCheckpoint(state);
+    } else if (hasLogMagic) {
+      // The log has the writes since the file was last started empty. All
+      // regions stay writable.
+      std::unordered_set<int32_t> evicted;
+      replayLog(evicted);
+      for (auto region = 0; region < numFileRegions; ++region) {
+        evicted.insert(region);
+      }
+      restoreRegionsLocked(numFileRegions, evicted);
+      LOG(INFO) << fmt::format(
+          "Starting shard {} from log with {} entries",
+          shardId_,
+          entries_.size());
     }
+    stats_.entriesRecovered = entries_.size();
   } catch (const std::exception& e) {
     ++stats_.readCheckpointErrors;
     try {
       LOG(ERROR) << "Error recovering from checkpoint " << e.what()
                  << ": Starting without checkpoint";
       entries_.clear();
+      checksums_.clear();
+      unverified_.clear();
+      numRegions_ = numFileRegions;
+      std::fill(regionSize_.begin(), regionSize_.end(), 0);
+      writableRegions_.resize(numRegions_);
+      std::iota(writableRegions_.begin(), writableRegions_.end(), 0);
       deleteCheckpoint(true);
     } catch (const std::exception& e) {
     }
+    return;
+  }
+  if (hasLogMagic) {
+    return;
+  }
+  if (hasCheckpoint && logSize > 0) {
+    // An eviction log of a previous version. A new checkpoint replaces it.
+    checkpoint(true);
+  } else {
+    resetLog();
   }
 }
 
@@ -721,6 +983,12 @@ bool SsdFile::testingIsCowDisabled() const {
 #endif // linux
 }
 
+bool SsdFile::testingNeedsVerify(RawFileCacheKey key) const {
+  FileCacheKey ssdKey{StringIdLease(fileIds(), key.fileNum), key.offset};
+  std::shared_lock<std::shared_mutex> l(mutex_);
+  return unverified_.count(ssdKey) != 0;
+}
+
 namespace {
 template <typename T>
 T readNumber(std::ifstream& stream) {
@@ -733,13 +1001,17 @@ T readNumber(std::ifstream& stream) {
 void SsdFile::readCheckpoint(std::ifstream& state) {
   char magic[4];
   state.read(magic, sizeof(magic));
-  VELOX_CHECK(strncmp(magic, kCheckpointMagic, 4) == 0);
+  const bool hasChecksums = strncmp(magic, kCheckpointMagic, 4) == 0;
+  VELOX_CHECK(hasChecksums || strncmp(magic, kCheckpointMagicV1, 4) == 0);
   auto maxRegions = readNumber<int32_t>(state);
   VELOX_CHECK_EQ(
       maxRegions,
       maxRegions_,
       "Trying to start from checkpoint with a different capacity");
+  const auto numFileRegions = numRegions_;
   numRegions_ = readNumber<int32_t>(state);
+  VELOX_CHECK_LE(
+      numRegions_, numFileRegions, "Checkpoint has more regions than file");
   std::vector<int64_t> scores(maxRegions);
   state.read(asChar(scores.data()), maxRegions_ * sizeof(uint64_t));
   std::unordered_map<uint64_t, StringIdLease> idMap;
@@ -754,39 +1026,30 @@ void SsdFile::readCheckpoint(std::ifstream& state) {
     auto lease = StringIdLease(fileIds(), name);
     idMap[id] = std::move(lease);
   }
-  auto logSize = lseek(evictLogFd_, 0, SEEK_END);
-  std::vector<uint32_t> evicted(logSize / sizeof(uint32_t));
-  auto rc = ::pread(evictLogFd_, evicted.data(), logSize, 0);
-  VELOX_CHECK_EQ(logSize, rc, "Failed to read eviction log");
-  std::unordered_set<uint32_t> evictedMap;
-  for (auto region : evicted) {
-    evictedMap.insert(region);
-  }
   for (;;) {
     uint64_t fileNum = readNumber<uint64_t>(state);
     if (fileNum == kCheckpointEndMarker) {
       break;
     }
     uint64_t offset = readNumber<uint64_t>(state);
-    auto run = SsdRun(readNumber<uint64_t>(state));
-    // Check that the recovered entry does not fall in an evicted region.
-    if (evictedMap.find(regionIndex(run.offset())) == evictedMap.end()) {
-      // The file may have a different id on restore.
-      auto it = idMap.find(fileNum);
-      VELOX_CHECK(it != idMap.end());
-      FileCacheKey key{it->second, offset};
-      entries_[std::move(key)] = run;
-    }
+    auto bits = readNumber<uint64_t>(state);
+    uint32_t checksum = hasChecksums ? readNumber<uint32_t>(state) : 0;
+    // The file may have a different id on restore.
+    auto it = idMap.find(fileNum);
+    VELOX_CHECK(it != idMap.end());
+    FileCacheKey key{it->second, offset};
+    setChecksumLocked(key, checksum, true);
+    entries_[std::move(key)] = SsdRun(bits);
   }
+  // Apply the evictions and writes after the checkpoint.
+  std::unordered_set<int32_t> evicted;
+  replayLog(evicted);
+
   // The state is successfully read. Install the access frequency scores and
   // evicted regions.
   VELOX_CHECK_EQ(scores.size(), tracker_.regionScores().size());
-  // Set the writable regions by deduplicated evicted regions.
-  writableRegions_.clear();
-  for (auto region : evictedMap) {
-    writableRegions_.push_back(region);
-  }
   tracker_.setRegionScores(scores);
+  restoreRegionsLocked(numFileRegions, evicted);
   LOG(INFO) << fmt::format(
       "Starting shard {} from checkpoint with {} entries, {} regions with {} free.",
       shardId_,
@@ -795,4 +1058,116 @@ void SsdFile::readCheckpoint(std::ifstream& state) {
       writableRegions_.size());
 }
 
+void SsdFile::replayLog(std::unordered_set<int32_t>& evicted) {
+  const auto logSize = lseek(evictLogFd_, 0, SEEK_END);
+  std::string log;
+  log.resize(logSize);
+  auto rc = ::pread(evictLogFd_, log.data(), logSize, 0);
+  VELOX_CHECK_EQ(logSize, rc, "Failed to read eviction log");
+  if (logSize < sizeof(int32_t) || strncmp(log.data(), kLogMagic, 4) != 0) {
+    // Eviction log of a previous version: the evicted region numbers.
+    const auto* regions = reinterpret_cast<const uint32_t*>(log.data());
+    std::vector<int32_t> regionList(
+        regions, regions + logSize / sizeof(uint32_t));
+    evicted.insert(regionList.begin(), regionList.end());
+    clearRegionEntriesLocked(regionList);
+    return;
+  }
+  size_t position = sizeof(int32_t);
+  size_t recordStart = position;
+  // Copies the next number in 'log' to 'value'. Returns false if the log ends
+  // before that.
+  auto next = [&](auto& value) {
+    if (position + sizeof(value) > log.size()) {
+      return false;
+    }
+    memcpy(&value, log.data() + position, sizeof(value));
+    position += sizeof(value);
+    return true;
+  };
+  for (;;) {
+    recordStart = position;
+    int32_t kind;
+    int32_t size;
+    if (!next(kind) || !next(size)) {
+      break;
+    }
+    VELOX_CHECK_GE(size, 0, "Bad record size in log");
+    if (kind == kLogEvictRecord) {
+      std::vector<int32_t> regions(size);
+      bool complete = true;
+      for (auto& region : regions) {
+        complete = complete && next(region);
+      }
+      if (!complete) {
+        break;
+      }
+      evicted.insert(regions.begin(), regions.end());
+      clearRegionEntriesLocked(regions);
+      continue;
+    }
+    VELOX_CHECK_EQ(kind, kLogWriteRecord, "Bad record type in log");
+    // 'size' is the length of the file name.
+    if (position + size > log.size()) {
+      break;
+    }
+    std::string_view name(log.data() + position, size);
+    position += size;
+    int32_t numEntries;
+    if (!next(numEntries)) {
+      break;
+    }
+    // {offset, SsdRun bits, checksum} for each entry.
+    std::vector<std::tuple<uint64_t, uint64_t, uint32_t>> runs(numEntries);
+    bool complete = true;
+    for (auto i = 0; i < numEntries && complete; ++i) {
+      auto& [offset, bits, checksum] = runs[i];
+      complete = next(offset) && next(bits) && next(checksum);
+    }
+    if (!complete) {
+      break;
+    }
+    StringIdLease file(fileIds(), name);
+    for (auto& [offset, bits, checksum] : runs) {
+      FileCacheKey key{file, offset};
+      setChecksumLocked(key, checksum, true);
+      entries_[std::move(key)] = SsdRun(bits);
+    }
+  }
+  if (recordStart < log.size()) {
+    // A crash during the last append. Drop the incomplete record so that new
+    // records follow the last complete one.
+    LOG(WARNING) << "Dropping " << log.size() - recordStart
+                 << " bytes of incomplete record at end of " << fileName_
+                 << kLogExtension;
+    ftruncate(evictLogFd_, recordStart);
+  }
+}
+
+void SsdFile::restoreRegionsLocked(
+    int32_t numFileRegions,
+    const std::unordered_set<int32_t>& evicted) {
+  // Regions added after the checkpoint are writable like the evicted ones.
+  // Writing continues after the last restored entry of each region.
+  const auto numCheckpointRegions = numRegions_;
+  std::fill(regionSize_.begin(), regionSize_.end(), 0);
+  for (auto& [key, run] : entries_) {
+    const auto region = regionIndex(run.offset());
+    VELOX_CHECK_LT(region, numFileRegions, "Restored entry past end of file");
+    numRegions_ = std::max(numRegions_, region + 1);
+    regionSize_[region] = std::max<uint32_t>(
+        regionSize_[region], run.offset() + run.size() - region * kRegionSize);
+  }
+  for (auto region : evicted) {
+    VELOX_CHECK_LT(region, numFileRegions, "Evicted region past end of file");
+    numRegions_ = std::max(numRegions_, region + 1);
+  }
+  writableRegions_.assign(evicted.begin(), evicted.end());
+  for (auto region = numCheckpointRegions; region < numRegions_; ++region) {
+    if (evicted.count(region) == 0) {
+      writableRegions_.push_back(region);
+    }
+  }
+}
+
 } // namespace facebook::velox::cache
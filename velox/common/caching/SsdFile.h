@@ -20,8 +20,11 @@
 #include "velox/common/caching/SsdFileTracker.h"
 #include "velox/common/file/File.h"
 
+#include <folly/container/F14Set.h>
 #include <gflags/gflags.h>
 
+#include <unordered_set>
+
 DECLARE_bool(ssd_odirect);
 DECLARE_bool(ssd_verify_write);
 
@@ -134,6 +137,9 @@ struct SsdCacheStats {
     entriesCached = tsanAtomicValue(other.entriesCached);
     bytesCached = tsanAtomicValue(other.bytesCached);
     numPins = tsanAtomicValue(other.numPins);
+    bytesAdmitted = tsanAtomicValue(other.bytesAdmitted);
+    bytesRejected = tsanAtomicValue(other.bytesRejected);
+    bytesThrottled = tsanAtomicValue(other.bytesThrottled);
 
     openFileErrors = tsanAtomicValue(other.openFileErrors);
     openCheckpointErrors = tsanAtomicValue(other.openCheckpointErrors);
@@ -144,6 +150,8 @@ struct SsdCacheStats {
     writeCheckpointErrors = tsanAtomicValue(other.writeCheckpointErrors);
     readSsdErrors = tsanAtomicValue(other.readSsdErrors);
     readCheckpointErrors = tsanAtomicValue(other.readCheckpointErrors);
+    readChecksumErrors = tsanAtomicValue(other.readChecksumErrors);
+    entriesRecovered = tsanAtomicValue(other.entriesRecovered);
   }
 
   tsan_atomic<uint64_t> entriesWritten{0};
@@ -153,6 +161,12 @@ struct SsdCacheStats {
   tsan_atomic<uint64_t> entriesCached{0};
   tsan_atomic<uint64_t> bytesCached{0};
   tsan_atomic<int32_t> numPins{0};
+  // Bytes that passed or failed SSD admission when loaded into memory.
+  tsan_atomic<uint64_t> bytesAdmitted{0};
+  tsan_atomic<uint64_t> bytesRejected{0};
+  // Bytes of admitted entries deferred to a later write because of the write
+  // rate limit. An entry deferred several times counts each time.
+  tsan_atomic<uint64_t> bytesThrottled{0};
 
   tsan_atomic<uint32_t> openFileErrors{0};
   tsan_atomic<uint32_t> openCheckpointErrors{0};
@@ -163,6 +177,10 @@ struct SsdCacheStats {
   tsan_atomic<uint32_t> writeCheckpointErrors{0};
   tsan_atomic<uint32_t> readSsdErrors{0};
   tsan_atomic<uint32_t> readCheckpointErrors{0};
+  // Entries restored at startup whose data did not match the checksum.
+  tsan_atomic<uint32_t> readChecksumErrors{0};
+  // Entries restored at startup from the checkpoint and the log.
+  tsan_atomic<uint64_t> entriesRecovered{0};
 };
 
 // A shard of SsdCache. Corresponds to one file on SSD.  The data
@@ -178,14 +196,18 @@ class SsdFile {
   static constexpr uint64_t kRegionSize = 1 << 26; // 64MB
 
   // Constructs a cache backed by filename. Discards any previous
-  // contents of filename.
+  // contents of filename unless 'checkpointInternalBytes' is non-0 and
+  // there is a checkpoint or a log to recover from. If 'checksumEnabled' is
+  // true, a checksum of each entry is written to the checkpoint. Restored
+  // entries with a checksum are verified on first read.
   SsdFile(
       const std::string& filename,
       int32_t shardId,
       int32_t maxRegions,
       int64_t checkpointInternalBytes = 0,
       bool disableFileCow = false,
-      folly::Executor* FOLLY_NULLABLE executor = nullptr);
+      folly::Executor* FOLLY_NULLABLE executor = nullptr,
+      bool checksumEnabled = false);
 
   // Adds entries of  'pins'  to this file. 'pins' must be in read mode and
   // those pins that are successfully added to SSD are marked as being on SSD.
@@ -199,7 +221,9 @@ class SsdFile {
   bool erase(RawFileCacheKey key);
 
   // Copies the data in 'ssdPins' into 'pins'. Coalesces IO for nearby
-  // entries if they are in ascending order and near enough.
+  // entries if they are in ascending order and near enough. Throws and
+  // erases the entry if the data of an entry restored at startup does not
+  // match its checksum.
   CoalesceIoStats load(
       const std::vector<SsdPin>& ssdPins,
       const std::vector<CachePin>& pins);
@@ -248,16 +272,35 @@ class SsdFile {
   // Writes a checkpoint state that can be recovered from. The
   // checkpoint is serialized on 'mutex_'. If 'force' is false,
   // rechecks that at least 'checkpointIntervalBytes_' have been
-  // written since last checkpoint and silently returns if not.
+  // written since last checkpoint and silently returns if not. Between
+  // checkpoints, writes and evictions are appended to the log, so that a
+  // restart also recovers the entries written after the last checkpoint.
   void checkpoint(bool force = false);
 
+  // Syncs the data file and logs the entries written since the last sync or
+  // checkpoint. If 'force' is false, silently returns unless at least
+  // kRegionSize bytes are pending. Called after each write, so a crash loses
+  // at most the last region's worth of writes since the last checkpoint.
+  void syncWrites(bool force = false);
+
   /// Returns true if copy on write is disabled for this file. Used in testing.
   bool testingIsCowDisabled() const;
 
+  /// Returns true if the entry at 'key' was restored at startup and has not
+  /// yet been checked against its checksum. Used in testing.
+  bool testingNeedsVerify(RawFileCacheKey key) const;
+
  private:
   // 4 first bytes of a checkpoint file. Allows distinguishing between format
-  // versions.
-  static constexpr const char* FOLLY_NONNULL kCheckpointMagic = "CPT1";
+  // versions. Version 2 has a checksum after each entry.
+  static constexpr const char* FOLLY_NONNULL kCheckpointMagicV1 = "CPT1";
+  static constexpr const char* FOLLY_NONNULL kCheckpointMagic = "CPT2";
+  // 4 first bytes of a log with typed records. A log without this consists
+  // of evicted region numbers.
+  static constexpr const char* FOLLY_NONNULL kLogMagic = "LOG1";
+  // Record types in the log.
+  static constexpr int32_t kLogEvictRecord = 1;
+  static constexpr int32_t kLogWriteRecord = 2;
   // Magic number separating file names from cache entry data in checkpoint
   // file.
   static constexpr int64_t kCheckpointMapMarker = 0xfffffffffffffffe;
@@ -317,6 +360,45 @@ class SsdFile {
   // checkpoint.
   void logEviction(const std::vector<int32_t>& regions);
 
+  // Logs the entries of 'writes' that have been synced to SSD and are still
+  // in 'entries_' with the same run. Caller must hold 'mutex_'.
+  void logWritesLocked(
+      const std::vector<std::pair<FileCacheKey, SsdRun>>& writes);
+
+  // Appends 'size' bytes at 'data' to the log. Turns off checkpointing on
+  // error.
+  void appendLog(const char* data, int32_t size, const char* what);
+
+  // Truncates the log and writes kLogMagic.
+  void resetLog();
+
+  // Applies the records in the log to 'entries_'. Adds the regions evicted
+  // after the last checkpoint to 'evicted'. Stops at an incomplete record
+  // at the end.
+  void replayLog(std::unordered_set<int32_t>& evicted);
+
+  // Sets the region sizes from the restored 'entries_' and makes 'evicted'
+  // and the regions added after the checkpoint writable. Caller must hold
+  // 'mutex_' or be the constructor.
+  void restoreRegionsLocked(
+      int32_t numFileRegions,
+      const std::unordered_set<int32_t>& evicted);
+
+  // Returns the checksum of the first 'size' bytes of the data of 'entry'.
+  static uint32_t checksumEntry(
+      const AsyncDataCacheEntry& entry,
+      int32_t size);
+
+  // Returns the checksum of the entry at 'key' or 0 if there is none.
+  uint32_t checksumLocked(const FileCacheKey& key) const;
+
+  // Sets the checksum of the entry at 'key'. If 'restored' is true, the data
+  // is checked against 'checksum' on first read. 0 means no checksum.
+  void setChecksumLocked(
+      const FileCacheKey& key,
+      uint32_t checksum,
+      bool restored);
+
   // Serializes access to all private data members.
   mutable std::shared_mutex mutex_;
   // Name of cache file, used as prefix for checkpoint files.
@@ -356,6 +438,13 @@ class SsdFile {
   // Map of file number and offset to location in file.
   folly::F14FastMap<FileCacheKey, SsdRun> entries_;
 
+  // Checksums of the 'entries_' that have one. Kept apart from 'entries_' so
+  // that an entry costs no more than its SsdRun when checksums are off.
+  folly::F14FastMap<FileCacheKey, uint32_t> checksums_;
+
+  // Keys of the restored 'entries_' not yet checked against 'checksums_'.
+  folly::F14FastSet<FileCacheKey> unverified_;
+
   // Name of backing file.
   const std::string filename_;
 
@@ -382,11 +471,21 @@ class SsdFile {
   // Count of bytes written after last checkpoint.
   std::atomic<uint64_t> bytesAfterCheckpoint_{0};
 
+  // Entries written since the last sync or checkpoint. These are logged by
+  // syncWrites() after the data file is synced.
+  std::vector<std::pair<FileCacheKey, SsdRun>> pendingWrites_;
+
+  // Count of bytes in 'pendingWrites_'.
+  uint64_t pendingWriteBytes_{0};
+
   // fd for logging evictions.
   int32_t evictLogFd_{0};
 
   // True if there was an error with checkpoint and the checkpoint was deleted.
   bool checkpointDeleted_{false};
+
+  // True if checksums of written entries are kept.
+  const bool checksumEnabled_;
 };
 
 } // namespace facebook::velox::cache
@@ -84,7 +84,11 @@ class AsyncDataCacheTest : public testing::Test {
     }
   }
 
-  void initializeCache(uint64_t maxBytes, int64_t ssdBytes = 0) {
+  void initializeCache(
+      uint64_t maxBytes,
+      int64_t ssdBytes = 0,
+      const AsyncDataCache::Options& cacheOptions = {},
+      uint64_t ssdWriteBytesPerSec = 0) {
     std::unique_ptr<SsdCache> ssdCache;
     if (ssdBytes) {
       // tmpfs does not support O_DIRECT, so turn this off for testing.
@@ -100,14 +104,17 @@ class AsyncDataCacheTest : public testing::Test {
           ssdBytes,
           4,
           executor(),
-          ssdBytes / 20);
+          ssdBytes / 20,
+          false,
+          0,
+          ssdWriteBytesPerSec);
     }
     memory::MmapAllocator::Options options;
     options.capacity = maxBytes;
     cache_ = std::make_shared<AsyncDataCache>(
         std::make_shared<memory::MmapAllocator>(options),
-        maxBytes,
-        std::move(ssdCache));
+        std::move(ssdCache),
+        cacheOptions);
     if (filenames_.empty()) {
       for (auto i = 0; i < kNumFiles; ++i) {
         auto name = fmt::format("testing_file_{}", i);
@@ -608,6 +615,77 @@ TEST_F(AsyncDataCacheTest, outOfCapacity) {
   clearAllocations(allocations);
 }
 
+TEST_F(AsyncDataCacheTest, numShards) {
+  constexpr int64_t kMaxBytes = 64 << 20;
+  AsyncDataCache::Options cacheOptions;
+  cacheOptions.numShards = 3;
+  VELOX_ASSERT_THROW(
+      initializeCache(kMaxBytes, 0, cacheOptions),
+      "numShards must be a power of 2: 3");
+
+  cacheOptions.numShards = 64;
+  initializeCache(kMaxBytes, 0, cacheOptions);
+  runThreads(8, [&](int32_t /*i*/) { loadLoop(0, kMaxBytes * 2, 0); });
+  auto stats = cache_->refreshStats();
+  EXPECT_LT(0, stats.numHit);
+  EXPECT_LT(0, stats.numEvict);
+  EXPECT_GE(
+      kMaxBytes / memory::AllocationTraits::kPageSize,
+      cache_->incrementCachedPages(0));
+}
+
+TEST_F(AsyncDataCacheTest, tinyLfu) {
+  constexpr int64_t kMaxBytes = 64 << 20;
+  constexpr int32_t kSize = 64 << 10;
+  constexpr int32_t kNumHot = 16;
+  AsyncDataCache::Options cacheOptions;
+  cacheOptions.tinyLfu = true;
+  initializeCache(kMaxBytes, 0, cacheOptions);
+
+  // Reads an entry like CacheInputStream does.
+  auto read = [&](uint64_t fileNum, uint64_t offset) {
+    auto pin = cache_->findOrCreate(RawFileCacheKey{fileNum, offset}, kSize);
+    ASSERT_FALSE(pin.empty());
+    auto entry = pin.checkedEntry();
+    if (entry->isExclusive()) {
+      entry->setExclusiveToShared();
+    } else {
+      entry->getAndClearFirstUseFlag();
+    }
+  };
+
+  // The hot entries are read 4 times. The first read after loading is not a
+  // reuse, the next one moves the entry to the protected segment.
+  const auto hotFile = filenames_[0].id();
+  for (auto i = 0; i < 4; ++i) {
+    for (auto j = 0; j < kNumHot; ++j) {
+      read(hotFile, j * kSize);
+    }
+  }
+  auto stats = cache_->refreshStats();
+  EXPECT_EQ(kNumHot, stats.numProtected);
+  EXPECT_EQ(kNumHot, stats.numProbationHit);
+  EXPECT_EQ(kNumHot, stats.numProtectedHit);
+
+  // A one-off scan of 4x the capacity.
+  const auto scanFile = filenames_[1].id();
+  for (auto i = 0; i < 4 * kMaxBytes / kSize; ++i) {
+    read(scanFile, i * static_cast<uint64_t>(kSize));
+  }
+  for (auto j = 0; j < kNumHot; ++j) {
+    EXPECT_TRUE(cache_->exists(RawFileCacheKey{hotFile, j * kSize}));
+  }
+  stats = cache_->refreshStats();
+  EXPECT_EQ(kNumHot, stats.numProtected);
+  EXPECT_LT(0, stats.numAdmissionEvict);
+  EXPECT_LE(stats.numAdmissionEvict, stats.numEvict);
+
+  cache_->clear();
+  stats = cache_->refreshStats();
+  EXPECT_EQ(0, stats.numEntries);
+  EXPECT_EQ(0, stats.numProtected);
+}
+
 namespace {
 // Cuts off the last 1/10th of file at 'path'.
 void corruptFile(const std::string& path) {
@@ -618,6 +696,55 @@ void corruptFile(const std::string& path) {
 }
 } // namespace
 
+TEST_F(AsyncDataCacheTest, compressedTier) {
+  constexpr int64_t kMaxBytes = 64 << 20;
+  constexpr int32_t kSize = 64 << 10;
+  AsyncDataCache::Options cacheOptions;
+  cacheOptions.compressedBytes = 256 << 20;
+  initializeCache(kMaxBytes, 0, cacheOptions);
+
+  // Reads 2x the capacity once.
+  const auto file = filenames_[0].id();
+  constexpr int32_t kNumEntries = 2 * kMaxBytes / kSize;
+  for (auto i = 0; i < kNumEntries; ++i) {
+    const uint64_t offset = i * static_cast<uint64_t>(kSize);
+    auto pin = cache_->findOrCreate(RawFileCacheKey{file, offset}, kSize);
+    ASSERT_FALSE(pin.empty());
+    auto entry = pin.checkedEntry();
+    ASSERT_TRUE(entry->isExclusive());
+    initializeContents(file + offset, entry->data());
+    entry->setExclusiveToShared();
+  }
+  auto stats = cache_->refreshStats();
+  EXPECT_LT(0, stats.numEvict);
+  EXPECT_LT(0, stats.numCompressed);
+  EXPECT_LT(stats.compressedBytes, stats.compressedRawBytes);
+
+  // The evicted entries are filled from their compressed copies.
+  int32_t numLoaded = 0;
+  for (auto i = 0; i < kNumEntries && numLoaded < 10; ++i) {
+    const uint64_t offset = i * static_cast<uint64_t>(kSize);
+    if (cache_->exists(RawFileCacheKey{file, offset})) {
+      continue;
+    }
+    auto pin = cache_->findOrCreate(RawFileCacheKey{file, offset}, kSize);
+    auto entry = pin.checkedEntry();
+    ASSERT_TRUE(entry->isExclusive());
+    ASSERT_TRUE(cache_->loadCompressed(*entry));
+    checkContents(*entry);
+    entry->setExclusiveToShared();
+    ++numLoaded;
+  }
+  EXPECT_EQ(10, numLoaded);
+  stats = cache_->refreshStats();
+  EXPECT_EQ(numLoaded, stats.numCompressedHit);
+
+  cache_->clear();
+  stats = cache_->refreshStats();
+  EXPECT_EQ(0, stats.numEntries);
+  EXPECT_EQ(0, stats.numCompressed);
+}
+
 TEST_F(AsyncDataCacheTest, ssd) {
 #ifdef TSAN_BUILD
   // NOTE: scale down the test data set to prevent tsan tester from running out
@@ -697,6 +824,37 @@ TEST_F(AsyncDataCacheTest, ssd) {
   ASSERT_LT(kSsdBytes / 2, stats2.bytesRead);
 }
 
+TEST_F(AsyncDataCacheTest, ssdWriteRateLimit) {
+  constexpr uint64_t kRamBytes = 32 << 20;
+  constexpr uint64_t kSsdBytes = 256UL << 20;
+  constexpr uint64_t kWriteBytesPerSec = 4 << 20;
+  initializeCache(kRamBytes, kSsdBytes, {}, kWriteBytesPerSec);
+  loadLoop(0, kSsdBytes, 0);
+  auto ssdCache = cache_->ssdCache();
+  while (ssdCache->writeInProgress()) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10)); // NOLINT
+  }
+  const auto stats = ssdCache->stats();
+  EXPECT_LT(0, stats.bytesAdmitted);
+  EXPECT_EQ(0, stats.bytesRejected);
+  EXPECT_LT(0, stats.bytesThrottled);
+  EXPECT_LT(stats.bytesWritten, stats.bytesAdmitted);
+}
+
+TEST_F(AsyncDataCacheTest, ssdWriteRateLimitLargeEntries) {
+  constexpr uint64_t kRamBytes = 32 << 20;
+  constexpr uint64_t kSsdBytes = 256UL << 20;
+  // All entries are larger than one second worth of writes. They are written
+  // when a full second of writes is allowed.
+  initializeCache(kRamBytes, kSsdBytes, {}, 1);
+  loadLoop(0, kSsdBytes, 0);
+  auto ssdCache = cache_->ssdCache();
+  while (ssdCache->writeInProgress()) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10)); // NOLINT
+  }
+  EXPECT_LT(0, ssdCache->stats().bytesWritten);
+}
+
 TEST_F(AsyncDataCacheTest, invalidSsdPath) {
   auto testPath = "hdfs:/test/prefix_";
   uint64_t ssdBytes = 256UL << 20;
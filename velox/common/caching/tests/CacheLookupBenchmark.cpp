@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/Random.h>
+#include <folly/init/Init.h>
+
+#include <thread>
+
+#include "velox/common/caching/AsyncDataCache.h"
+#include "velox/common/caching/FileIds.h"
+#include "velox/common/memory/MmapAllocator.h"
+
+DEFINE_int32(num_threads, 64, "Number of threads looking up entries");
+DEFINE_int32(num_entries, 100'000, "Number of distinct cached entries");
+
+/// Measures contention on the AsyncDataCache shards. FLAGS_num_threads
+/// threads each do the benchmark iteration count of lookups of random keys
+/// that are all in the cache, like drivers reading the same cached columns.
+/// The parameter is the shard count.
+
+using namespace facebook::velox;
+using namespace facebook::velox::cache;
+
+namespace {
+
+// Below AsyncDataCacheEntry::kTinyDataSize so that the allocator is not
+// involved.
+constexpr int32_t kEntrySize = 1000;
+
+void lookups(uint32_t iters, int32_t numShards) {
+  folly::BenchmarkSuspender suspender;
+  memory::MmapAllocator::Options allocatorOptions;
+  allocatorOptions.capacity = 1UL << 30;
+  AsyncDataCache::Options options;
+  options.numShards = numShards;
+  auto cache = std::make_shared<AsyncDataCache>(
+      std::make_shared<memory::MmapAllocator>(allocatorOptions),
+      nullptr,
+      options);
+
+  StringIdLease file(fileIds(), std::string_view("cacheLookupBenchmark"));
+  auto key = [&](uint64_t index) {
+    return RawFileCacheKey{file.id(), index * kEntrySize};
+  };
+  // Gets a pin on 'index' and fills the entry if it is new.
+  auto read = [&](uint64_t index) {
+    auto pin = cache->findOrCreate(key(index), kEntrySize);
+    if (!pin.empty() && pin.checkedEntry()->isExclusive()) {
+      pin.checkedEntry()->setExclusiveToShared();
+    }
+  };
+  for (auto i = 0; i < FLAGS_num_entries; ++i) {
+    read(i);
+  }
+
+  std::vector<std::thread> threads;
+  threads.reserve(FLAGS_num_threads);
+  suspender.dismiss();
+
+  for (auto i = 0; i < FLAGS_num_threads; ++i) {
+    threads.emplace_back([&, i]() {
+      folly::Random::DefaultGenerator rng(i);
+      for (uint32_t counter = 0; counter < iters; ++counter) {
+        read(folly::Random::rand32(FLAGS_num_entries, rng));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  suspender.rehire();
+  auto stats = cache->refreshStats();
+  VELOX_CHECK_GE(
+      stats.numHit + stats.numNew,
+      static_cast<int64_t>(iters) * FLAGS_num_threads);
+  cache.reset();
+}
+
+} // namespace
+
+BENCHMARK_PARAM(lookups, 1);
+BENCHMARK_PARAM(lookups, 4);
+BENCHMARK_PARAM(lookups, 16);
+BENCHMARK_PARAM(lookups, 64);
+BENCHMARK_PARAM(lookups, 256);
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
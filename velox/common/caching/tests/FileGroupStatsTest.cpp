@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/FileGroupStats.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::velox::cache;
+
+TEST(FileGroupStatsTest, noAdmission) {
+  FileGroupStats stats;
+  stats.recordFile(1, 1, 1);
+  stats.recordReference(1, 1, TrackingId(1), 1000);
+  stats.updateSsdFilter(1 << 30);
+  EXPECT_TRUE(stats.shouldSaveToSsd(1, TrackingId(1)));
+  EXPECT_EQ(0, stats.reuse(1, TrackingId(1)));
+}
+
+TEST(FileGroupStatsTest, reuse) {
+  constexpr int32_t kNumFiles = 10;
+  constexpr int32_t kBytes = 1000;
+  constexpr uint64_t kGroup = 1;
+  const TrackingId hot(1);
+  const TrackingId cold(2);
+  FileGroupStats stats(1.5);
+  // Two scans read 'hot' from all files of the group. Only the first also
+  // reads 'cold'.
+  for (auto pass = 0; pass < 2; ++pass) {
+    for (auto file = 0; file < kNumFiles; ++file) {
+      stats.recordFile(file, kGroup, 1);
+      stats.recordReference(file, kGroup, hot, kBytes);
+      stats.recordRead(file, kGroup, hot, kBytes);
+      if (pass == 0) {
+        stats.recordReference(file, kGroup, cold, kBytes);
+        stats.recordRead(file, kGroup, cold, kBytes);
+      }
+    }
+  }
+  EXPECT_FLOAT_EQ(2, stats.reuse(kGroup, hot));
+  EXPECT_FLOAT_EQ(1, stats.reuse(kGroup, cold));
+
+  // Tracked data does not qualify before the filter is computed. Untracked
+  // data always qualifies.
+  EXPECT_FALSE(stats.shouldSaveToSsd(kGroup, hot));
+  EXPECT_TRUE(stats.shouldSaveToSsd(kGroup, TrackingId(3)));
+  EXPECT_TRUE(stats.shouldSaveToSsd(2, hot));
+
+  stats.updateSsdFilter(1 << 30);
+  EXPECT_TRUE(stats.shouldSaveToSsd(kGroup, hot));
+  EXPECT_FALSE(stats.shouldSaveToSsd(kGroup, cold));
+
+  // 'hot' takes kNumFiles * kBytes and does not fit.
+  stats.updateSsdFilter(kNumFiles * kBytes / 2);
+  EXPECT_FALSE(stats.shouldSaveToSsd(kGroup, hot));
+
+  // Decay lowers the reuse of old accesses.
+  stats.updateSsdFilter(1 << 30, 50);
+  EXPECT_FLOAT_EQ(1, stats.reuse(kGroup, hot));
+  EXPECT_FALSE(stats.shouldSaveToSsd(kGroup, hot));
+}
+
+TEST(FileGroupStatsTest, idleFilesAreDropped) {
+  constexpr uint64_t kGroup = 1;
+  const TrackingId column(1);
+  FileGroupStats stats(1);
+  stats.recordFile(1, kGroup, 1);
+  stats.recordReference(1, kGroup, column, 1000);
+  stats.recordRead(1, kGroup, column, 1000);
+  EXPECT_FLOAT_EQ(1, stats.reuse(kGroup, column));
+
+  // The file and the column are kept for 8 updates without use.
+  for (auto i = 0; i < 8; ++i) {
+    stats.updateSsdFilter(1 << 30);
+  }
+  EXPECT_FLOAT_EQ(1, stats.reuse(kGroup, column));
+  EXPECT_TRUE(stats.shouldSaveToSsd(kGroup, column));
+
+  stats.updateSsdFilter(1 << 30);
+  EXPECT_EQ(0, stats.reuse(kGroup, column));
+  EXPECT_EQ(
+      "<FileGroupStats: 0 groups 0 columns, 0 columns 0MB qualify for SSD, "
+      "tracked working set 0MB 100% cacheable, min reuse 1>",
+      stats.toString(1 << 30));
+
+  // References to a group without files are not tracked.
+  stats.recordReference(1, kGroup, column, 1000);
+  stats.recordRead(1, kGroup, column, 1000);
+  EXPECT_EQ(0, stats.reuse(kGroup, column));
+}
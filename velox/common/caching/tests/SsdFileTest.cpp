@@ -14,10 +14,12 @@
  * limitations under the License.
  */
 
+#include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/caching/FileIds.h"
 #include "velox/common/caching/SsdCache.h"
 #include "velox/exec/tests/utils/TempDirectoryPath.h"
 
+#include <fcntl.h>
 #include <folly/executors/QueuedImmediateExecutor.h>
 #include <glog/logging.h>
 #include <gtest/gtest.h>
@@ -50,7 +52,9 @@ class SsdFileTest : public testing::Test {
   void initializeCache(
       int64_t maxBytes,
       int64_t ssdBytes = 0,
-      bool setNoCowFlag = false) {
+      bool setNoCowFlag = false,
+      int64_t checkpointIntervalBytes = 0,
+      bool checksumEnabled = false) {
     // tmpfs does not support O_DIRECT, so turn this off for testing.
     FLAGS_ssd_odirect = false;
     cache_ = std::make_shared<AsyncDataCache>(
@@ -59,12 +63,23 @@ class SsdFileTest : public testing::Test {
     fileName_ = StringIdLease(fileIds(), "fileInStorage");
 
     tempDirectory_ = exec::test::TempDirectoryPath::create();
+    ssdBytes_ = ssdBytes;
+    checkpointIntervalBytes_ = checkpointIntervalBytes;
+    checksumEnabled_ = checksumEnabled;
+    openFile(setNoCowFlag);
+  }
+
+  // Opens the SsdFile of 'tempDirectory_'. Recovers from the checkpoint and
+  // log of a previously opened file if checkpointing is on.
+  void openFile(bool setNoCowFlag = false) {
     ssdFile_ = std::make_unique<SsdFile>(
         fmt::format("{}/ssdtest", tempDirectory_->path),
         0, // shardId
-        bits::roundUp(ssdBytes, SsdFile::kRegionSize) / SsdFile::kRegionSize,
-        0, // checkpointInternalBytes
-        setNoCowFlag);
+        bits::roundUp(ssdBytes_, SsdFile::kRegionSize) / SsdFile::kRegionSize,
+        checkpointIntervalBytes_,
+        setNoCowFlag,
+        nullptr,
+        checksumEnabled_);
   }
 
   static void initializeContents(int64_t sequence, memory::Allocation& alloc) {
@@ -223,6 +238,9 @@ class SsdFileTest : public testing::Test {
   }
 
   std::shared_ptr<exec::test::TempDirectoryPath> tempDirectory_;
+  int64_t ssdBytes_{0};
+  int64_t checkpointIntervalBytes_{0};
+  bool checksumEnabled_{false};
 
   std::shared_ptr<AsyncDataCache> cache_;
   StringIdLease fileName_;
@@ -297,6 +315,83 @@ TEST_F(SsdFileTest, writeAndRead) {
   }
 }
 
+TEST_F(SsdFileTest, recoverFromCheckpointAndLog) {
+  constexpr int64_t kSsdSize = 4 * SsdFile::kRegionSize;
+  // No checkpoint is made unless forced.
+  initializeCache(128 * kMB, kSsdSize, false, 1L << 40, true);
+  std::vector<TestEntry> allEntries;
+  for (auto batch = 0; batch < 2; ++batch) {
+    auto pins = makePins(
+        fileName_.id(),
+        batch * SsdFile::kRegionSize,
+        4096,
+        2048 * 1025,
+        62 * kMB);
+    ssdFile_->write(pins);
+    for (auto& pin : pins) {
+      ASSERT_EQ(ssdFile_.get(), pin.entry()->ssdFile());
+      allEntries.emplace_back(
+          pin.entry()->key(), pin.entry()->ssdOffset(), pin.entry()->size());
+    }
+    if (batch == 0) {
+      // The first batch is in the checkpoint, the second only in the log.
+      ssdFile_->checkpoint(true);
+    }
+  }
+  // The second batch is less than a region and is logged once synced.
+  ssdFile_->syncWrites(true);
+
+  // Restart with an empty memory cache.
+  cache_ = std::make_shared<AsyncDataCache>(
+      MemoryAllocator::createDefaultInstance(), 128 * kMB);
+  openFile();
+  SsdCacheStats stats;
+  ssdFile_->updateStats(stats);
+  EXPECT_EQ(allEntries.size(), stats.entriesRecovered);
+  for (auto& entry : allEntries) {
+    auto ssdPin =
+        ssdFile_->find(RawFileCacheKey{fileName_.id(), entry.key.offset});
+    ASSERT_FALSE(ssdPin.empty());
+    EXPECT_EQ(entry.ssdOffset, ssdPin.run().offset());
+    EXPECT_TRUE(ssdFile_->testingNeedsVerify(
+        RawFileCacheKey{fileName_.id(), entry.key.offset}));
+  }
+
+  // Corrupt the first entry of the second batch on SSD.
+  const auto& corrupt = allEntries[allEntries.size() / 2];
+  ASSERT_EQ(SsdFile::kRegionSize, corrupt.key.offset);
+  auto fd = ::open(
+      fmt::format("{}/ssdtest", tempDirectory_->path).c_str(), O_WRONLY);
+  ASSERT_LE(0, fd);
+  const char garbage = 0x55;
+  ASSERT_EQ(1, ::pwrite(fd, &garbage, 1, corrupt.ssdOffset + 100));
+  ::close(fd);
+
+  // The first batch reads back correctly and is verified.
+  auto pins = makePins(fileName_.id(), 0, 4096, 2048 * 1025, 62 * kMB);
+  readAndCheckPins(pins);
+  EXPECT_FALSE(
+      ssdFile_->testingNeedsVerify(RawFileCacheKey{fileName_.id(), 0}));
+  pins.clear();
+
+  // The corrupt entry fails to load and is dropped.
+  pins.push_back(cache_->findOrCreate(
+      RawFileCacheKey{fileName_.id(), corrupt.key.offset},
+      corrupt.size,
+      nullptr));
+  std::vector<SsdPin> ssdPins;
+  ssdPins.push_back(
+      ssdFile_->find(RawFileCacheKey{fileName_.id(), corrupt.key.offset}));
+  VELOX_ASSERT_THROW(
+      ssdFile_->load(ssdPins, pins), "do not match their checksum");
+  EXPECT_TRUE(
+      ssdFile_->find(RawFileCacheKey{fileName_.id(), corrupt.key.offset})
+          .empty());
+  stats = SsdCacheStats();
+  ssdFile_->updateStats(stats);
+  EXPECT_EQ(1, stats.readChecksumErrors);
+}
+
 #ifdef VELOX_SSD_FILE_TEST_SET_NO_COW_FLAG
 TEST_F(SsdFileTest, disabledCow) {
   constexpr int64_t kSsdSize = 16 * SsdFile::kRegionSize;
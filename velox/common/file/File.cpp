@@ -16,6 +16,7 @@
 
 #include "velox/common/file/File.h"
 #include "velox/common/base/Fs.h"
+#include "velox/common/file/IoUringReader.h"
 
 #include <fmt/format.h>
 #include <glog/logging.h>
@@ -87,7 +88,8 @@ uint64_t InMemoryWriteFile::size() const {
   return file_->size();
 }
 
-LocalReadFile::LocalReadFile(std::string_view path) : path_(path) {
+LocalReadFile::LocalReadFile(std::string_view path, bool useIoUring)
+    : path_(path), useIoUring_(useIoUring && IoUringReader::available()) {
   fd_ = open(path_.c_str(), O_RDONLY);
   VELOX_CHECK_GE(
       fd_,
@@ -158,6 +160,15 @@ uint64_t LocalReadFile::preadv(
   return folly::preadv(fd_, iovecs.data(), iovecs.size(), offset);
 }
 
+folly::SemiFuture<uint64_t> LocalReadFile::preadvAsync(
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers) const {
+  if (!useIoUring_) {
+    return ReadFile::preadvAsync(offset, buffers);
+  }
+  return IoUringReader::instance().preadv(fd_, offset, buffers);
+}
+
 uint64_t LocalReadFile::size() const {
   return size_;
 }
@@ -225,7 +225,10 @@ class InMemoryWriteFile final : public WriteFile {
 
 class LocalReadFile final : public ReadFile {
  public:
-  explicit LocalReadFile(std::string_view path);
+  // If 'useIoUring' is true and io_uring is available, preadvAsync() is
+  // served by the process wide IoUringReader instead of running preadv() on
+  // the calling thread.
+  explicit LocalReadFile(std::string_view path, bool useIoUring = false);
 
   explicit LocalReadFile(int32_t fd);
 
@@ -240,6 +243,15 @@ class LocalReadFile final : public ReadFile {
       uint64_t offset,
       const std::vector<folly::Range<char*>>& buffers) const final;
 
+  // With io_uring, 'this' must stay alive until the returned future completes.
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const final;
+
+  bool hasPreadvAsync() const final {
+    return useIoUring_;
+  }
+
   uint64_t memoryUsage() const final;
 
   bool shouldCoalesce() const final {
@@ -264,6 +276,7 @@ class LocalReadFile final : public ReadFile {
   std::string path_;
   int32_t fd_;
   long size_;
+  bool useIoUring_{false};
 };
 
 class LocalWriteFile final : public WriteFile {
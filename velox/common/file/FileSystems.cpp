@@ -68,8 +68,8 @@ folly::once_flag localFSInstantiationFlag;
 // Implement Local FileSystem.
 class LocalFileSystem : public FileSystem {
  public:
-  explicit LocalFileSystem(std::shared_ptr<const Config> config)
-      : FileSystem(config) {}
+  LocalFileSystem(std::shared_ptr<const Config> config, bool useIoUring)
+      : FileSystem(config), useIoUring_(useIoUring) {}
 
   ~LocalFileSystem() override {}
 
@@ -87,7 +87,7 @@ class LocalFileSystem : public FileSystem {
   std::unique_ptr<ReadFile> openFileForRead(
       std::string_view path,
       const FileOptions& /*unused*/) override {
-    return std::make_unique<LocalReadFile>(extractPath(path));
+    return std::make_unique<LocalReadFile>(extractPath(path), useIoUring_);
   }
 
   std::unique_ptr<WriteFile> openFileForWrite(
@@ -179,23 +179,28 @@ class LocalFileSystem : public FileSystem {
 
   static std::function<std::shared_ptr<
       FileSystem>(std::shared_ptr<const Config>, std::string_view)>
-  fileSystemGenerator() {
-    return [](std::shared_ptr<const Config> properties,
-              std::string_view filePath) {
+  fileSystemGenerator(bool useIoUring) {
+    return [useIoUring](
+               std::shared_ptr<const Config> properties,
+               std::string_view filePath) {
       // One instance of Local FileSystem is sufficient.
       // Initialize on first access and reuse after that.
       static std::shared_ptr<FileSystem> lfs;
-      folly::call_once(localFSInstantiationFlag, [&properties]() {
-        lfs = std::make_shared<LocalFileSystem>(properties);
+      folly::call_once(localFSInstantiationFlag, [&properties, useIoUring]() {
+        lfs = std::make_shared<LocalFileSystem>(properties, useIoUring);
       });
       return lfs;
     };
   }
+
+ private:
+  const bool useIoUring_;
 };
 } // namespace
 
-void registerLocalFileSystem() {
+void registerLocalFileSystem(bool useIoUring) {
   registerFileSystem(
-      LocalFileSystem::schemeMatcher(), LocalFileSystem::fileSystemGenerator());
+      LocalFileSystem::schemeMatcher(),
+      LocalFileSystem::fileSystemGenerator(useIoUring));
 }
 } // namespace facebook::velox::filesystems
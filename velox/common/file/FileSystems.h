@@ -101,7 +101,10 @@ void registerFileSystem(
         std::shared_ptr<const Config>,
         std::string_view)> fileSystemGenerator);
 
-/// Register the local filesystem.
-void registerLocalFileSystem();
+/// Register the local filesystem. If 'useIoUring' is true, files opened for
+/// read implement preadvAsync() with io_uring when Velox is built with
+/// VELOX_ENABLE_IO_URING and the kernel supports it. The setting of the
+/// registration that first instantiates the local filesystem is used.
+void registerLocalFileSystem(bool useIoUring = false);
 
 } // namespace facebook::velox::filesystems
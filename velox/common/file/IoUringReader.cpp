@@ -0,0 +1,347 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/file/IoUringReader.h"
+#include "velox/common/base/Exceptions.h"
+
+#include <glog/logging.h>
+
+#ifdef VELOX_ENABLE_IO_URING
+#include <folly/String.h>
+#include <liburing.h>
+#include <sys/uio.h>
+
+#include <climits>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
+namespace facebook::velox {
+
+#ifdef VELOX_ENABLE_IO_URING
+
+namespace {
+
+// Size of the shared sink for skipped ranges. The content is never looked at,
+// so concurrent reads may overwrite it.
+constexpr size_t kDroppedBytesSize = 16 * 1024;
+
+// Maximum number of iovecs in one readv entry.
+constexpr size_t kMaxIovecsPerEntry = IOV_MAX;
+
+struct Read;
+
+// The iovecs [begin, end) of 'read' that are read with one submission queue
+// entry starting at 'offset'.
+struct Chunk {
+  Read* read;
+  uint64_t offset;
+  size_t begin;
+  size_t end;
+};
+
+struct Read {
+  int32_t fd;
+  std::vector<iovec> iovecs;
+  std::vector<Chunk> chunks;
+  uint64_t numRead{0};
+  // Number of chunks not yet completed. Only accessed by the polling thread
+  // after submission.
+  int32_t numPending{0};
+  std::string error;
+  folly::Promise<uint64_t> promise;
+};
+
+} // namespace
+
+class IoUringReader::Impl {
+ public:
+  Impl() : droppedBytes_(kDroppedBytesSize) {
+    const auto rc = io_uring_queue_init(kQueueDepth, &ring_, 0);
+    VELOX_CHECK_EQ(
+        rc, 0, "io_uring_queue_init failed: {}", folly::errnoStr(-rc));
+    poller_ = std::thread([this]() { poll(); });
+  }
+
+  ~Impl() {
+    {
+      // A nop with no Chunk stops the polling thread.
+      std::lock_guard<std::mutex> l(mutex_);
+      auto* sqe = getSqeLocked();
+      io_uring_prep_nop(sqe);
+      io_uring_sqe_set_data(sqe, nullptr);
+      submitLocked();
+    }
+    poller_.join();
+    io_uring_queue_exit(&ring_);
+  }
+
+  folly::SemiFuture<uint64_t> preadv(
+      int32_t fd,
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) {
+    auto read = std::make_unique<Read>();
+    read->fd = fd;
+    read->iovecs.reserve(buffers.size());
+    for (auto& range : buffers) {
+      if (!range.data()) {
+        auto skipSize = range.size();
+        while (skipSize) {
+          auto bytes = std::min<size_t>(droppedBytes_.size(), skipSize);
+          read->iovecs.push_back({droppedBytes_.data(), bytes});
+          skipSize -= bytes;
+        }
+      } else if (!range.empty()) {
+        read->iovecs.push_back({range.data(), range.size()});
+      }
+    }
+    if (read->iovecs.empty()) {
+      return folly::makeSemiFuture<uint64_t>(0);
+    }
+    auto chunkOffset = offset;
+    for (size_t begin = 0; begin < read->iovecs.size();
+         begin += kMaxIovecsPerEntry) {
+      const auto end =
+          std::min<size_t>(begin + kMaxIovecsPerEntry, read->iovecs.size());
+      read->chunks.push_back({read.get(), chunkOffset, begin, end});
+      for (auto i = begin; i < end; ++i) {
+        chunkOffset += read->iovecs[i].iov_len;
+      }
+    }
+    const int32_t numChunks = read->chunks.size();
+    read->numPending = numChunks;
+    auto future = read->promise.getSemiFuture();
+
+    std::unique_lock<std::mutex> l(mutex_);
+    inFlightCv_.wait(l, [&]() {
+      return numInFlight_ == 0 || numInFlight_ + numChunks <= kQueueDepth;
+    });
+    numInFlight_ += numChunks;
+    // The polling thread owns 'read' from here on and deletes it after the
+    // last chunk completes.
+    auto* rawRead = read.release();
+    for (auto& chunk : rawRead->chunks) {
+      prepareLocked(&chunk);
+    }
+    submitLocked();
+    return future;
+  }
+
+ private:
+  io_uring_sqe* getSqeLocked() {
+    auto* sqe = io_uring_get_sqe(&ring_);
+    if (!sqe) {
+      // The submission queue is full. Hand it to the kernel and retry.
+      submitLocked();
+      sqe = io_uring_get_sqe(&ring_);
+    }
+    VELOX_CHECK_NOT_NULL(sqe);
+    return sqe;
+  }
+
+  void prepareLocked(Chunk* chunk) {
+    auto* sqe = getSqeLocked();
+    io_uring_prep_readv(
+        sqe,
+        chunk->read->fd,
+        &chunk->read->iovecs[chunk->begin],
+        chunk->end - chunk->begin,
+        chunk->offset);
+    io_uring_sqe_set_data(sqe, chunk);
+  }
+
+  void submitLocked() {
+    for (;;) {
+      const auto rc = io_uring_submit(&ring_);
+      if (rc >= 0) {
+        return;
+      }
+      if (rc != -EINTR && rc != -EAGAIN && rc != -EBUSY) {
+        // Prepared entries point to reads that are owned by the ring. They
+        // cannot be taken back, so there is no way to recover.
+        LOG(FATAL) << "io_uring_submit failed: " << folly::errnoStr(-rc);
+      }
+      std::this_thread::yield();
+    }
+  }
+
+  // Processes the completion of 'chunk' with 'result'. Returns true if the
+  // chunk was partially read and must be submitted again for the rest. A
+  // result of 0 means end of file and completes the chunk short, like
+  // preadv().
+  bool complete(Chunk* chunk, int32_t result) {
+    auto* read = chunk->read;
+    if (result == -EINTR || result == -EAGAIN) {
+      return true;
+    }
+    if (result < 0) {
+      read->error = folly::errnoStr(-result);
+    } else if (result > 0) {
+      read->numRead += result;
+      chunk->offset += result;
+      uint64_t remaining = result;
+      auto& iovecs = read->iovecs;
+      while (chunk->begin < chunk->end &&
+             remaining >= iovecs[chunk->begin].iov_len) {
+        remaining -= iovecs[chunk->begin].iov_len;
+        ++chunk->begin;
+      }
+      if (chunk->begin < chunk->end) {
+        auto& iov = iovecs[chunk->begin];
+        iov.iov_base = static_cast<char*>(iov.iov_base) + remaining;
+        iov.iov_len -= remaining;
+        return true;
+      }
+    }
+    if (--read->numPending == 0) {
+      finish(std::unique_ptr<Read>(read));
+    }
+    return false;
+  }
+
+  static void finish(std::unique_ptr<Read> read) {
+    if (read->error.empty()) {
+      read->promise.setValue(read->numRead);
+      return;
+    }
+    try {
+      VELOX_FAIL("io_uring read failure on fd {}: {}", read->fd, read->error);
+    } catch (const std::exception&) {
+      read->promise.setException(
+          folly::exception_wrapper(std::current_exception()));
+    }
+  }
+
+  void poll() {
+    io_uring_cqe* cqes[kCompletionBatch];
+    std::vector<Chunk*> retries;
+    for (;;) {
+      io_uring_cqe* cqe;
+      const auto rc = io_uring_wait_cqe(&ring_, &cqe);
+      if (rc == -EINTR || rc == -EAGAIN) {
+        continue;
+      }
+      if (rc < 0) {
+        LOG(FATAL) << "io_uring_wait_cqe failed: " << folly::errnoStr(-rc);
+      }
+      const auto numCqes =
+          io_uring_peek_batch_cqe(&ring_, cqes, kCompletionBatch);
+      bool stop = false;
+      int32_t numFinished = 0;
+      retries.clear();
+      for (unsigned i = 0; i < numCqes; ++i) {
+        auto* chunk = static_cast<Chunk*>(io_uring_cqe_get_data(cqes[i]));
+        if (!chunk) {
+          stop = true;
+        } else if (complete(chunk, cqes[i]->res)) {
+          retries.push_back(chunk);
+        } else {
+          ++numFinished;
+        }
+      }
+      io_uring_cq_advance(&ring_, numCqes);
+      if (!retries.empty() || numFinished > 0) {
+        std::lock_guard<std::mutex> l(mutex_);
+        for (auto* chunk : retries) {
+          prepareLocked(chunk);
+        }
+        if (!retries.empty()) {
+          submitLocked();
+        }
+        numInFlight_ -= numFinished;
+      }
+      if (numFinished > 0) {
+        inFlightCv_.notify_all();
+      }
+      if (stop) {
+        return;
+      }
+    }
+  }
+
+  io_uring ring_;
+  std::vector<char> droppedBytes_;
+  std::thread poller_;
+
+  // Serializes use of the submission queue. The completion queue is only
+  // accessed by 'poller_'.
+  std::mutex mutex_;
+  std::condition_variable inFlightCv_;
+  int32_t numInFlight_{0};
+};
+
+IoUringReader::IoUringReader() : impl_(std::make_unique<Impl>()) {}
+
+folly::SemiFuture<uint64_t> IoUringReader::preadv(
+    int32_t fd,
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers) {
+  return impl_->preadv(fd, offset, buffers);
+}
+
+// static
+IoUringReader* IoUringReader::create() {
+  try {
+    return new IoUringReader();
+  } catch (const std::exception& e) {
+    LOG(WARNING) << "io_uring is not available: " << e.what();
+    return nullptr;
+  }
+}
+
+#else
+
+class IoUringReader::Impl {};
+
+IoUringReader::IoUringReader() {}
+
+folly::SemiFuture<uint64_t> IoUringReader::preadv(
+    int32_t /*fd*/,
+    uint64_t /*offset*/,
+    const std::vector<folly::Range<char*>>& /*buffers*/) {
+  VELOX_UNSUPPORTED("Velox is built without VELOX_ENABLE_IO_URING");
+}
+
+// static
+IoUringReader* IoUringReader::create() {
+  return nullptr;
+}
+
+#endif
+
+IoUringReader::~IoUringReader() = default;
+
+// static
+IoUringReader* IoUringReader::singleton() {
+  // Never deleted so that reads in flight at exit do not race with teardown.
+  static IoUringReader* reader = create();
+  return reader;
+}
+
+// static
+bool IoUringReader::available() {
+  return singleton() != nullptr;
+}
+
+// static
+IoUringReader& IoUringReader::instance() {
+  auto* reader = singleton();
+  VELOX_CHECK_NOT_NULL(reader, "io_uring is not available");
+  return *reader;
+}
+
+} // namespace facebook::velox
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/Range.h>
+#include <folly/futures/Future.h>
+
+#include <memory>
+#include <vector>
+
+namespace facebook::velox {
+
+// Process wide io_uring instance for asynchronous reads of local files. Reads
+// are split into readv submission queue entries, all entries of a read are
+// submitted with a single system call and a dedicated thread polls the
+// completion queue in batches and fulfills the futures. This way a read does
+// not occupy an executor thread while the device works.
+//
+// io_uring is used only if Velox is built with VELOX_ENABLE_IO_URING and the
+// kernel allows setting up a ring. Otherwise available() is false.
+class IoUringReader {
+ public:
+  // Maximum number of submission queue entries in flight. Submitters block
+  // while this many are pending.
+  static constexpr int32_t kQueueDepth = 256;
+
+  // Maximum number of completions reaped per wakeup of the polling thread.
+  static constexpr int32_t kCompletionBatch = 64;
+
+  // Returns true if the process wide reader is usable.
+  static bool available();
+
+  // Returns the process wide reader. Throws if !available().
+  static IoUringReader& instance();
+
+  ~IoUringReader();
+
+  // Reads consecutive bytes of 'fd' starting at 'offset' into 'buffers'. A
+  // range with nullptr data skips its size in bytes. The future is fulfilled
+  // with the number of bytes read on a thread of 'this', or with an exception
+  // if the read fails. Like preadv(), the count is short if the file ends
+  // before 'buffers'. 'fd' and the memory behind 'buffers' must stay valid
+  // until the future completes.
+  folly::SemiFuture<uint64_t> preadv(
+      int32_t fd,
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers);
+
+ private:
+  class Impl;
+
+  IoUringReader();
+
+  // Returns the process wide reader or nullptr if io_uring cannot be used.
+  static IoUringReader* singleton();
+
+  // Makes a reader or returns nullptr if io_uring cannot be used.
+  static IoUringReader* create();
+
+  std::unique_ptr<Impl> impl_;
+};
+
+} // namespace facebook::velox
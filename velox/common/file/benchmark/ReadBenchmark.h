@@ -38,6 +38,7 @@ DECLARE_int64(file_size_gb);
 DECLARE_int32(num_threads);
 DECLARE_int32(seed);
 DECLARE_bool(odirect);
+DECLARE_bool(io_uring);
 DECLARE_int32(bytes);
 DECLARE_int32(gap);
 DECLARE_int32(num_in_run);
@@ -46,7 +47,7 @@ DECLARE_int32(measurement_size);
 
 namespace facebook::velox {
 
-enum class Mode { Pread = 0, Preadv = 1, Multiple = 2 };
+enum class Mode { Pread = 0, Preadv = 1, Multiple = 2, PreadvAsync = 3 };
 
 // Struct to read data into. If we read contiguous and then copy to
 // non-contiguous buffers, we read to 'buffer' and copy to
@@ -84,10 +85,13 @@ class ReadBenchmark {
       readFile_ = std::make_unique<LocalReadFile>(fd_);
 
     } else {
-      filesystems::registerLocalFileSystem();
+      filesystems::registerLocalFileSystem(FLAGS_io_uring);
       auto lfs = filesystems::getFileSystem(FLAGS_path, nullptr);
       readFile_ = lfs->openFileForRead(FLAGS_path);
     }
+    if (FLAGS_io_uring && !readFile_->hasPreadvAsync()) {
+      LOG(WARNING) << "io_uring is not available, skipping preadvAsync";
+    }
     fileSize_ = readFile_->size();
     if (FLAGS_file_size_gb) {
       fileSize_ = std::min<uint64_t>(FLAGS_file_size_gb << 30, fileSize_);
@@ -152,7 +156,7 @@ class ReadBenchmark {
       globalScratch.bufferCopy.resize(rangeSize);
       for (auto repeat = 0; repeat < repeats; ++repeat) {
         std::unique_ptr<folly::Promise<bool>> promise;
-        if (parallel) {
+        if (parallel && mode != Mode::PreadvAsync) {
           auto [tempPromise, future] = folly::makePromiseContract<bool>();
           promise = std::make_unique<folly::Promise<bool>>();
           *promise = std::move(tempPromise);
@@ -256,6 +260,28 @@ class ReadBenchmark {
             }
             break;
           }
+          case Mode::PreadvAsync: {
+            label = "1 preadvAsync";
+            // Reads are issued from this thread. With 'parallel', all reads
+            // are in flight at the same time without occupying executor
+            // threads.
+            std::vector<folly::Range<char*>> ranges;
+            for (auto start = 0; start < rangeSize; start += size + gap) {
+              ranges.push_back(folly::Range<char*>(
+                  globalScratch.buffer.data() + start, size));
+              if (gap && start + gap < rangeSize) {
+                ranges.push_back(folly::Range<char*>(nullptr, gap));
+              }
+            }
+            auto future = readFile_->preadvAsync(offset, ranges);
+            if (parallel) {
+              futures.push_back(
+                  std::move(future).deferValue([](uint64_t) { return true; }));
+            } else {
+              std::move(future).get();
+            }
+            break;
+          }
         }
       }
       if (parallel) {
@@ -289,6 +315,10 @@ class ReadBenchmark {
     randomReads(size, gap, count, repeats, Mode::Pread, true);
     randomReads(size, gap, count, repeats, Mode::Preadv, true);
     randomReads(size, gap, count, repeats, Mode::Multiple, true);
+    if (readFile_->hasPreadvAsync()) {
+      randomReads(size, gap, count, repeats, Mode::PreadvAsync, false);
+      randomReads(size, gap, count, repeats, Mode::PreadvAsync, true);
+    }
   }
 
   void run();
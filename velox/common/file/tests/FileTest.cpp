@@ -18,6 +18,7 @@
 
 #include "velox/common/file/File.h"
 #include "velox/common/file/FileSystems.h"
+#include "velox/common/file/IoUringReader.h"
 #include "velox/exec/tests/utils/TempDirectoryPath.h"
 #include "velox/exec/tests/utils/TempFilePath.h"
 
@@ -62,13 +63,13 @@ void readData(ReadFile* readFile, bool checkFileSize = true) {
   char head[12];
   char middle[4];
   char tail[7];
+  const uint64_t gapSize =
+      15 + kOneMB - 500000 - sizeof(head) - sizeof(middle) - sizeof(tail);
   std::vector<folly::Range<char*>> buffers = {
       folly::Range<char*>(head, sizeof(head)),
       folly::Range<char*>(nullptr, (char*)(uint64_t)500000),
       folly::Range<char*>(middle, sizeof(middle)),
-      folly::Range<char*>(
-          nullptr,
-          (char*)(uint64_t)(15 + kOneMB - 500000 - sizeof(head) - sizeof(middle) - sizeof(tail))),
+      folly::Range<char*>(nullptr, (char*)gapSize),
       folly::Range<char*>(tail, sizeof(tail))};
   ASSERT_EQ(15 + kOneMB, readFile->preadv(0, buffers));
   ASSERT_EQ(std::string_view(head, sizeof(head)), "aaaaabbbbbcc");
@@ -126,6 +127,63 @@ TEST(LocalFile, writeAndRead) {
   readData(&readFile);
 }
 
+TEST(LocalFile, preadvAsync) {
+  auto tempFile = ::exec::test::TempFilePath::create();
+  const auto& filename = tempFile->path.c_str();
+  remove(filename);
+  {
+    LocalWriteFile writeFile(filename);
+    writeData(&writeFile);
+  }
+  // Without io_uring support the reads fall back to synchronous preadv.
+  LocalReadFile readFile(filename, true);
+#ifdef VELOX_ENABLE_IO_URING
+  ASSERT_EQ(readFile.hasPreadvAsync(), IoUringReader::available());
+#else
+  ASSERT_FALSE(readFile.hasPreadvAsync());
+#endif
+  readData(&readFile);
+  char head[12];
+  char middle[4];
+  char tail[7];
+  const uint64_t gapSize =
+      15 + kOneMB - 500000 - sizeof(head) - sizeof(middle) - sizeof(tail);
+  std::vector<folly::Range<char*>> buffers = {
+      folly::Range<char*>(head, sizeof(head)),
+      folly::Range<char*>(nullptr, (char*)(uint64_t)500000),
+      folly::Range<char*>(middle, sizeof(middle)),
+      folly::Range<char*>(nullptr, (char*)gapSize),
+      folly::Range<char*>(tail, sizeof(tail))};
+  ASSERT_EQ(15 + kOneMB, readFile.preadvAsync(0, buffers).get());
+  ASSERT_EQ(std::string_view(head, sizeof(head)), "aaaaabbbbbcc");
+  ASSERT_EQ(std::string_view(middle, sizeof(middle)), "cccc");
+  ASSERT_EQ(std::string_view(tail, sizeof(tail)), "ccddddd");
+
+  // Many reads in flight at the same time.
+  std::vector<std::string> results(100, std::string(5, ' '));
+  std::vector<folly::SemiFuture<uint64_t>> futures;
+  for (auto& result : results) {
+    futures.push_back(readFile.preadvAsync(
+        10 + kOneMB, {folly::Range<char*>(result.data(), result.size())}));
+  }
+  for (auto& future : futures) {
+    ASSERT_EQ(5, std::move(future).get());
+  }
+  for (auto& result : results) {
+    ASSERT_EQ("ddddd", result);
+  }
+
+  // A read past the end returns the bytes up to the end.
+  char pastEnd[10];
+  ASSERT_EQ(
+      5,
+      readFile
+          .preadvAsync(
+              10 + kOneMB, {folly::Range<char*>(pastEnd, sizeof(pastEnd))})
+          .get());
+  ASSERT_EQ(std::string_view(pastEnd, 5), "ddddd");
+}
+
 TEST(LocalFile, viaRegistry) {
   filesystems::registerLocalFileSystem();
   auto tempFile = ::exec::test::TempFilePath::create();
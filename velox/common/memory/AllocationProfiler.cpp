@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/memory/AllocationProfiler.h"
+
+#include <folly/FileUtil.h>
+#include <folly/Random.h>
+#include <folly/hash/Hash.h>
+
+#include <cmath>
+#include <sstream>
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/base/SuccinctPrinter.h"
+#include "velox/common/memory/MemoryPool.h"
+#include "velox/common/process/StackTrace.h"
+
+namespace facebook::velox::memory {
+namespace {
+// The number of innermost frames printed per allocation site by toString().
+constexpr int32_t kMaxPrintedFrames = 12;
+} // namespace
+
+AllocationProfiler::AllocationProfiler(uint64_t sampleIntervalBytes)
+    : sampleIntervalBytes_(sampleIntervalBytes) {
+  VELOX_CHECK_GT(sampleIntervalBytes_, 0);
+}
+
+size_t AllocationProfiler::StackHasher::operator()(
+    const std::vector<void*>& stack) const {
+  return folly::hash::hash_range(stack.begin(), stack.end());
+}
+
+int64_t AllocationProfiler::nextSampleInterval() const {
+  // Exponentially distributed with mean 'sampleIntervalBytes_' so that every
+  // allocated byte is equally likely to trigger a sample.
+  const double uniform = 1.0 - folly::Random::randDouble01();
+  return std::max<int64_t>(1, -std::log(uniform) * sampleIntervalBytes_);
+}
+
+void AllocationProfiler::sample(const MemoryPool& pool, uint64_t bytes) {
+  // Skips the frame of this function.
+  process::StackTrace stackTrace(1);
+  // An allocation of 'bytes' is sampled with probability 1 - e^(-bytes /
+  // interval). Each sample stands for the inverse of that many allocations.
+  const double probability =
+      1 - std::exp(-static_cast<double>(bytes) / sampleIntervalBytes_);
+  std::lock_guard<std::mutex> l(mutex_);
+  auto& site = sites_[pool.name()][stackTrace.getStack()];
+  ++site.numSamples;
+  site.sampledBytes += bytes;
+  site.estimatedBytes += bytes / probability;
+}
+
+std::vector<AllocationProfiler::PoolStats> AllocationProfiler::poolStats()
+    const {
+  std::vector<PoolStats> stats;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    stats.reserve(sites_.size());
+    for (const auto& [pool, sites] : sites_) {
+      PoolStats poolStats{pool};
+      double estimatedBytes{0};
+      for (const auto& [stack, site] : sites) {
+        poolStats.numSamples += site.numSamples;
+        poolStats.sampledBytes += site.sampledBytes;
+        estimatedBytes += site.estimatedBytes;
+      }
+      poolStats.estimatedBytes = estimatedBytes;
+      stats.push_back(std::move(poolStats));
+    }
+  }
+  std::sort(stats.begin(), stats.end(), [](const auto& lhs, const auto& rhs) {
+    return lhs.estimatedBytes > rhs.estimatedBytes;
+  });
+  return stats;
+}
+
+std::string AllocationProfiler::toString(int32_t maxSites) const {
+  struct Site {
+    std::string pool;
+    std::vector<void*> stack;
+    double estimatedBytes;
+  };
+  std::vector<Site> topSites;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    for (const auto& [pool, sites] : sites_) {
+      for (const auto& [stack, site] : sites) {
+        topSites.push_back({pool, stack, site.estimatedBytes});
+      }
+    }
+  }
+  std::sort(
+      topSites.begin(), topSites.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.estimatedBytes > rhs.estimatedBytes;
+      });
+  if (topSites.size() > static_cast<size_t>(maxSites)) {
+    topSites.resize(maxSites);
+  }
+
+  std::stringstream out;
+  out << "Allocations sampled every " << succinctBytes(sampleIntervalBytes_)
+      << ":\n";
+  for (const auto& stats : poolStats()) {
+    out << "    " << stats.pool << " estimated "
+        << succinctBytes(stats.estimatedBytes) << " from "
+        << stats.numSamples << " samples\n";
+  }
+  out << "Top " << topSites.size() << " allocation sites:\n";
+  for (const auto& site : topSites) {
+    out << "    " << site.pool << " estimated "
+        << succinctBytes(site.estimatedBytes) << "\n";
+    const auto numFrames =
+        std::min<size_t>(site.stack.size(), kMaxPrintedFrames);
+    for (size_t i = 0; i < numFrames; ++i) {
+      out << "        # " << i << " "
+          << process::StackTrace::translateFrame(site.stack[i], false) << "\n";
+    }
+  }
+  return out.str();
+}
+
+std::string AllocationProfiler::toPprof() const {
+  // Merges the call stacks of all memory pools.
+  SiteMap stacks;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    for (const auto& [pool, sites] : sites_) {
+      for (const auto& [stack, site] : sites) {
+        auto& merged = stacks[stack];
+        merged.numSamples += site.numSamples;
+        merged.sampledBytes += site.sampledBytes;
+      }
+    }
+  }
+  uint64_t numSamples{0};
+  uint64_t sampledBytes{0};
+  for (const auto& [stack, site] : stacks) {
+    numSamples += site.numSamples;
+    sampledBytes += site.sampledBytes;
+  }
+
+  // pprof scales the sampled counts back up from the interval in the header.
+  // Frees are not tracked, so the in-use columns repeat the allocated ones.
+  std::stringstream out;
+  out << fmt::format(
+      "heap profile: {}: {} [{}: {}] @ heap_v2/{}\n",
+      numSamples,
+      sampledBytes,
+      numSamples,
+      sampledBytes,
+      sampleIntervalBytes_);
+  for (const auto& [stack, site] : stacks) {
+    out << fmt::format(
+        "{}: {} [{}: {}] @",
+        site.numSamples,
+        site.sampledBytes,
+        site.numSamples,
+        site.sampledBytes);
+    for (const auto* frame : stack) {
+      out << fmt::format(" {}", fmt::ptr(frame));
+    }
+    out << "\n";
+  }
+  // The address mappings let pprof symbolize the stacks.
+  std::string maps;
+  folly::readFile("/proc/self/maps", maps);
+  out << "\nMAPPED_LIBRARIES:\n" << maps;
+  return out.str();
+}
+
+void AllocationProfiler::clear() {
+  std::lock_guard<std::mutex> l(mutex_);
+  sites_.clear();
+}
+
+} // namespace facebook::velox::memory
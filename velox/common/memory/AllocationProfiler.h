@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/CPortability.h>
+#include <folly/Likely.h>
+#include <folly/ThreadLocal.h>
+#include <folly/container/F14Map.h>
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace facebook::velox::memory {
+
+class MemoryPool;
+
+/// Samples the allocations made from the memory pools it is attached to and
+/// aggregates the call stacks of the sampled ones per memory pool, which for
+/// the operator pools of a task means per operator. Sampling is by bytes as in
+/// jemalloc's prof: each thread counts down a random number of allocated bytes
+/// with mean 'sampleIntervalBytes' and the allocation that crosses zero is
+/// sampled. The countdown is per profiler and thread. Large allocations are
+/// thus sampled proportionally more often and an allocation that is not
+/// sampled costs a thread local lookup, a subtraction and a branch. Thread
+/// safe.
+///
+/// NOTE: frees are not tracked. The profile shows where the memory was
+/// allocated, not what is still held.
+class AllocationProfiler {
+ public:
+  explicit AllocationProfiler(uint64_t sampleIntervalBytes);
+
+  uint64_t sampleIntervalBytes() const {
+    return sampleIntervalBytes_;
+  }
+
+  /// Invoked on each allocation of 'bytes' from 'pool'.
+  FOLLY_ALWAYS_INLINE void recordAllocation(
+      const MemoryPool& pool,
+      uint64_t bytes) {
+    auto& bytesUntilSample = *bytesUntilSample_;
+    bytesUntilSample -= bytes;
+    if (FOLLY_LIKELY(bytesUntilSample > 0)) {
+      return;
+    }
+    bytesUntilSample = nextSampleInterval();
+    sample(pool, bytes);
+  }
+
+  /// The sampled allocations of one memory pool.
+  struct PoolStats {
+    std::string pool;
+    uint64_t numSamples{0};
+    uint64_t sampledBytes{0};
+    /// The estimate of all the bytes allocated from 'pool', sampled or not.
+    uint64_t estimatedBytes{0};
+  };
+
+  /// Returns the stats of the memory pools with sampled allocations, the one
+  /// with the most estimated bytes first.
+  std::vector<PoolStats> poolStats() const;
+
+  /// Returns the estimated bytes of the memory pools and the symbolized call
+  /// stacks of up to 'maxSites' allocation sites with the most estimated
+  /// bytes.
+  std::string toString(int32_t maxSites = 5) const;
+
+  /// Returns the sampled call stacks as a heap profile in the text format of
+  /// gperftools, which the pprof tool reads, e.g. 'pprof --alloc_space
+  /// <binary> <file>'.
+  std::string toPprof() const;
+
+  /// Drops the samples.
+  void clear();
+
+ private:
+  struct StackHasher {
+    size_t operator()(const std::vector<void*>& stack) const;
+  };
+
+  struct SiteStats {
+    uint64_t numSamples{0};
+    uint64_t sampledBytes{0};
+    double estimatedBytes{0};
+  };
+
+  using SiteMap =
+      folly::F14FastMap<std::vector<void*>, SiteStats, StackHasher>;
+
+  // Records the call stack of an allocation of 'bytes' from 'pool'.
+  void sample(const MemoryPool& pool, uint64_t bytes);
+
+  // Returns a random number of bytes to the next sample.
+  int64_t nextSampleInterval() const;
+
+  const uint64_t sampleIntervalBytes_;
+
+  // Bytes the calling thread allocates before its next sample. Starts at a
+  // random interval so that the first allocation of a thread is sampled like
+  // any other.
+  folly::ThreadLocal<int64_t> bytesUntilSample_{
+      [this]() { return new int64_t(nextSampleInterval()); }};
+
+  mutable std::mutex mutex_;
+  // Sampled call stacks by memory pool name.
+  folly::F14FastMap<std::string, SiteMap> sites_;
+};
+
+} // namespace facebook::velox::memory
@@ -254,29 +254,29 @@ HashStringAllocator::allocateFromFreeList(
   if (!numFree_) {
     return nullptr;
   }
-  VELOX_CHECK(!free_.empty());
+  VELOX_CHECK_NE(0, freeNonEmpty_);
   preferredSize = std::max(kMinAlloc, preferredSize);
-  int32_t counter = 0;
-  Header* largest = nullptr;
-  Header* found = nullptr;
-  for (auto* item = free_.next(); item != &free_; item = item->next()) {
-    auto header = headerOf(item);
-    VELOX_CHECK(header->isFree());
-    auto size = header->size();
-    if (size >= preferredSize) {
-      found = header;
-      break;
-    }
-    if (!largest || size > largest->size()) {
-      largest = header;
-    }
-    if (!mustHaveSize && ++counter > kMaxCheckedForFit) {
-      break;
+  const auto index = freeListIndex(preferredSize);
+  // A few blocks of the list for 'preferredSize' may fit. Any block in a
+  // list for larger sizes fits.
+  auto found = findInFreeList(index, preferredSize, kMaxCheckedForFit);
+  if (!found) {
+    const auto larger = index + 1 < kNumFreeLists
+        ? freeNonEmpty_ & (~0U << (index + 1))
+        : 0;
+    if (larger) {
+      found = headerOf(free_[__builtin_ctz(larger)].next());
+    } else if (mustHaveSize) {
+      // Nothing larger. Only the rest of the list for 'preferredSize' can
+      // have a fit.
+      found = findInFreeList(
+          index, preferredSize, std::numeric_limits<int32_t>::max());
+    } else {
+      // The block from the largest non-empty list.
+      const auto listIndex = 31 - __builtin_clz(freeNonEmpty_);
+      found = headerOf(free_[listIndex].next());
     }
   }
-  if (!mustHaveSize && !found) {
-    found = largest;
-  }
   if (!found) {
     return nullptr;
   }
@@ -296,6 +296,27 @@ HashStringAllocator::allocateFromFreeList(
   return found;
 }
 
+HashStringAllocator::Header* FOLLY_NULLABLE
+HashStringAllocator::findInFreeList(
+    int32_t index,
+    int32_t size,
+    int32_t maxChecked) const {
+  if (!(freeNonEmpty_ & (1U << index))) {
+    return nullptr;
+  }
+  int32_t counter = 0;
+  auto& list = free_[index];
+  for (auto* item = list.next(); item != &list && counter++ < maxChecked;
+       item = item->next()) {
+    auto header = headerOf(item);
+    VELOX_CHECK(header->isFree());
+    if (header->size() >= size) {
+      return header;
+    }
+  }
+  return nullptr;
+}
+
 void HashStringAllocator::free(Header* _header) {
   Header* header = _header;
   do {
@@ -319,14 +340,16 @@ void HashStringAllocator::free(Header* _header) {
       }
     }
     if (header->isPreviousFree()) {
+      // The merged block may belong to another free list.
       auto previousFree = getPreviousFree(header);
+      removeFromFreeList(previousFree);
       previousFree->setSize(
           previousFree->size() + header->size() + sizeof(Header));
       header = previousFree;
     } else {
       ++numFree_;
-      free_.insert(reinterpret_cast<CompactDoubleList*>(header->begin()));
     }
+    addToFreeList(header);
     markAsFree(header);
     header = continued;
   } while (header);
@@ -455,9 +478,15 @@ void HashStringAllocator::checkConsistency() const {
   VELOX_CHECK_EQ(freeBytes, freeBytes_);
   uint64_t numInFreeList = 0;
   uint64_t bytesInFreeList = 0;
-  for (auto free = free_.next(); free != &free_; free = free->next()) {
-    ++numInFreeList;
-    bytesInFreeList += headerOf(free)->size() + sizeof(Header);
+  for (auto i = 0; i < kNumFreeLists; ++i) {
+    auto& list = free_[i];
+    VELOX_CHECK_EQ(!list.empty(), (freeNonEmpty_ & (1U << i)) != 0);
+    for (auto free = list.next(); free != &list; free = free->next()) {
+      ++numInFreeList;
+      auto header = headerOf(free);
+      VELOX_CHECK_EQ(i, freeListIndex(header->size()));
+      bytesInFreeList += header->size() + sizeof(Header);
+    }
   }
   VELOX_CHECK_EQ(numInFreeList, numFree_);
   VELOX_CHECK_EQ(bytesInFreeList, freeBytes_);
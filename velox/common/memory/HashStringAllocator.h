@@ -33,7 +33,9 @@ namespace facebook::velox {
 // the contents of this allocation continue. kFree means the block is free. A
 // free block has pointers to the next and previous free block via a
 // CompactDoubleList struct immediately after the header. The last 4 bytes of a
-// free block contain its length. kPreviousFree means that the block immediately
+// free block contain its length. The free blocks are in size segregated free
+// lists, one per power of two range of sizes, with a bitmap of the non-empty
+// lists. kPreviousFree means that the block immediately
 // below is free. In this case the uint32_t below the header has the size of the
 // previous free block. The last word of a Allocation::PageRun backing a
 // HashStringAllocator is set to kArenaEnd.
@@ -281,7 +283,10 @@ class HashStringAllocator : public StreamArena {
   void clear() {
     numFree_ = 0;
     freeBytes_ = 0;
-    new (&free_) CompactDoubleList();
+    for (auto& list : free_) {
+      new (&list) CompactDoubleList();
+    }
+    freeNonEmpty_ = 0;
     pool_.clear();
   }
 
@@ -301,6 +306,26 @@ class HashStringAllocator : public StreamArena {
   static constexpr int32_t kUnitSize = 16 * memory::AllocationTraits::kPageSize;
   static constexpr int32_t kMinContiguous = 48;
 
+  // Number of free lists. Free list i has blocks of size [2^(i + 4), 2^(i +
+  // 5)). The first one also has the smaller blocks and the last one also has
+  // the larger ones.
+  static constexpr int32_t kNumFreeLists = 24;
+  static constexpr int32_t kFirstFreeListBits = 4;
+
+  // Returns the index in 'free_' for a free block of 'size' bytes.
+  static int32_t freeListIndex(uint32_t size) {
+    const int32_t bitWidth = 32 - __builtin_clz(size | 1);
+    return std::min<int32_t>(
+        kNumFreeLists - 1, std::max(0, bitWidth - 1 - kFirstFreeListBits));
+  }
+
+  // Adds the free block 'header' to the free list for its size.
+  void addToFreeList(Header* FOLLY_NONNULL header) {
+    const auto index = freeListIndex(header->size());
+    free_[index].insert(reinterpret_cast<CompactDoubleList*>(header->begin()));
+    freeNonEmpty_ |= 1U << index;
+  }
+
   void newRange(int32_t bytes, ByteRange* range, bool contiguous);
 
   // Adds 'bytes' worth of contiguous space to the free list. This
@@ -311,12 +336,23 @@ class HashStringAllocator : public StreamArena {
   // starting to process a batch of input.
   void newSlab(int32_t size);
 
+  // Removes 'header' from its free list. 'header' must have the size it had
+  // when added.
   void removeFromFreeList(Header* FOLLY_NONNULL header) {
     VELOX_CHECK(header->isFree());
     header->clearFree();
     reinterpret_cast<CompactDoubleList*>(header->begin())->remove();
+    const auto index = freeListIndex(header->size());
+    if (free_[index].empty()) {
+      freeNonEmpty_ &= ~(1U << index);
+    }
   }
 
+  // Returns the first block of at least 'size' bytes in the first
+  // 'maxChecked' blocks of free list 'index' or nullptr if there is none.
+  Header* FOLLY_NULLABLE
+  findInFreeList(int32_t index, int32_t size, int32_t maxChecked) const;
+
   /// Allocates a block of specified size. If exactSize is false, the block may
   /// be smaller or larger. Checks free list before allocating new memory.
   Header* FOLLY_NULLABLE allocate(int32_t size, bool exactSize);
@@ -338,10 +374,13 @@ class HashStringAllocator : public StreamArena {
   // blocks would be below minimum size.
   void freeRestOfBlock(Header* FOLLY_NONNULL header, int32_t keepBytes);
 
-  // Circular list of free blocks.
-  CompactDoubleList free_;
+  // Circular lists of free blocks, one per size range. See freeListIndex().
+  CompactDoubleList free_[kNumFreeLists];
+
+  // Bit i is set if free_[i] is not empty.
+  uint32_t freeNonEmpty_{0};
 
-  // Count of elements in 'free_'. This is 0 when free_.next() == &free_.
+  // Count of elements in 'free_'. This is 0 when all of 'free_' are empty.
   uint64_t numFree_ = 0;
 
   // Sum of the size of blocks in 'free_', excluding headers.
@@ -36,7 +36,14 @@ MemoryManager::MemoryManager(const Options& options)
           .minMemoryPoolCapacityTransferSize =
               options.arbitratorConfig.minMemoryPoolCapacityTransferSize,
           .retryArbitrationFailure =
-              options.arbitratorConfig.retryArbitrationFailure})),
+              options.arbitratorConfig.retryArbitrationFailure,
+          .allocator = options.allocator,
+          .proactiveReclaimExecutor =
+              options.arbitratorConfig.proactiveReclaimExecutor,
+          .proactiveReclaimHighWaterPct =
+              options.arbitratorConfig.proactiveReclaimHighWaterPct,
+          .proactiveReclaimLowWaterPct =
+              options.arbitratorConfig.proactiveReclaimLowWaterPct})),
       alignment_(std::max(MemoryAllocator::kMinAlignment, options.alignment)),
       checkUsageLeak_(options.checkUsageLeak),
       debugEnabled_(options.debugEnabled),
@@ -285,6 +285,13 @@ class MemoryAllocator : public std::enable_shared_from_this<MemoryAllocator> {
 
   virtual MachinePageCount numMapped() const = 0;
 
+  /// Returns the freed memory that 'this' keeps cached for quick reuse back to
+  /// the underlying allocator. Cached memory counts as allocated until it is
+  /// flushed. Returns the flushed bytes.
+  virtual uint64_t flushCache() {
+    return 0;
+  }
+
   virtual Stats stats() const {
     return Stats();
   }
@@ -109,9 +109,62 @@ void MemoryReclaimer::abort(MemoryPool* pool) {
   });
 }
 
+void MemoryArbitrator::LatencyHistogram::record(uint64_t latencyUs) {
+  const uint64_t latencyMs = latencyUs / 1'000;
+  const int32_t index = latencyMs == 0
+      ? 0
+      : std::min<int32_t>(kNumBuckets - 1, 64 - __builtin_clzll(latencyMs));
+  ++counts[index];
+}
+
+uint64_t MemoryArbitrator::LatencyHistogram::count() const {
+  uint64_t total{0};
+  for (const auto count : counts) {
+    total += count;
+  }
+  return total;
+}
+
+uint64_t MemoryArbitrator::LatencyHistogram::bucketUpperBoundUs(
+    int32_t index) {
+  VELOX_CHECK_GE(index, 0);
+  VELOX_CHECK_LT(index, kNumBuckets);
+  return (1UL << index) * 1'000;
+}
+
+uint64_t MemoryArbitrator::LatencyHistogram::percentileUs(
+    double percentile) const {
+  const uint64_t total = count();
+  if (total == 0) {
+    return 0;
+  }
+  const uint64_t rank = std::max<uint64_t>(1, total * percentile / 100);
+  uint64_t seen{0};
+  for (int32_t i = 0; i < kNumBuckets; ++i) {
+    seen += counts[i];
+    if (seen >= rank) {
+      return bucketUpperBoundUs(i);
+    }
+  }
+  return bucketUpperBoundUs(kNumBuckets - 1);
+}
+
+std::string MemoryArbitrator::LatencyHistogram::toString() const {
+  if (count() == 0) {
+    return "[count 0]";
+  }
+  return fmt::format(
+      "[count {} p50 <{} p90 <{} p99 <{} max <{}]",
+      count(),
+      succinctMicros(percentileUs(50)),
+      succinctMicros(percentileUs(90)),
+      succinctMicros(percentileUs(99)),
+      succinctMicros(percentileUs(100)));
+}
+
 std::string MemoryArbitrator::Stats::toString() const {
   return fmt::format(
-      "STATS[numRequests {} numAborted {} numFailures {} queueTime {} arbitrationTime {} shrunkMemory {} reclaimedMemory {} maxCapacity {} freeCapacity {}]",
+      "STATS[numRequests {} numAborted {} numFailures {} queueTime {} arbitrationTime {} shrunkMemory {} reclaimedMemory {} maxCapacity {} freeCapacity {} queueTimeHistogram {} arbitrationTimeHistogram {} numProactiveReclaims {} proactiveReclaimedMemory {} proactiveReclaimTimeHistogram {}]",
       numRequests,
       numAborted,
       numFailures,
@@ -120,6 +173,11 @@ std::string MemoryArbitrator::Stats::toString() const {
       succinctBytes(numShrunkBytes),
       succinctBytes(numReclaimedBytes),
       succinctBytes(maxCapacityBytes),
-      succinctBytes(freeCapacityBytes));
+      succinctBytes(freeCapacityBytes),
+      queueTimeHistogram.toString(),
+      arbitrationTimeHistogram.toString(),
+      numProactiveReclaims,
+      succinctBytes(numProactiveReclaimedBytes),
+      proactiveReclaimTimeHistogram.toString());
 }
 } // namespace facebook::velox::memory
@@ -16,14 +16,18 @@
 
 #pragma once
 
+#include <array>
 #include <vector>
 
+#include <folly/Executor.h>
+
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/SuccinctPrinter.h"
 #include "velox/common/future/VeloxPromise.h"
 
 namespace facebook::velox::memory {
 
+class MemoryAllocator;
 class MemoryPool;
 
 /// The memory arbitrator interface. There is one memory arbitrator object per
@@ -85,6 +89,31 @@ class MemoryArbitrator {
     /// same query on all the workers instead of a random victim query which
     /// happens to trigger the failed memory arbitration.
     bool retryArbitrationFailure{true};
+
+    /// The memory allocator behind the arbitrated memory pools. If set, the
+    /// arbitrator flushes the freed memory cached by the allocator before it
+    /// reclaims memory from the memory pools.
+    MemoryAllocator* allocator{nullptr};
+
+    /// If set, the arbitrator reclaims memory from the memory pools in the
+    /// background on this executor once the memory capacity granted to them
+    /// exceeds 'proactiveReclaimHighWaterPct' of 'capacity'. The reclaim
+    /// brings the granted capacity back down to 'proactiveReclaimLowWaterPct'
+    /// of 'capacity' by first shrinking unused capacity and then spilling
+    /// from the reclaimable pools other than the one whose growth triggered
+    /// it. This moves the spilling off the path of the next memory growth
+    /// request that would otherwise block on it.
+    ///
+    /// NOTE: the executor must not run the reclaim inline as it is scheduled
+    /// from within an arbitration request.
+    folly::Executor* proactiveReclaimExecutor{nullptr};
+
+    /// The percentage of 'capacity' above which to start a background
+    /// reclaim. 0 disables the background reclaim.
+    int32_t proactiveReclaimHighWaterPct{0};
+
+    /// The percentage of 'capacity' a background reclaim tries to get down to.
+    int32_t proactiveReclaimLowWaterPct{0};
   };
   static std::unique_ptr<MemoryArbitrator> create(const Config& config);
 
@@ -126,6 +155,32 @@ class MemoryArbitrator {
       const std::vector<std::shared_ptr<MemoryPool>>& candidatePools,
       uint64_t targetBytes) = 0;
 
+  /// Counts of latencies in exponentially growing buckets. Bucket 0 counts
+  /// latencies under 1ms, bucket i > 0 latencies in [2^(i-1), 2^i) ms and the
+  /// last bucket everything above.
+  struct LatencyHistogram {
+    static constexpr int32_t kNumBuckets = 16;
+
+    std::array<uint64_t, kNumBuckets> counts{};
+
+    void record(uint64_t latencyUs);
+
+    /// Returns the total number of recorded latencies.
+    uint64_t count() const;
+
+    /// Returns the upper bound in microseconds of the bucket that contains
+    /// the 'percentile'th latency, e.g. 99 for p99. Returns 0 if there are no
+    /// recorded latencies.
+    uint64_t percentileUs(double percentile) const;
+
+    /// Returns the upper bound in microseconds of the latencies counted in
+    /// bucket 'index'.
+    static uint64_t bucketUpperBoundUs(int32_t index);
+
+    /// Returns the p50, p90, p99 and max bucket bounds.
+    std::string toString() const;
+  };
+
   /// The internal execution stats of the memory arbitrator.
   struct Stats {
     /// The number of arbitration requests.
@@ -147,6 +202,16 @@ class MemoryArbitrator {
     uint64_t maxCapacityBytes{0};
     /// The free memory capacity in bytes.
     uint64_t freeCapacityBytes{0};
+    /// The distribution of the arbitration request queue times.
+    LatencyHistogram queueTimeHistogram;
+    /// The distribution of the arbitration request run times.
+    LatencyHistogram arbitrationTimeHistogram;
+    /// The number of background reclaims.
+    uint64_t numProactiveReclaims{0};
+    /// The amount of memory capacity in bytes freed by background reclaims.
+    uint64_t numProactiveReclaimedBytes{0};
+    /// The distribution of the background reclaim run times.
+    LatencyHistogram proactiveReclaimTimeHistogram;
 
     /// Returns the debug string of this stats.
     std::string toString() const;
@@ -163,13 +228,30 @@ class MemoryArbitrator {
         initMemoryPoolCapacity_(config.initMemoryPoolCapacity),
         minMemoryPoolCapacityTransferSize_(
             config.minMemoryPoolCapacityTransferSize),
-        retryArbitrationFailure_(config.retryArbitrationFailure) {}
+        retryArbitrationFailure_(config.retryArbitrationFailure),
+        allocator_(config.allocator),
+        proactiveReclaimExecutor_(config.proactiveReclaimExecutor),
+        proactiveReclaimHighWaterBytes_(
+            capacity_ * config.proactiveReclaimHighWaterPct / 100),
+        proactiveReclaimLowWaterBytes_(
+            capacity_ * config.proactiveReclaimLowWaterPct / 100) {
+    VELOX_CHECK_GE(config.proactiveReclaimHighWaterPct, 0);
+    VELOX_CHECK_LE(config.proactiveReclaimHighWaterPct, 100);
+    VELOX_CHECK_GE(config.proactiveReclaimLowWaterPct, 0);
+    VELOX_CHECK_LE(
+        config.proactiveReclaimLowWaterPct,
+        config.proactiveReclaimHighWaterPct);
+  }
 
   const Kind kind_;
   const uint64_t capacity_;
   const uint64_t initMemoryPoolCapacity_;
   const uint64_t minMemoryPoolCapacityTransferSize_;
   const bool retryArbitrationFailure_;
+  MemoryAllocator* const allocator_;
+  folly::Executor* const proactiveReclaimExecutor_;
+  const uint64_t proactiveReclaimHighWaterBytes_;
+  const uint64_t proactiveReclaimLowWaterBytes_;
 };
 
 std::ostream& operator<<(std::ostream& out, const MemoryArbitrator::Kind& kind);
@@ -141,6 +141,10 @@ std::string capacityToString(int64_t capacity) {
   if (FOLLY_UNLIKELY(debugEnabled_)) { \
     recordFreeDbg(__VA_ARGS__);        \
   }
+#define PROFILE_ALLOC(bytes)                     \
+  if (FOLLY_UNLIKELY(profiler_ != nullptr)) {    \
+    profiler_->recordAllocation(*this, (bytes)); \
+  }
 #define DEBUG_LEAK_CHECK()             \
   if (FOLLY_UNLIKELY(debugEnabled_)) { \
     leakCheckDbg();                    \
@@ -200,7 +204,8 @@ MemoryPool::MemoryPool(
       trackUsage_(options.trackUsage),
       threadSafe_(options.threadSafe),
       checkUsageLeak_(options.checkUsageLeak),
-      debugEnabled_(options.debugEnabled) {
+      debugEnabled_(options.debugEnabled),
+      profiler_(options.profiler) {
   VELOX_CHECK(!isRoot() || !isLeaf());
   VELOX_CHECK_GT(
       maxCapacity_, 0, "Memory pool {} max capacity can't be zero", name_);
@@ -211,6 +216,16 @@ MemoryPool::~MemoryPool() {
   VELOX_CHECK(children_.empty());
 }
 
+void MemoryPool::setAllocationProfiler(
+    std::shared_ptr<AllocationProfiler> profiler) {
+  VELOX_CHECK_EQ(
+      getChildCount(),
+      0,
+      "Allocation profiler must be set before adding child pools to {}",
+      name_);
+  profiler_ = std::move(profiler);
+}
+
 std::string MemoryPool::kindString(Kind kind) {
   switch (kind) {
     case Kind::kLeaf:
@@ -430,6 +445,7 @@ void* MemoryPoolImpl::allocate(int64_t size) {
         "{} failed with {} bytes from {}", __FUNCTION__, size, toString()));
   }
   DEBUG_RECORD_ALLOC(buffer, size);
+  PROFILE_ALLOC(alignedSize);
   return buffer;
 }
 
@@ -449,6 +465,7 @@ void* MemoryPoolImpl::allocateZeroFilled(int64_t numEntries, int64_t sizeEach) {
         toString()));
   }
   DEBUG_RECORD_ALLOC(buffer, size);
+  PROFILE_ALLOC(alignedSize);
   return buffer;
 }
 
@@ -468,6 +485,7 @@ void* MemoryPoolImpl::reallocate(void* p, int64_t size, int64_t newSize) {
         toString()));
   }
   DEBUG_RECORD_ALLOC(newP, newSize);
+  PROFILE_ALLOC(alignedNewSize);
   if (p != nullptr) {
     ::memcpy(newP, p, std::min(size, newSize));
     free(p, size);
@@ -512,6 +530,7 @@ void MemoryPoolImpl::allocateNonContiguous(
         "{} failed with {} pages from {}", __FUNCTION__, numPages, toString()));
   }
   DEBUG_RECORD_ALLOC(out);
+  PROFILE_ALLOC(out.byteSize());
   VELOX_CHECK(!out.empty());
   VELOX_CHECK_NULL(out.pool());
   out.setPool(this);
@@ -555,6 +574,7 @@ void MemoryPoolImpl::allocateContiguous(
         "{} failed with {} pages from {}", __FUNCTION__, numPages, toString()));
   }
   DEBUG_RECORD_ALLOC(out);
+  PROFILE_ALLOC(out.size());
   VELOX_CHECK(!out.empty());
   VELOX_CHECK_NULL(out.pool());
   out.setPool(this);
@@ -595,7 +615,8 @@ std::shared_ptr<MemoryPool> MemoryPoolImpl::genChild(
           .trackUsage = trackUsage_,
           .threadSafe = threadSafe,
           .checkUsageLeak = checkUsageLeak_,
-          .debugEnabled = debugEnabled_});
+          .debugEnabled = debugEnabled_,
+          .profiler = profiler_});
 }
 
 bool MemoryPoolImpl::maybeReserve(uint64_t increment) {
@@ -854,6 +875,9 @@ std::string MemoryPoolImpl::capExceedingMessage(
 
   out << "\nFailed memory pool: " << requestor->name() << ": "
       << succinctBytes(requestor->currentBytes()) << "\n";
+  if (requestor->allocationProfiler() != nullptr) {
+    out << "\n" << requestor->allocationProfiler()->toString();
+  }
   return out.str();
 }
 
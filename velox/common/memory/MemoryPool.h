@@ -27,6 +27,7 @@
 #include "velox/common/base/Portability.h"
 #include "velox/common/future/VeloxPromise.h"
 #include "velox/common/memory/Allocation.h"
+#include "velox/common/memory/AllocationProfiler.h"
 #include "velox/common/memory/MemoryAllocator.h"
 #include "velox/common/memory/MemoryArbitrator.h"
 
@@ -157,6 +158,10 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
     /// If true, tracks the allocation and free call stacks to detect the source
     /// of memory leak for testing purpose.
     bool debugEnabled{FLAGS_velox_memory_pool_debug_enabled};
+
+    /// If set, samples the allocations from this memory pool and its child
+    /// pools created afterwards.
+    std::shared_ptr<AllocationProfiler> profiler{nullptr};
   };
 
   /// Constructs a named memory pool with specified 'name', 'parent' and 'kind'.
@@ -404,6 +409,17 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
   /// Returns true if this memory pool has been aborted.
   virtual bool aborted() const = 0;
 
+  /// Sets 'profiler' to sample the allocations from this memory pool and the
+  /// child pools created afterwards.
+  ///
+  /// NOTE: this shall only be called before adding any child pool.
+  void setAllocationProfiler(std::shared_ptr<AllocationProfiler> profiler);
+
+  /// Returns the allocation profiler of this memory pool if not null.
+  AllocationProfiler* allocationProfiler() const {
+    return profiler_.get();
+  }
+
   /// The memory pool's execution stats.
   struct Stats {
     /// The current memory usage.
@@ -500,6 +516,7 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
   const bool threadSafe_;
   const bool checkUsageLeak_;
   const bool debugEnabled_;
+  std::shared_ptr<AllocationProfiler> profiler_;
 
   /// Indicates if the memory pool has been aborted by the memory arbitrator or
   /// not.
@@ -18,6 +18,9 @@
 
 #include <sys/mman.h>
 
+#include <algorithm>
+#include <thread>
+
 #include "velox/common/base/Portability.h"
 #include "velox/common/memory/Memory.h"
 
@@ -25,6 +28,7 @@ namespace facebook::velox::memory {
 MmapAllocator::MmapAllocator(const Options& options)
     : kind_(MemoryAllocator::Kind::kMmap),
       useMmapArena_(options.useMmapArena),
+      useHugePages_(options.useHugePages),
       maxMallocBytes_(options.maxMallocBytes),
       mallocReservedBytes_(
           maxMallocBytes_ == 0
@@ -32,9 +36,24 @@ MmapAllocator::MmapAllocator(const Options& options)
               : options.capacity * options.smallAllocationReservePct / 100),
       capacity_(bits::roundUp(
           AllocationTraits::numPages(options.capacity - mallocReservedBytes_),
-          64 * sizeClassSizes_.back())) {
+          64 * sizeClassSizes_.back())),
+      pageCacheShardPages_(
+          AllocationTraits::numPages(options.pageCacheBytes) /
+          std::clamp<int32_t>(
+              std::thread::hardware_concurrency(), 1, kMaxPageCacheShards)) {
   for (const auto& size : sizeClassSizes_) {
-    sizeClasses_.push_back(std::make_unique<SizeClass>(capacity_ / size, size));
+    sizeClasses_.push_back(std::make_unique<SizeClass>(
+        capacity_ / size,
+        size,
+        useHugePages_ && size >= kMinHugePageSizeClass));
+  }
+
+  if (pageCacheShardPages_ > 0) {
+    const auto numShards = AllocationTraits::numPages(options.pageCacheBytes) /
+        pageCacheShardPages_;
+    for (uint64_t i = 0; i < numShards; ++i) {
+      pageCache_.push_back(std::make_unique<PageCacheShard>());
+    }
   }
 
   if (useMmapArena_) {
@@ -47,6 +66,7 @@ MmapAllocator::MmapAllocator(const Options& options)
 }
 
 MmapAllocator::~MmapAllocator() {
+  flushCache();
   VELOX_CHECK(
       (numAllocated_ == 0) && (numExternalMapped_ == 0), "{}", toString());
 }
@@ -56,9 +76,11 @@ bool MmapAllocator::allocateNonContiguous(
     Allocation& out,
     ReservationCallback reservationCB,
     MachinePageCount minSizeClass) {
-  const int64_t numFreed = freeInternal(out);
-  if (numFreed != 0) {
-    numAllocated_.fetch_sub(numFreed);
+  // Cached pages stay counted in 'numAllocated_'.
+  const int64_t numCached = cacheFreedPages(out);
+  const int64_t numFreed = numCached + freeInternal(out);
+  if (numFreed != numCached) {
+    numAllocated_.fetch_sub(numFreed - numCached);
   }
   if (numPages == 0) {
     return true;
@@ -71,6 +93,29 @@ bool MmapAllocator::allocateNonContiguous(
     return false;
   }
 
+  if (allocateFromCache(mix, out)) {
+    ++numAllocations_;
+    numAllocatedPages_ += mix.totalPages;
+    if (reservationCB != nullptr) {
+      const int64_t numNeededPages = mix.totalPages - numFreed;
+      try {
+        reservationCB(AllocationTraits::pageBytes(numNeededPages), true);
+      } catch (const std::exception& e) {
+        VELOX_MEM_LOG_EVERY_MS(WARNING, 1000)
+            << "Exceeded memory reservation limit when reserve "
+            << numNeededPages << " new pages when allocate " << mix.totalPages
+            << " pages";
+        freeNonContiguous(out);
+        reservationCB(AllocationTraits::pageBytes(numFreed), false);
+        std::rethrow_exception(std::current_exception());
+      }
+    }
+    return true;
+  }
+
+  if (numAllocated_ + mix.totalPages > capacity_ && numCachedPages_ > 0) {
+    flushCache();
+  }
   if (numAllocated_ + mix.totalPages > capacity_) {
     VELOX_MEM_LOG_EVERY_MS(WARNING, 1000)
         << "Exceeding memory allocator limit when allocate " << mix.totalPages
@@ -128,7 +173,8 @@ bool MmapAllocator::allocateNonContiguous(
       VELOX_MEM_LOG(WARNING) << "Failed allocation in size class " << i
                              << " for " << mix.sizeCounts[i] << " pages";
       const auto failedPages = mix.totalPages - out.numPages();
-      freeNonContiguous(out);
+      // Not cached since 'out' may have pages that are not backed by memory.
+      numAllocated_.fetch_sub(freeInternal(out));
       numAllocated_.fetch_sub(failedPages);
       if (reservationCB != nullptr) {
         reservationCB(AllocationTraits::pageBytes(mix.totalPages), false);
@@ -147,7 +193,7 @@ bool MmapAllocator::allocateNonContiguous(
   VELOX_MEM_LOG(WARNING) << "Could not advise away enough for " << newMapsNeeded
                          << " pages with total allocation of << "
                          << mix.totalPages << " pages";
-  freeNonContiguous(out);
+  numAllocated_.fetch_sub(freeInternal(out));
   if (reservationCB != nullptr) {
     reservationCB(AllocationTraits::pageBytes(mix.totalPages), false);
   }
@@ -178,9 +224,108 @@ bool MmapAllocator::ensureEnoughMappedPages(int32_t newMappedNeeded) {
 }
 
 int64_t MmapAllocator::freeNonContiguous(Allocation& allocation) {
+  const auto numCached = cacheFreedPages(allocation);
   const auto numFreed = freeInternal(allocation);
   numAllocated_.fetch_sub(numFreed);
-  return AllocationTraits::pageBytes(numFreed);
+  return AllocationTraits::pageBytes(numCached + numFreed);
+}
+
+MmapAllocator::PageCacheShard& MmapAllocator::pageCacheShard() {
+  static std::atomic<uint32_t> nextShard{0};
+  thread_local const uint32_t shard = nextShard++;
+  return *pageCache_[shard % pageCache_.size()];
+}
+
+MachinePageCount MmapAllocator::cacheFreedPages(Allocation& allocation) {
+  if (pageCache_.empty() || allocation.empty()) {
+    return 0;
+  }
+  auto& shard = pageCacheShard();
+  MachinePageCount numCached = 0;
+  int32_t numKept = 0;
+  {
+    std::lock_guard<std::mutex> l(shard.mutex);
+    for (auto i = 0; i < allocation.numRuns(); ++i) {
+      const auto run = allocation.runAt(i);
+      const auto it = std::find(
+          sizeClassSizes_.begin(), sizeClassSizes_.end(), run.numPages());
+      if (it != sizeClassSizes_.end() &&
+          shard.numPages + run.numPages() <= pageCacheShardPages_) {
+        const auto index = it - sizeClassSizes_.begin();
+        if (sizeClasses_[index]->isInRange(run.data())) {
+          shard.pages[index].push_back(run.data());
+          shard.numPages += run.numPages();
+          numCached += run.numPages();
+          continue;
+        }
+      }
+      allocation.runs_[numKept++] = run;
+    }
+  }
+  if (numCached == 0) {
+    return 0;
+  }
+  numCachedPages_ += numCached;
+  if (numKept == 0) {
+    allocation.clear();
+  } else {
+    allocation.runs_.resize(numKept);
+    allocation.numPages_ -= numCached;
+  }
+  return numCached;
+}
+
+bool MmapAllocator::allocateFromCache(const SizeMix& mix, Allocation& out) {
+  if (pageCache_.empty() || numCachedPages_ < mix.totalPages) {
+    return false;
+  }
+  auto& shard = pageCacheShard();
+  std::lock_guard<std::mutex> l(shard.mutex);
+  if (shard.numPages < mix.totalPages) {
+    return false;
+  }
+  for (auto i = 0; i < mix.numSizes; ++i) {
+    if (shard.pages[mix.sizeIndices[i]].size() < mix.sizeCounts[i]) {
+      return false;
+    }
+  }
+  for (auto i = 0; i < mix.numSizes; ++i) {
+    auto& pages = shard.pages[mix.sizeIndices[i]];
+    const auto unitSize = sizeClassSizes_[mix.sizeIndices[i]];
+    for (auto j = 0; j < mix.sizeCounts[i]; ++j) {
+      out.append(pages.back(), unitSize);
+      pages.pop_back();
+    }
+  }
+  shard.numPages -= mix.totalPages;
+  numCachedPages_ -= mix.totalPages;
+  ++numPageCacheHits_;
+  return true;
+}
+
+uint64_t MmapAllocator::flushCache() {
+  MachinePageCount numFlushed = 0;
+  for (auto& shard : pageCache_) {
+    Allocation allocation;
+    {
+      std::lock_guard<std::mutex> l(shard->mutex);
+      if (shard->numPages == 0) {
+        continue;
+      }
+      for (auto i = 0; i < sizeClassSizes_.size(); ++i) {
+        for (auto* page : shard->pages[i]) {
+          allocation.append(page, sizeClassSizes_[i]);
+        }
+        shard->pages[i].clear();
+      }
+      shard->numPages = 0;
+    }
+    const auto numFreed = freeInternal(allocation);
+    numCachedPages_ -= numFreed;
+    numAllocated_ -= numFreed;
+    numFlushed += numFreed;
+  }
+  return AllocationTraits::pageBytes(numFlushed);
 }
 
 MachinePageCount MmapAllocator::freeInternal(Allocation& allocation) {
@@ -291,6 +436,10 @@ bool MmapAllocator::allocateContiguousImpl(
     }
   };
 
+  if (newPages > 0 && numAllocated_ + newPages > capacity_ &&
+      numCachedPages_ > 0) {
+    flushCache();
+  }
   numExternalMapped_ += numPages - numCollateralUnmap;
   auto numAllocated = numAllocated_.fetch_add(newPages) + newPages;
   // Check if went over the limit. But a net decrease always succeeds even if
@@ -453,10 +602,16 @@ MachinePageCount MmapAllocator::adviseAway(MachinePageCount target) {
   return numAway;
 }
 
-MmapAllocator::SizeClass::SizeClass(size_t capacity, MachinePageCount unitSize)
+MmapAllocator::SizeClass::SizeClass(
+    size_t capacity,
+    MachinePageCount unitSize,
+    bool useHugePages)
     : capacity_(capacity),
       unitSize_(unitSize),
       byteSize_(AllocationTraits::pageBytes(capacity_ * unitSize_)),
+      pagesPerHugePage_(
+          useHugePages ? std::max<ClassPageCount>(1, kHugePageSize / unitSize_)
+                       : 0),
       pageBitmapSize_(capacity_ / 64),
       // Min 8 words + 1 bit for every 512 bits in 'pageAllocated_'.
       mappedFreeLookup_((capacity_ / kPagesPerLookupBit / 64) + kSimdTail),
@@ -467,9 +622,13 @@ MmapAllocator::SizeClass::SizeClass(size_t capacity, MachinePageCount unitSize)
       0,
       "Sizeclass {} must have a multiple of 64 capacity",
       unitSize_);
+  // A huge page backed range is over-allocated by one huge page so that it
+  // can be aligned to a huge page boundary.
+  const size_t alignment =
+      useHugePages ? AllocationTraits::pageBytes(kHugePageSize) : 0;
   void* ptr = mmap(
       nullptr,
-      AllocationTraits::pageBytes(capacity_ * unitSize_),
+      byteSize_ + alignment,
       PROT_READ | PROT_WRITE,
       MAP_PRIVATE | MAP_ANONYMOUS,
       -1,
@@ -482,6 +641,27 @@ MmapAllocator::SizeClass::SizeClass(size_t capacity, MachinePageCount unitSize)
         unitSize_);
   }
   address_ = reinterpret_cast<uint8_t*>(ptr);
+  if (!useHugePages) {
+    return;
+  }
+  // Unmap the slack before and after the aligned range.
+  auto* start = reinterpret_cast<uint8_t*>(ptr);
+  address_ = reinterpret_cast<uint8_t*>(
+      bits::roundUp(reinterpret_cast<uint64_t>(start), alignment));
+  if (address_ > start) {
+    ::munmap(start, address_ - start);
+  }
+  const auto tailBytes = start + alignment - address_;
+  if (tailBytes > 0) {
+    ::munmap(address_ + byteSize_, tailBytes);
+  }
+#ifdef linux
+  if (::madvise(address_, byteSize_, MADV_HUGEPAGE) != 0) {
+    VELOX_MEM_LOG(WARNING) << "madvise hugepage errno="
+                           << folly::errnoStr(errno) << " for sizeClass "
+                           << unitSize_;
+  }
+#endif
 }
 
 MmapAllocator::SizeClass::~SizeClass() {
@@ -547,6 +727,9 @@ std::string MmapAllocator::SizeClass::toString() const {
   auto mb = (AllocationTraits::pageBytes(count * unitSize_)) >> 20;
   out << "[size " << unitSize_ << ": " << count << "(" << mb << "MB) allocated "
       << mappedCount << " mapped";
+  if (pagesPerHugePage_ > 0) {
+    out << " " << numHugePagesAdvisedAway_ << " huge pages advised away";
+  }
   if (mappedFreeCount != numMappedFreePages_) {
     out << "Mismatched count of mapped free pages "
         << ". Actual= " << mappedFreeCount
@@ -726,7 +909,16 @@ MachinePageCount MmapAllocator::SizeClass::adviseAway(
       return 0;
     }
     target = std::min(target, numMappedFreePages_);
-    allocateLocked(target, nullptr, allocation);
+    ClassPageCount numAllocated = 0;
+    if (pagesPerHugePage_ > 0) {
+      // Prefer whole huge pages. This may advise away up to a huge page more
+      // than asked but does not split the huge pages that stay mapped.
+      numAllocated = allocateMappedFreeHugePagesLocked(target, allocation);
+    }
+    if (numAllocated < target) {
+      allocateLocked(target - numAllocated, nullptr, allocation);
+    }
+    target = std::max(target, numAllocated);
     VELOX_CHECK_EQ(allocation.numPages(), target * unitSize_);
     numAllocatedMapped_ -= target;
     numAdvisedAway_ += target;
@@ -738,6 +930,51 @@ MachinePageCount MmapAllocator::SizeClass::adviseAway(
   return unitSize_ * target;
 }
 
+ClassPageCount MmapAllocator::SizeClass::allocateMappedFreeHugePagesLocked(
+    ClassPageCount numPages,
+    Allocation& allocation) {
+  constexpr int32_t kWordsPerLookupBit = kPagesPerLookupBit / 64;
+  VELOX_CHECK_EQ(64 % pagesPerHugePage_, 0);
+  const uint64_t hugePageMask = pagesPerHugePage_ == 64
+      ? kAllSet
+      : bits::lowMask(pagesPerHugePage_);
+  const int32_t numLookupBits =
+      bits::roundUp(pageBitmapSize_, kWordsPerLookupBit) / kWordsPerLookupBit;
+  ClassPageCount numAllocated = 0;
+  bits::testSetBits(
+      mappedFreeLookup_.data(), 0, numLookupBits, [&](int32_t group) {
+        const auto startWord = group * kWordsPerLookupBit;
+        const auto endWord =
+            std::min<int32_t>(startWord + kWordsPerLookupBit, pageBitmapSize_);
+        bool anyLeft = false;
+        for (auto word = startWord; word < endWord; ++word) {
+          uint64_t mappedFree = ~pageAllocated_[word] & pageMapped_[word];
+          for (auto bit = 0; bit < 64 && mappedFree != 0;
+               bit += pagesPerHugePage_) {
+            const auto mask = hugePageMask << bit;
+            if (numAllocated >= numPages || (mappedFree & mask) != mask) {
+              continue;
+            }
+            pageAllocated_[word] |= mask;
+            mappedFree &= ~mask;
+            allocation.append(
+                address_ +
+                    AllocationTraits::pageBytes((word * 64 + bit) * unitSize_),
+                pagesPerHugePage_ * unitSize_);
+            numAllocated += pagesPerHugePage_;
+            ++numHugePagesAdvisedAway_;
+          }
+          anyLeft |= mappedFree != 0;
+        }
+        if (!anyLeft) {
+          bits::clearBit(mappedFreeLookup_.data(), group);
+        }
+        return numAllocated < numPages;
+      });
+  numMappedFreePages_ -= numAllocated;
+  return numAllocated;
+}
+
 bool MmapAllocator::SizeClass::isInRange(uint8_t* ptr) const {
   if (ptr >= address_ && ptr < address_ + byteSize_) {
     // See that ptr falls on a page boundary.
@@ -899,8 +1136,12 @@ bool MmapAllocator::useMalloc(uint64_t bytes) {
 std::string MmapAllocator::toString() const {
   std::stringstream out;
   out << "[Memory capacity " << capacity_ << " allocated " << numAllocated_
-      << " mapped " << numMapped_ << " external mapped " << numExternalMapped_
-      << std::endl;
+      << " mapped " << numMapped_ << " external mapped " << numExternalMapped_;
+  if (!pageCache_.empty()) {
+    out << " cached " << numCachedPages_ << " cache hits "
+        << numPageCacheHits_;
+  }
+  out << std::endl;
   for (auto& sizeClass : sizeClasses_) {
     out << sizeClass->toString() << std::endl;
   }
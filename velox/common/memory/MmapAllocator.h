@@ -23,6 +23,9 @@
 #include <memory>
 #include <mutex>
 #include <unordered_set>
+#include <vector>
+
+#include <folly/lang/Align.h>
 
 #include "velox/common/base/SimdUtil.h"
 #include "velox/common/memory/MemoryAllocator.h"
@@ -75,8 +78,35 @@ class MmapAllocator : public MemoryAllocator {
     /// and 'smallAllocationReservePct' will be automatically set to 0
     /// disregarding any passed in value.
     int32_t maxMallocBytes = 3072;
+
+    /// If true, the size classes of at least 'kMinHugePageSizeClass' machine
+    /// pages are mapped at huge page alignment and advised to be backed by
+    /// transparent huge pages. Their free pages are then advised away a whole
+    /// huge page at a time where possible so that the backing huge pages are
+    /// not split. This reduces TLB misses when scanning large hash tables and
+    /// row containers.
+    bool useHugePages = false;
+
+    /// If not zero, up to this many bytes of freed size class pages are kept
+    /// in per thread caches and handed out again by allocateNonContiguous()
+    /// without going through the size classes. Cached pages count as
+    /// allocated. The caches are flushed back to the size classes by
+    /// flushCache() and when an allocation would otherwise exceed the
+    /// capacity.
+    uint64_t pageCacheBytes = 0;
   };
 
+  /// Maximum number of shards of the page cache.
+  static constexpr int32_t kMaxPageCacheShards = 64;
+
+  /// Size of a transparent huge page in machine pages.
+  static constexpr MachinePageCount kHugePageSize = 512;
+
+  /// The smallest size class that is backed by huge pages if
+  /// 'Options::useHugePages' is set. Smaller classes are mostly used for
+  /// short lived allocations and would split huge pages when advised away.
+  static constexpr MachinePageCount kMinHugePageSizeClass = 64;
+
   explicit MmapAllocator(const Options& options);
 
   ~MmapAllocator();
@@ -160,10 +190,27 @@ class MmapAllocator : public MemoryAllocator {
     return numExternalMapped_;
   }
 
+  /// Returns the number of freed machine pages held in the page cache. These
+  /// are included in numAllocated().
+  MachinePageCount numCachedPages() const {
+    return numCachedPages_;
+  }
+
+  /// Returns the number of allocations served from the page cache.
+  uint64_t numPageCacheHits() const {
+    return numPageCacheHits_;
+  }
+
+  uint64_t flushCache() override;
+
   uint64_t numMallocBytes() const {
     return numMallocBytes_;
   }
 
+  bool hugePagesEnabled() const {
+    return useHugePages_;
+  }
+
   Stats stats() const override {
     auto stats = stats_;
     stats.numAdvise = numAdvisedPages_;
@@ -179,7 +226,9 @@ class MmapAllocator : public MemoryAllocator {
   // 'unitSize_' machine pages.
   class SizeClass {
    public:
-    SizeClass(size_t capacity, MachinePageCount unitSize);
+    // If 'useHugePages' is true, the address range is aligned to a huge
+    // page and advised to be backed by transparent huge pages.
+    SizeClass(size_t capacity, MachinePageCount unitSize, bool useHugePages);
 
     ~SizeClass();
 
@@ -267,6 +316,16 @@ class MmapAllocator : public MemoryAllocator {
     // 'allocation'.
     void adviseAway(const Allocation& allocation);
 
+    // Allocates mapped free pages in whole huge pages until at least
+    // 'numPages' class pages are allocated or there is no huge page with all
+    // its class pages mapped and free. Each huge page is added to
+    // 'allocation' as one run so that it is advised away with a single
+    // madvise. Returns the number of class pages allocated. Must be called
+    // inside 'mutex_'.
+    ClassPageCount allocateMappedFreeHugePagesLocked(
+        ClassPageCount numPages,
+        Allocation& allocation);
+
     // Allocates up to 'numPages' of mapped or unmapped pages from the
     // free/mapped word at 'wordIndex'. 'numPages' is decremented by the number
     // of allocated class pages, numUnmapped is incremented by the count of
@@ -287,6 +346,10 @@ class MmapAllocator : public MemoryAllocator {
     // Size in bytes of the address range.
     const size_t byteSize_;
 
+    // Number of class pages in one huge page if the address range is backed
+    // by huge pages, 0 otherwise.
+    const ClassPageCount pagesPerHugePage_;
+
     // Number of meaningful words in 'pageAllocated_'/'pageMapped'. The arrays
     // themselves are padded with extra zeros for SIMD access.
     const int32_t pageBitmapSize_;
@@ -327,8 +390,36 @@ class MmapAllocator : public MemoryAllocator {
 
     // Cumulative count of madvise for pages of 'this'
     uint64_t numAdvisedAway_ = 0;
+
+    // Cumulative count of huge pages advised away as a whole.
+    uint64_t numHugePagesAdvisedAway_ = 0;
   };
 
+  // A shard of the page cache. Holds the addresses of freed size class pages
+  // by size class index.
+  struct alignas(folly::hardware_destructive_interference_size)
+      PageCacheShard {
+    std::mutex mutex;
+    // Number of machine pages cached in 'this'.
+    MachinePageCount numPages{0};
+    std::array<std::vector<uint8_t*>, kMaxSizeClasses> pages;
+  };
+
+  // Returns the page cache shard of the calling thread. Threads are assigned
+  // shards round robin. Driver and executor threads are long lived, so each
+  // shard is mostly used by the same few threads.
+  PageCacheShard& pageCacheShard();
+
+  // Moves the size class pages of 'allocation' into the page cache of the
+  // calling thread while it has room and removes them from 'allocation'.
+  // Returns the number of cached machine pages.
+  MachinePageCount cacheFreedPages(Allocation& allocation);
+
+  // Allocates 'mix' from the page cache of the calling thread into 'out'.
+  // Returns false and leaves 'out' empty if the shard does not hold all the
+  // size class pages of 'mix'.
+  bool allocateFromCache(const SizeMix& mix, Allocation& out);
+
   bool allocateContiguousImpl(
       MachinePageCount numPages,
       Allocation* collateral,
@@ -365,6 +456,10 @@ class MmapAllocator : public MemoryAllocator {
   // issued for each such allocation.
   const bool useMmapArena_;
 
+  // If set true, the size classes of at least 'kMinHugePageSizeClass' pages
+  // are backed by transparent huge pages.
+  const bool useHugePages_;
+
   // Serializes moving capacity between size classes
   std::mutex sizeClassBalanceMutex_;
 
@@ -396,6 +491,18 @@ class MmapAllocator : public MemoryAllocator {
 
   std::vector<std::unique_ptr<SizeClass>> sizeClasses_;
 
+  // Max number of machine pages in one shard of 'pageCache_'.
+  const MachinePageCount pageCacheShardPages_;
+
+  // Per thread caches of freed size class pages. Empty if the page cache is
+  // disabled.
+  std::vector<std::unique_ptr<PageCacheShard>> pageCache_;
+
+  // Number of machine pages in 'pageCache_'.
+  std::atomic<MachinePageCount> numCachedPages_{0};
+
+  std::atomic<uint64_t> numPageCacheHits_{0};
+
   // Statistics.
   std::atomic<uint64_t> numAllocations_ = 0;
   std::atomic<uint64_t> numAllocatedPages_ = 0;
@@ -116,6 +116,10 @@ SharedArbitrator::findCandidateWithLargestCapacity(
 }
 
 SharedArbitrator::~SharedArbitrator() {
+  {
+    std::unique_lock<std::mutex> l(mutex_);
+    proactiveReclaimCv_.wait(l, [&]() { return !proactiveReclaimRunning_; });
+  }
   VELOX_CHECK_EQ(freeCapacity_, capacity_, "{}", toString());
 }
 
@@ -180,6 +184,7 @@ bool SharedArbitrator::growMemory(
     // Get refreshed stats before the memory arbitration retry.
     candidates = getCandidateStats(candidatePools);
     if (arbitrateMemory(requestor, candidates, targetBytes)) {
+      maybeStartProactiveReclaim(requestor, candidatePools);
       return true;
     }
     if (!retryArbitrationFailure_ || numRetries > 0) {
@@ -272,6 +277,12 @@ bool SharedArbitrator::arbitrateMemory(
     }
   });
 
+  if (allocator_ != nullptr) {
+    // Short of free capacity. Return the freed memory cached by the allocator
+    // so that the capacity moved to the requestor is backed by free pages.
+    allocator_->flushCache();
+  }
+
   freedBytes +=
       reclaimFreeMemoryFromCandidates(candidates, growTarget - freedBytes);
   if (freedBytes >= targetBytes) {
@@ -349,13 +360,94 @@ uint64_t SharedArbitrator::reclaimUsedMemoryFromCandidates(
         targetBytes - freedBytes, minMemoryPoolCapacityTransferSize_);
     VELOX_CHECK_GT(bytesToReclaim, 0);
     freedBytes += reclaim(candidate.pool, bytesToReclaim);
-    if ((freedBytes >= targetBytes) || requestor->aborted()) {
+    if ((freedBytes >= targetBytes) ||
+        (requestor != nullptr && requestor->aborted())) {
       break;
     }
   }
   return freedBytes;
 }
 
+void SharedArbitrator::maybeStartProactiveReclaim(
+    MemoryPool* requestor,
+    const std::vector<std::shared_ptr<MemoryPool>>& candidatePools) {
+  if (proactiveReclaimExecutor_ == nullptr ||
+      proactiveReclaimHighWaterBytes_ == 0) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (proactiveReclaimRunning_ ||
+        capacity_ - freeCapacity_ <= proactiveReclaimHighWaterBytes_) {
+      return;
+    }
+    proactiveReclaimRunning_ = true;
+  }
+  // NOTE: the background reclaim holds weak references so that it does not
+  // delay the destruction of the finished queries' memory pools.
+  std::vector<std::weak_ptr<MemoryPool>> pools;
+  pools.reserve(candidatePools.size());
+  for (const auto& pool : candidatePools) {
+    if (pool.get() != requestor) {
+      pools.push_back(pool);
+    }
+  }
+  proactiveReclaimExecutor_->add(
+      [this, pools = std::move(pools)]() { proactiveReclaim(pools); });
+}
+
+void SharedArbitrator::proactiveReclaim(
+    const std::vector<std::weak_ptr<MemoryPool>>& weakPools) {
+  auto runningGuard = folly::makeGuard([&]() {
+    std::lock_guard<std::mutex> l(mutex_);
+    proactiveReclaimRunning_ = false;
+    proactiveReclaimCv_.notify_all();
+  });
+  std::vector<std::shared_ptr<MemoryPool>> pools;
+  pools.reserve(weakPools.size());
+  for (const auto& weakPool : weakPools) {
+    auto pool = weakPool.lock();
+    if (pool != nullptr && !pool->aborted()) {
+      pools.push_back(std::move(pool));
+    }
+  }
+  if (pools.empty()) {
+    return;
+  }
+
+  startArbitration(nullptr);
+  auto arbitrationGuard = folly::makeGuard([&]() { finishArbitration(); });
+  uint64_t targetBytes;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    const uint64_t grantedBytes = capacity_ - freeCapacity_;
+    if (grantedBytes <= proactiveReclaimLowWaterBytes_) {
+      return;
+    }
+    targetBytes = grantedBytes - proactiveReclaimLowWaterBytes_;
+  }
+
+  uint64_t reclaimTimeUs{0};
+  uint64_t freedBytes{0};
+  try {
+    MicrosecondTimer timer(&reclaimTimeUs);
+    auto candidates = getCandidateStats(pools);
+    freedBytes = reclaimFreeMemoryFromCandidates(candidates, targetBytes);
+    if (freedBytes < targetBytes) {
+      freedBytes += reclaimUsedMemoryFromCandidates(
+          nullptr, candidates, targetBytes - freedBytes);
+    }
+  } catch (const std::exception& e) {
+    VELOX_MEM_LOG(WARNING) << "Background memory reclaim failed: "
+                           << e.what();
+  }
+  incrementFreeCapacity(freedBytes);
+  ++numProactiveReclaims_;
+  numProactiveReclaimedBytes_ += freedBytes;
+  std::lock_guard<std::mutex> l(mutex_);
+  proactiveReclaimTimeHistogram_.record(reclaimTimeUs);
+}
+
 uint64_t SharedArbitrator::reclaim(
     MemoryPool* pool,
     uint64_t targetBytes) noexcept {
@@ -440,6 +532,11 @@ MemoryArbitrator::Stats SharedArbitrator::statsLocked() const {
   stats.numReclaimedBytes = numReclaimedBytes_;
   stats.maxCapacityBytes = capacity_;
   stats.freeCapacityBytes = freeCapacity_;
+  stats.queueTimeHistogram = queueTimeHistogram_;
+  stats.arbitrationTimeHistogram = arbitrationTimeHistogram_;
+  stats.numProactiveReclaims = numProactiveReclaims_;
+  stats.numProactiveReclaimedBytes = numProactiveReclaimedBytes_;
+  stats.proactiveReclaimTimeHistogram = proactiveReclaimTimeHistogram_;
   return stats;
 }
 
@@ -473,27 +570,50 @@ SharedArbitrator::ScopedArbitration::~ScopedArbitration() {
       std::chrono::duration_cast<std::chrono::microseconds>(
           std::chrono::steady_clock::now() - startTime_);
   arbitrator_->arbitrationTimeUs_ += arbitrationTime.count();
+  {
+    std::lock_guard<std::mutex> l(arbitrator_->mutex_);
+    arbitrator_->arbitrationTimeHistogram_.record(arbitrationTime.count());
+  }
   arbitrator_->finishArbitration();
 }
 
 void SharedArbitrator::startArbitration(MemoryPool* requestor) {
-  requestor->enterArbitration();
+  if (requestor != nullptr) {
+    requestor->enterArbitration();
+  }
   ContinueFuture waitPromise{ContinueFuture::makeEmpty()};
   {
     std::lock_guard<std::mutex> l(mutex_);
-    ++numRequests_;
+    if (requestor != nullptr) {
+      ++numRequests_;
+    }
     if (running_) {
-      waitPromises_.emplace_back(fmt::format(
-          "Wait for arbitration, requestor: {}[{}]",
-          requestor->name(),
-          requestor->root()->name()));
+      if (requestor == nullptr) {
+        waitPromises_.emplace_back(
+            "Wait for arbitration, requestor: background reclaim");
+      } else {
+        waitPromises_.emplace_back(fmt::format(
+            "Wait for arbitration, requestor: {}[{}]",
+            requestor->name(),
+            requestor->root()->name()));
+      }
       waitPromise = waitPromises_.back().getSemiFuture();
     } else {
       VELOX_CHECK(waitPromises_.empty());
       running_ = true;
+      if (requestor != nullptr) {
+        queueTimeHistogram_.record(0);
+      }
     }
   }
 
+  if (requestor == nullptr) {
+    if (waitPromise.valid()) {
+      waitPromise.wait();
+    }
+    return;
+  }
+
   TestValue::adjust(
       "facebook::velox::memory::SharedArbitrator::startArbitration", requestor);
 
@@ -504,6 +624,8 @@ void SharedArbitrator::startArbitration(MemoryPool* requestor) {
       waitPromise.wait();
     }
     queueTimeUs_ += waitTimeUs;
+    std::lock_guard<std::mutex> l(mutex_);
+    queueTimeHistogram_.record(waitTimeUs);
   }
 }
 
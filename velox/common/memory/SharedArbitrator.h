@@ -18,6 +18,8 @@
 
 #include "velox/common/memory/MemoryArbitrator.h"
 
+#include <condition_variable>
+
 #include "velox/common/future/VeloxPromise.h"
 #include "velox/common/memory/Memory.h"
 
@@ -104,7 +106,7 @@ class SharedArbitrator : public MemoryArbitrator {
 
   // Invoked to start next memory arbitration request, and it will wait for the
   // serialized execution if there is a running or other waiting arbitration
-  // requests.
+  // requests. 'requestor' is null for a background reclaim.
   void startArbitration(MemoryPool* requestor);
 
   // Invoked by a finished memory arbitration request to kick off the next
@@ -120,7 +122,8 @@ class SharedArbitrator : public MemoryArbitrator {
       std::vector<Candidate>& candidates,
       uint64_t targetBytes);
 
-  // Invoked to reclaim used memory capacity from 'candidates'.
+  // Invoked to reclaim used memory capacity from 'candidates'. 'requestor' is
+  // null for a background reclaim.
   //
   // NOTE: the function might sort 'candidates' based on each candidate's
   // reclaimable memory internally.
@@ -129,6 +132,19 @@ class SharedArbitrator : public MemoryArbitrator {
       std::vector<Candidate>& candidates,
       uint64_t targetBytes);
 
+  // Invoked after 'requestor' has grown its capacity to schedule a background
+  // reclaim from the other 'candidatePools' on 'proactiveReclaimExecutor_' if
+  // the capacity granted to the memory pools is above the high-water mark and
+  // there is no background reclaim running.
+  void maybeStartProactiveReclaim(
+      MemoryPool* requestor,
+      const std::vector<std::shared_ptr<MemoryPool>>& candidatePools);
+
+  // Runs a background reclaim which frees capacity from 'pools' that are still
+  // alive until the granted capacity is down to the low-water mark. It is
+  // serialized with the arbitration requests.
+  void proactiveReclaim(const std::vector<std::weak_ptr<MemoryPool>>& pools);
+
   // Invoked to reclaim used memory from 'pool' with specified 'targetBytes'.
   // The function returns the actually freed capacity.
   uint64_t reclaim(MemoryPool* pool, uint64_t targetBytes) noexcept;
@@ -166,6 +182,16 @@ class SharedArbitrator : public MemoryArbitrator {
   // execution.
   std::vector<ContinuePromise> waitPromises_;
 
+  // Indicates if there is a scheduled or running background reclaim. The
+  // destructor waits on 'proactiveReclaimCv_' for it to finish.
+  bool proactiveReclaimRunning_{false};
+  std::condition_variable proactiveReclaimCv_;
+
+  // The latency distributions, guarded by 'mutex_'.
+  LatencyHistogram queueTimeHistogram_;
+  LatencyHistogram arbitrationTimeHistogram_;
+  LatencyHistogram proactiveReclaimTimeHistogram_;
+
   tsan_atomic<uint64_t> numRequests_{0};
   tsan_atomic<uint64_t> numAborted_{0};
   std::atomic<uint64_t> numFailures_{0};
@@ -173,5 +199,7 @@ class SharedArbitrator : public MemoryArbitrator {
   tsan_atomic<uint64_t> arbitrationTimeUs_{0};
   tsan_atomic<uint64_t> numShrunkBytes_{0};
   tsan_atomic<uint64_t> numReclaimedBytes_{0};
+  tsan_atomic<uint64_t> numProactiveReclaims_{0};
+  tsan_atomic<uint64_t> numProactiveReclaimedBytes_{0};
 };
 } // namespace facebook::velox::memory
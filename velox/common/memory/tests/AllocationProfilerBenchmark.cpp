@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include "velox/common/memory/Memory.h"
+
+/// Measures the overhead of an AllocationProfiler on MemoryPool allocate()
+/// and free() of small buffers. The parameter is the sampling interval in
+/// bytes. 0 means no profiler and is the baseline of the relative numbers.
+
+using namespace facebook::velox;
+
+namespace {
+
+constexpr int64_t kAllocationSize = 128;
+
+void allocateAndFree(uint32_t iters, uint64_t sampleIntervalBytes) {
+  folly::BenchmarkSuspender suspender;
+  auto root = memory::defaultMemoryManager().addRootPool();
+  if (sampleIntervalBytes > 0) {
+    root->setAllocationProfiler(
+        std::make_shared<memory::AllocationProfiler>(sampleIntervalBytes));
+  }
+  auto pool = root->addLeafChild("leaf");
+  suspender.dismiss();
+
+  for (auto counter = 0; counter < iters; ++counter) {
+    auto* buffer = pool->allocate(kAllocationSize);
+    folly::doNotOptimizeAway(buffer);
+    pool->free(buffer, kAllocationSize);
+  }
+}
+
+} // namespace
+
+BENCHMARK_PARAM(allocateAndFree, 0);
+BENCHMARK_RELATIVE_PARAM(allocateAndFree, 1 << 30);
+BENCHMARK_RELATIVE_PARAM(allocateAndFree, 512 << 10);
+BENCHMARK_RELATIVE_PARAM(allocateAndFree, 64 << 10);
+BENCHMARK_RELATIVE_PARAM(allocateAndFree, 4 << 10);
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -16,8 +16,11 @@
 
 #include <deque>
 
+#include <folly/Benchmark.h>
+
 #include "velox/common/memory/Memory.h"
 #include "velox/common/memory/MmapAllocator.h"
+#include "velox/common/memory/tests/TlbMissCounter.h"
 #include "velox/common/time/Timer.h"
 
 DEFINE_uint64(
@@ -34,6 +37,15 @@ DEFINE_uint32(
     memory_allocator_type,
     0,
     "The type of memory allocator. 0 is malloc allocator, 1 is mmap allocator");
+DEFINE_bool(
+    use_huge_pages,
+    false,
+    "Back the large size classes of the mmap allocator with huge pages");
+DEFINE_uint32(
+    num_probes_per_allocation,
+    0,
+    "The number of random reads from the live allocations of a thread after "
+    "each allocation. Used to compare TLB misses with and without huge pages");
 DEFINE_uint32(
     num_runs,
     32,
@@ -49,10 +61,12 @@ class MemoryOperator {
       MemoryManager* memoryManager,
       uint64_t maxMemory,
       uint64_t allocationSize,
-      uint32_t maxOps)
+      uint32_t maxOps,
+      uint32_t numProbesPerAllocation)
       : maxMemory_(maxMemory),
         allocationBytes_(allocationSize),
         maxOps_(maxOps),
+        numProbesPerAllocation_(numProbesPerAllocation),
         pool_(memoryManager->addLeafPool(
             fmt::format("MemoryOperator{}", poolId_++))) {
     rng_.seed(1234);
@@ -66,6 +80,10 @@ class MemoryOperator {
     return clockCount_;
   }
 
+  uint64_t probeClockCount() const {
+    return probeClockCount_;
+  }
+
  private:
   struct Allocation {
     void* ptr;
@@ -79,6 +97,9 @@ class MemoryOperator {
 
   void free();
 
+  // Reads 'numProbesPerAllocation_' random words from the live allocations.
+  void probe();
+
   void cleanup();
 
   static inline int32_t poolId_{0};
@@ -86,12 +107,14 @@ class MemoryOperator {
   const uint64_t maxMemory_;
   const size_t allocationBytes_;
   const uint32_t maxOps_;
+  const uint32_t numProbesPerAllocation_;
   const std::shared_ptr<MemoryPool> pool_;
 
   folly::Random::DefaultGenerator rng_;
   uint64_t allocatedBytes_{0};
   std::deque<Allocation> allocations_;
   uint64_t clockCount_{0};
+  uint64_t probeClockCount_{0};
 };
 
 void MemoryOperator::run() {
@@ -110,6 +133,23 @@ void MemoryOperator::allocate() {
     allocations_.emplace_back(pool_->allocate(allocationBytes_));
   }
   allocatedBytes_ += allocationBytes_;
+  probe();
+}
+
+void MemoryOperator::probe() {
+  if (numProbesPerAllocation_ == 0) {
+    return;
+  }
+  const auto numWords = allocationBytes_ / sizeof(int64_t);
+  int64_t sum = 0;
+  ClockTimer probeTimer(probeClockCount_);
+  for (auto i = 0; i < numProbesPerAllocation_; ++i) {
+    const auto& allocation =
+        allocations_[folly::Random::rand32(rng_) % allocations_.size()];
+    sum += reinterpret_cast<const int64_t*>(
+        allocation.ptr)[folly::Random::rand64(rng_) % numWords];
+  }
+  folly::doNotOptimizeAway(sum);
 }
 
 void MemoryOperator::free() {
@@ -150,6 +190,8 @@ class MemoryAllocationBenchMark {
     uint64_t allocationBytes;
     uint32_t numThreads;
     uint32_t numOpsPerThread;
+    bool useHugePages;
+    uint32_t numProbesPerAllocation;
   };
 
   explicit MemoryAllocationBenchMark(const Options& options)
@@ -159,6 +201,7 @@ class MemoryAllocationBenchMark {
       case Type::kMmap: {
         memory::MmapAllocator::Options mmapOptions;
         mmapOptions.capacity = maxMemory;
+        mmapOptions.useHugePages = options_.useHugePages;
         allocator_ = std::make_shared<MmapAllocator>(mmapOptions);
         manager_ = std::make_shared<MemoryManager>(IMemoryManager::Options{
             .capacity = maxMemory, .allocator = allocator_.get()});
@@ -185,6 +228,8 @@ class MemoryAllocationBenchMark {
   struct Result {
     uint64_t runTimeUs;
     uint64_t clockCount;
+    uint64_t probeClockCount;
+    uint64_t tlbMisses;
   };
 
   const Options options_;
@@ -200,6 +245,9 @@ void MemoryAllocationBenchMark::run() {
   operators.reserve(options_.numThreads);
   uint64_t runTimeUs{0};
   uint64_t clockCount{0};
+  uint64_t probeClockCount{0};
+  memory::test::TlbMissCounter tlbMisses;
+  tlbMisses.start();
   {
     MicrosecondTimer clock(&runTimeUs);
     for (int i = 0; i < options_.numThreads; ++i) {
@@ -207,7 +255,8 @@ void MemoryAllocationBenchMark::run() {
           manager_.get(),
           options_.maxMemory / options_.numThreads,
           options_.allocationBytes,
-          options_.numOpsPerThread);
+          options_.numOpsPerThread,
+          options_.numProbesPerAllocation);
       memThreads.push_back(
           std::thread([rawOp = memOp.get()]() { rawOp->run(); }));
       operators.push_back(std::move(memOp));
@@ -216,25 +265,34 @@ void MemoryAllocationBenchMark::run() {
       memThreads[i].join();
     }
   }
+  const auto numTlbMisses = tlbMisses.stop();
   for (const auto& op : operators) {
     clockCount += op->clockCount();
+    probeClockCount += op->probeClockCount();
   }
 
-  results_.push_back({runTimeUs, clockCount});
+  results_.push_back({runTimeUs, clockCount, probeClockCount, numTlbMisses});
 }
 
 void MemoryAllocationBenchMark::printStats() {
   double sumRunTumeMs{0};
   double sumClockCount{0};
+  double sumProbeClockCount{0};
+  double sumTlbMisses{0};
   for (const auto& result : results_) {
     sumRunTumeMs += result.runTimeUs / 1000;
     sumClockCount += result.clockCount;
+    sumProbeClockCount += result.probeClockCount;
+    sumTlbMisses += result.tlbMisses;
   }
   const uint64_t avgRunTimeMs = sumRunTumeMs / results_.size();
   const uint64_t avgClockCount = sumClockCount / results_.size();
-  LOG(INFO) << "\n\t\tSIZE\t\tTIME\t\tCLOCK\n\t\t"
-            << succinctBytes(options_.allocationBytes) << "\t\t"
-            << succinctMillis(avgRunTimeMs) << "\t\t" << avgClockCount;
+  const uint64_t avgProbeClockCount = sumProbeClockCount / results_.size();
+  const uint64_t avgTlbMisses = sumTlbMisses / results_.size();
+  LOG(INFO) << "\n\t\tSIZE\t\tTIME\t\tCLOCK\t\tPROBE CLOCK\t\tDTLB MISSES"
+            << "\n\t\t" << succinctBytes(options_.allocationBytes) << "\t\t"
+            << succinctMillis(avgRunTimeMs) << "\t\t" << avgClockCount
+            << "\t\t" << avgProbeClockCount << "\t\t" << avgTlbMisses;
 }
 } // namespace
 
@@ -248,6 +306,8 @@ int main(int argc, char* argv[]) {
       ? MemoryAllocationBenchMark::Type::kMalloc
       : MemoryAllocationBenchMark::Type::kMmap;
   options.numOpsPerThread = FLAGS_num_allocations_per_thread;
+  options.useHugePages = FLAGS_use_huge_pages;
+  options.numProbesPerAllocation = FLAGS_num_probes_per_allocation;
   auto benchmark = std::make_unique<MemoryAllocationBenchMark>(options);
   for (int i = 0; i < FLAGS_num_runs; ++i) {
     benchmark->run();
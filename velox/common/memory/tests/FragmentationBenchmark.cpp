@@ -19,16 +19,28 @@
 #include <map>
 #include <vector>
 
+#include <folly/Benchmark.h>
 #include <folly/CPortability.h>
 #include <gflags/gflags.h>
 #include <glog/logging.h>
 #include "folly/Random.h"
 
 #include "velox/common/memory/MmapAllocator.h"
+#include "velox/common/memory/tests/TlbMissCounter.h"
+#include "velox/common/time/Timer.h"
 
 DEFINE_int64(volume_gb, 2048, "Total GB to allocate during test");
 DEFINE_int64(size_cap_gb, 24, "Size cap: total GB resident at one time");
 DEFINE_bool(use_mmap, true, "Use mmap and madvise to manage fragmentation");
+DEFINE_bool(
+    use_huge_pages,
+    false,
+    "Back the large size classes of the mmap allocator with huge pages");
+DEFINE_int64(
+    num_probes,
+    100'000'000,
+    "Number of random reads over the resident blocks after the allocation "
+    "phase. Reports the time and data TLB misses of the reads");
 
 using namespace facebook::velox;
 using namespace facebook::velox::memory;
@@ -147,15 +159,16 @@ class FragmentationTest {
     return *it >> 10;
   }
 
-  void initMemory(size_t sizeCap) {
+  void initMemory(size_t sizeCap, bool useHugePages) {
     MmapAllocator::Options options;
     options.capacity = sizeCap + (64 << 20);
+    options.useHugePages = useHugePages;
     memory_ = std::make_shared<MmapAllocator>(options);
   }
 
-  void run(uint64_t total, size_t sizeCap, bool useMmap) {
+  void run(uint64_t total, size_t sizeCap, bool useMmap, bool useHugePages) {
     if (useMmap) {
-      initMemory(sizeCap);
+      initMemory(sizeCap, useHugePages);
     }
     sizeCap_ = sizeCap;
     uint64_t allocated = 0;
@@ -168,6 +181,35 @@ class FragmentationTest {
     }
   }
 
+  // Reads 'numProbes' random words from the resident blocks, like a hash
+  // table probe would, and prints the time and the TLB misses it took.
+  void probe(int64_t numProbes) {
+    if (blocks_.empty() || numProbes == 0) {
+      return;
+    }
+    memory::test::TlbMissCounter tlbMisses;
+    uint64_t sum = 0;
+    uint64_t elapsedUs = 0;
+    tlbMisses.start();
+    {
+      MicrosecondTimer timer(&elapsedUs);
+      for (int64_t i = 0; i < numProbes; ++i) {
+        const auto& block =
+            blocks_[folly::Random::rand32(rng_) % blocks_.size()];
+        sum += *randomWord(*block);
+      }
+    }
+    const auto numMisses = tlbMisses.stop();
+    folly::doNotOptimizeAway(sum);
+    std::cout << numProbes << " probes in " << elapsedUs / 1000 << "ms";
+    if (tlbMisses.available()) {
+      std::cout << ", " << numMisses << " dTLB misses";
+    } else {
+      std::cout << ", dTLB misses not available";
+    }
+    std::cout << std::endl;
+  }
+
   std::string sizeString(size_t size) {
     char str[20];
     if (size < 1 << 20) {
@@ -178,6 +220,26 @@ class FragmentationTest {
     return str;
   }
 
+ private:
+  const int64_t* randomWord(const Block& block) {
+    const char* data;
+    size_t size;
+    if (block.allocation != nullptr) {
+      const auto run = block.allocation->runAt(
+          folly::Random::rand32(rng_) % block.allocation->numRuns());
+      data = run.data<char>();
+      size = AllocationTraits::pageBytes(run.numPages());
+    } else if (!block.contiguous.empty()) {
+      data = block.contiguous.data<char>();
+      size = block.contiguous.size();
+    } else {
+      data = block.data;
+      size = block.size;
+    }
+    const auto offset = folly::Random::rand64(rng_) % (size / sizeof(int64_t));
+    return reinterpret_cast<const int64_t*>(data) + offset;
+  }
+
  public:
   void printStats() {
     for (auto& pair : stats_) {
@@ -201,7 +263,12 @@ int main(int argc, char* argv[]) {
   gflags::ParseCommandLineFlags(&argc, &argv, true);
   auto test = std::make_unique<FragmentationTest>();
   test->SetUp();
-  test->run(FLAGS_volume_gb << 30, FLAGS_size_cap_gb << 30, FLAGS_use_mmap);
+  test->run(
+      FLAGS_volume_gb << 30,
+      FLAGS_size_cap_gb << 30,
+      FLAGS_use_mmap,
+      FLAGS_use_huge_pages);
   test->printStats();
+  test->probe(FLAGS_num_probes);
   return 0;
 }
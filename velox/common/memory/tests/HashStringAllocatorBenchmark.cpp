@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/Random.h>
+#include <folly/init/Init.h>
+
+#include "velox/common/memory/HashStringAllocator.h"
+
+/// Measures HashStringAllocator allocate() and free() on a fragmented free
+/// list, like array_agg or map_agg accumulators of many groups growing at
+/// different rates. The parameter is the number of live blocks. Half of the
+/// blocks are freed at random before timing, so that the free blocks are
+/// interleaved with live ones of all sizes. Each timed iteration frees a
+/// random live block and allocates one of a random size.
+
+using namespace facebook::velox;
+
+namespace {
+
+int32_t randomSize(folly::Random::DefaultGenerator& rng) {
+  // Mostly small values with some larger ones, like strings and arrays.
+  return folly::Random::oneIn(10, rng) ? 500 + folly::Random::rand32(3000, rng)
+                                       : 16 + folly::Random::rand32(200, rng);
+}
+
+void allocateAndFree(uint32_t iters, int32_t numBlocks) {
+  folly::BenchmarkSuspender suspender;
+  auto pool = memory::addDefaultLeafMemoryPool();
+  HashStringAllocator allocator(pool.get());
+  folly::Random::DefaultGenerator rng(1);
+
+  std::vector<HashStringAllocator::Header*> blocks;
+  blocks.reserve(numBlocks * 2);
+  for (auto i = 0; i < numBlocks * 2; ++i) {
+    blocks.push_back(allocator.allocate(randomSize(rng)));
+  }
+  for (auto i = 0; i < numBlocks; ++i) {
+    const auto index = folly::Random::rand32(blocks.size(), rng);
+    allocator.free(blocks[index]);
+    blocks[index] = blocks.back();
+    blocks.pop_back();
+  }
+  suspender.dismiss();
+
+  for (auto counter = 0; counter < iters; ++counter) {
+    const auto index = folly::Random::rand32(blocks.size(), rng);
+    allocator.free(blocks[index]);
+    blocks[index] = allocator.allocate(randomSize(rng));
+  }
+
+  suspender.rehire();
+  folly::doNotOptimizeAway(allocator.freeSpace());
+}
+
+} // namespace
+
+BENCHMARK_PARAM(allocateAndFree, 10'000);
+BENCHMARK_PARAM(allocateAndFree, 100'000);
+BENCHMARK_PARAM(allocateAndFree, 1'000'000);
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -109,6 +109,36 @@ TEST_F(HashStringAllocatorTest, allocate) {
   EXPECT_LE(instance_->retainedSize() - instance_->freeSpace(), 200);
 }
 
+TEST_F(HashStringAllocatorTest, fragmentedReuse) {
+  // Allocates blocks of sizes from 16 bytes to 16KB, frees every other one
+  // and allocates the freed sizes again. The free blocks are spread over
+  // many free lists and must be found without growing.
+  std::vector<HashStringAllocator::Header*> headers;
+  std::vector<int32_t> sizes;
+  for (auto i = 0; i < 20'000; ++i) {
+    sizes.push_back(16 << (i % 11));
+    headers.push_back(allocate(sizes.back()));
+  }
+  for (auto i = 0; i < headers.size(); i += 2) {
+    instance_->free(headers[i]);
+    headers[i] = nullptr;
+  }
+  instance_->checkConsistency();
+  const auto retained = instance_->retainedSize();
+  for (auto i = headers.size(); i-- > 0;) {
+    if (!headers[i]) {
+      headers[i] = allocate(sizes[i]);
+    }
+  }
+  instance_->checkConsistency();
+  EXPECT_EQ(retained, instance_->retainedSize());
+  for (auto* header : headers) {
+    instance_->free(header);
+  }
+  instance_->checkConsistency();
+  EXPECT_LE(instance_->retainedSize() - instance_->freeSpace(), 200);
+}
+
 TEST_F(HashStringAllocatorTest, allocateLarge) {
   // Verify that allocate() can handle sizes larger than the largest class size
   // supported by memory allocators, that is, 256 pages.
@@ -714,6 +714,106 @@ TEST_P(MemoryAllocatorTest, externalAdvise) {
   EXPECT_TRUE(instance->checkConsistency());
 }
 
+TEST_P(MemoryAllocatorTest, hugePageAdviseAway) {
+  if (!useMmap_) {
+    return;
+  }
+  MmapAllocator::Options options;
+  options.capacity = kCapacityBytes;
+  options.useHugePages = true;
+  auto allocator = std::make_shared<MmapAllocator>(options);
+  ASSERT_TRUE(allocator->hugePagesEnabled());
+  const auto capacityPages = AllocationTraits::numPages(allocator->capacity());
+  constexpr MachinePageCount kClassSize = MmapAllocator::kMinHugePageSizeClass;
+  std::vector<std::unique_ptr<Allocation>> allocations;
+  for (MachinePageCount i = 0; i < capacityPages / kClassSize; ++i) {
+    allocations.push_back(std::make_unique<Allocation>());
+    ASSERT_TRUE(allocator->allocateNonContiguous(
+        kClassSize, *allocations.back(), nullptr, kClassSize));
+  }
+  for (auto& allocation : allocations) {
+    allocator->freeNonContiguous(*allocation);
+  }
+  ASSERT_EQ(allocator->numAllocated(), 0);
+  ASSERT_EQ(allocator->numMapped(), capacityPages);
+
+  // Backing a contiguous allocation of one page more than a huge page advises
+  // away two whole huge pages of free size class pages instead of the 9 class
+  // pages that would cover it.
+  constexpr MachinePageCount kLargeSize = MmapAllocator::kHugePageSize + 1;
+  ContiguousAllocation large;
+  ASSERT_TRUE(allocator->allocateContiguous(kLargeSize, nullptr, large));
+  ASSERT_EQ(allocator->stats().numAdvise, 2 * MmapAllocator::kHugePageSize);
+  ASSERT_EQ(
+      allocator->numMapped(),
+      capacityPages + kLargeSize - 2 * MmapAllocator::kHugePageSize);
+  ASSERT_TRUE(allocator->checkConsistency());
+  allocator->freeContiguous(large);
+  ASSERT_EQ(
+      allocator->numMapped(), capacityPages - 2 * MmapAllocator::kHugePageSize);
+  ASSERT_TRUE(allocator->checkConsistency());
+
+  // The advised away pages can be allocated again.
+  for (auto& allocation : allocations) {
+    ASSERT_TRUE(allocator->allocateNonContiguous(
+        kClassSize, *allocation, nullptr, kClassSize));
+  }
+  ASSERT_EQ(allocator->numMapped(), capacityPages);
+  ASSERT_TRUE(allocator->checkConsistency());
+  for (auto& allocation : allocations) {
+    allocator->freeNonContiguous(*allocation);
+  }
+}
+
+TEST_P(MemoryAllocatorTest, pageCache) {
+  if (!useMmap_) {
+    return;
+  }
+  MmapAllocator::Options options;
+  options.capacity = kCapacityBytes;
+  options.pageCacheBytes = 64 << 20;
+  auto allocator = std::make_shared<MmapAllocator>(options);
+  constexpr MachinePageCount kNumPages = 8;
+  Allocation allocation;
+  ASSERT_TRUE(allocator->allocateNonContiguous(
+      kNumPages, allocation, nullptr, kNumPages));
+  auto* data = allocation.runAt(0).data();
+  ASSERT_EQ(
+      allocator->freeNonContiguous(allocation),
+      AllocationTraits::pageBytes(kNumPages));
+  ASSERT_TRUE(allocation.empty());
+  // The freed pages stay allocated in the cache.
+  ASSERT_EQ(allocator->numCachedPages(), kNumPages);
+  ASSERT_EQ(allocator->numAllocated(), kNumPages);
+  ASSERT_TRUE(allocator->checkConsistency());
+
+  // The same thread gets the cached pages back.
+  ASSERT_TRUE(allocator->allocateNonContiguous(
+      kNumPages, allocation, nullptr, kNumPages));
+  ASSERT_EQ(allocation.runAt(0).data(), data);
+  ASSERT_EQ(allocator->numPageCacheHits(), 1);
+  ASSERT_EQ(allocator->numCachedPages(), 0);
+  ASSERT_EQ(allocator->numAllocated(), kNumPages);
+  allocator->freeNonContiguous(allocation);
+  ASSERT_EQ(allocator->flushCache(), AllocationTraits::pageBytes(kNumPages));
+  ASSERT_EQ(allocator->numCachedPages(), 0);
+  ASSERT_EQ(allocator->numAllocated(), 0);
+  ASSERT_TRUE(allocator->checkConsistency());
+
+  // An allocation that needs the whole capacity flushes the cache.
+  ASSERT_TRUE(allocator->allocateNonContiguous(
+      kNumPages, allocation, nullptr, kNumPages));
+  allocator->freeNonContiguous(allocation);
+  ASSERT_EQ(allocator->numCachedPages(), kNumPages);
+  const auto capacityPages = AllocationTraits::numPages(allocator->capacity());
+  ContiguousAllocation large;
+  ASSERT_TRUE(allocator->allocateContiguous(capacityPages, nullptr, large));
+  ASSERT_EQ(allocator->numCachedPages(), 0);
+  ASSERT_EQ(allocator->numAllocated(), capacityPages);
+  allocator->freeContiguous(large);
+  ASSERT_TRUE(allocator->checkConsistency());
+}
+
 TEST_P(MemoryAllocatorTest, nonContiguousFailure) {
   struct {
     MachinePageCount numOldPages;
@@ -44,7 +44,35 @@ TEST_F(MemoryArbitrationTest, stats) {
   stats.numReclaimedBytes = 10'000;
   ASSERT_EQ(
       stats.toString(),
-      "STATS[numRequests 2 numAborted 3 numFailures 100 queueTime 230.00ms arbitrationTime 1.02ms shrunkMemory 95.37MB reclaimedMemory 9.77KB maxCapacity 0B freeCapacity 0B]");
+      "STATS[numRequests 2 numAborted 3 numFailures 100 queueTime 230.00ms arbitrationTime 1.02ms shrunkMemory 95.37MB reclaimedMemory 9.77KB maxCapacity 0B freeCapacity 0B queueTimeHistogram [count 0] arbitrationTimeHistogram [count 0] numProactiveReclaims 0 proactiveReclaimedMemory 0B proactiveReclaimTimeHistogram [count 0]]");
+}
+
+TEST_F(MemoryArbitrationTest, latencyHistogram) {
+  MemoryArbitrator::LatencyHistogram histogram;
+  ASSERT_EQ(histogram.count(), 0);
+  ASSERT_EQ(histogram.percentileUs(50), 0);
+  for (int i = 0; i < 90; ++i) {
+    histogram.record(500);
+  }
+  for (int i = 0; i < 9; ++i) {
+    histogram.record(3'000);
+  }
+  histogram.record(3'600'000'000);
+  ASSERT_EQ(histogram.count(), 100);
+  ASSERT_EQ(histogram.counts[0], 90);
+  ASSERT_EQ(histogram.counts[2], 9);
+  ASSERT_EQ(
+      histogram.counts[MemoryArbitrator::LatencyHistogram::kNumBuckets - 1],
+      1);
+  ASSERT_EQ(histogram.percentileUs(50), 1'000);
+  ASSERT_EQ(histogram.percentileUs(99), 4'000);
+  ASSERT_EQ(
+      histogram.percentileUs(100),
+      MemoryArbitrator::LatencyHistogram::bucketUpperBoundUs(
+          MemoryArbitrator::LatencyHistogram::kNumBuckets - 1));
+  ASSERT_EQ(
+      histogram.toString(),
+      "[count 100 p50 <1.00ms p90 <1.00ms p99 <4.00ms max <32.77s]");
 }
 
 TEST_F(MemoryArbitrationTest, kind) {
@@ -2109,6 +2109,70 @@ TEST(MemoryPoolTest, visitChildren) {
   });
 }
 
+TEST(MemoryPoolTest, allocationProfiler) {
+  MemoryManager manager{{.capacity = kMaxMemory}};
+  auto root = manager.addRootPool("root");
+  // Samples every allocation.
+  auto profiler = std::make_shared<AllocationProfiler>(1);
+  root->setAllocationProfiler(profiler);
+  ASSERT_EQ(root->allocationProfiler(), profiler.get());
+  auto smallPool = root->addLeafChild("small");
+  auto largePool = root->addLeafChild("large");
+  ASSERT_EQ(largePool->allocationProfiler(), profiler.get());
+  VELOX_ASSERT_THROW(
+      root->setAllocationProfiler(nullptr),
+      "Allocation profiler must be set before adding child pools");
+
+  constexpr int32_t kNumAllocs = 10;
+  std::vector<void*> buffers;
+  for (int32_t i = 0; i < kNumAllocs; ++i) {
+    buffers.push_back(smallPool->allocate(128));
+  }
+  Allocation allocation;
+  largePool->allocateNonContiguous(16, allocation);
+
+  const auto stats = profiler->poolStats();
+  ASSERT_EQ(stats.size(), 2);
+  ASSERT_EQ(stats[0].pool, "large");
+  ASSERT_EQ(stats[0].numSamples, 1);
+  ASSERT_EQ(stats[0].sampledBytes, allocation.byteSize());
+  ASSERT_EQ(stats[1].pool, "small");
+  ASSERT_EQ(stats[1].numSamples, kNumAllocs);
+  ASSERT_EQ(stats[1].sampledBytes, kNumAllocs * 128);
+  ASSERT_GE(stats[1].estimatedBytes, stats[1].sampledBytes);
+
+  ASSERT_THAT(profiler->toString(), HasSubstr("Top 2 allocation sites"));
+  const auto pprof = profiler->toPprof();
+  ASSERT_THAT(
+      pprof,
+      StartsWith(fmt::format(
+          "heap profile: {}: {} [",
+          kNumAllocs + 1,
+          kNumAllocs * 128 + allocation.byteSize())));
+  ASSERT_THAT(pprof, HasSubstr("@ heap_v2/1\n"));
+  ASSERT_THAT(pprof, HasSubstr("MAPPED_LIBRARIES:"));
+
+  profiler->clear();
+  ASSERT_TRUE(profiler->poolStats().empty());
+
+  // A profiler has its own countdown on each thread. The first allocation is
+  // not sampled just because it is the first one.
+  auto rareProfiler = std::make_shared<AllocationProfiler>(1L << 40);
+  auto rareRoot = manager.addRootPool("rareRoot");
+  rareRoot->setAllocationProfiler(rareProfiler);
+  auto rarePool = rareRoot->addLeafChild("rare");
+  auto* rareBuffer = rarePool->allocate(128);
+  buffers.push_back(smallPool->allocate(128));
+  ASSERT_TRUE(rareProfiler->poolStats().empty());
+  ASSERT_EQ(profiler->poolStats().size(), 1);
+  rarePool->free(rareBuffer, 128);
+
+  for (auto* buffer : buffers) {
+    smallPool->free(buffer, 128);
+  }
+  largePool->freeNonContiguous(allocation);
+}
+
 TEST(MemoryPoolTest, debugMode) {
   FLAGS_velox_memory_pool_debug_enabled = true;
   constexpr int64_t kMaxMemory = 10 * GB;
@@ -18,6 +18,7 @@
 
 #include <deque>
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include "folly/experimental/EventCount.h"
 #include "folly/futures/Barrier.h"
 #include "velox/common/base/tests/GTestUtils.h"
@@ -362,7 +363,10 @@ class MockSharedArbitrationTest : public testing::Test {
       int64_t memoryCapacity = 0,
       uint64_t initMemoryPoolCapacity = kMaxMemory,
       uint64_t minMemoryPoolCapacityTransferSize = 0,
-      bool retryArbitrationFailure = true) {
+      bool retryArbitrationFailure = true,
+      folly::Executor* proactiveReclaimExecutor = nullptr,
+      int32_t proactiveReclaimHighWaterPct = 0,
+      int32_t proactiveReclaimLowWaterPct = 0) {
     if (initMemoryPoolCapacity == kMaxMemory) {
       initMemoryPoolCapacity = kInitMemoryPoolCapacity;
     }
@@ -376,7 +380,10 @@ class MockSharedArbitrationTest : public testing::Test {
         .capacity = options.capacity,
         .initMemoryPoolCapacity = initMemoryPoolCapacity,
         .minMemoryPoolCapacityTransferSize = minMemoryPoolCapacityTransferSize,
-        .retryArbitrationFailure = retryArbitrationFailure};
+        .retryArbitrationFailure = retryArbitrationFailure,
+        .proactiveReclaimExecutor = proactiveReclaimExecutor,
+        .proactiveReclaimHighWaterPct = proactiveReclaimHighWaterPct,
+        .proactiveReclaimLowWaterPct = proactiveReclaimLowWaterPct};
     options.checkUsageLeak = true;
     manager_ = std::make_unique<MemoryManager>(options);
     ASSERT_EQ(manager_->arbitrator()->kind(), MemoryArbitrator::Kind::kShared);
@@ -864,6 +871,48 @@ TEST_F(MockSharedArbitrationTest, arbitrateWithMemoryReclaim) {
   }
 }
 
+TEST_F(MockSharedArbitrationTest, proactiveReclaim) {
+  const uint64_t memoryCapacity = 256 * MB;
+  folly::CPUThreadPoolExecutor executor(1);
+  setupMemory(
+      memoryCapacity,
+      kInitMemoryPoolCapacity,
+      kMinMemoryPoolCapacityTransferSize,
+      true,
+      &executor,
+      50,
+      25);
+  const int allocateSize = 8 * MB;
+  auto* coldOp = addMemoryOp();
+  while (coldOp->pool()->currentBytes() < memoryCapacity / 2) {
+    coldOp->allocate(allocateSize);
+  }
+  // The granted capacity is at the high-water mark but not above.
+  ASSERT_EQ(arbitrator_->stats().freeCapacityBytes, memoryCapacity / 2);
+
+  // The first growth of 'hotOp' beyond its initial capacity takes the granted
+  // capacity above the high-water mark and reclaims from 'coldOp' in the
+  // background down to the low-water mark.
+  auto* hotOp = addMemoryOp();
+  hotOp->allocate(kInitMemoryPoolCapacity);
+  hotOp->allocate(allocateSize);
+  executor.join();
+
+  const auto stats = arbitrator_->stats();
+  const uint64_t grantedBytes =
+      memoryCapacity / 2 + kInitMemoryPoolCapacity + allocateSize;
+  const uint64_t reclaimedBytes = grantedBytes - memoryCapacity / 4;
+  ASSERT_EQ(stats.numProactiveReclaims, 1);
+  ASSERT_EQ(stats.numProactiveReclaimedBytes, reclaimedBytes);
+  ASSERT_EQ(stats.proactiveReclaimTimeHistogram.count(), 1);
+  ASSERT_EQ(stats.freeCapacityBytes, memoryCapacity / 4 * 3);
+  ASSERT_EQ(coldOp->capacity(), memoryCapacity / 2 - reclaimedBytes);
+  ASSERT_EQ(stats.arbitrationTimeHistogram.count(), stats.numRequests);
+  ASSERT_EQ(stats.queueTimeHistogram.count(), stats.numRequests);
+  verifyReclaimerStats(coldOp->reclaimer()->stats(), 1, 14);
+  verifyReclaimerStats(hotOp->reclaimer()->stats(), 0, 1);
+}
+
 TEST_F(MockSharedArbitrationTest, arbitrateBySelfMemoryReclaim) {
   const std::vector<bool> isLeafReclaimables = {true, false};
   for (const auto isLeafReclaimable : isLeafReclaimables) {
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#ifdef linux
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace facebook::velox::memory::test {
+
+/// Counts user space data TLB load misses of the calling thread and of the
+/// threads it starts while counting. Used by the allocator benchmarks to
+/// compare huge page and machine page backing. available() is false if the
+/// kernel does not allow the perf event, e.g. because of
+/// perf_event_paranoid or when running in a VM without PMU access.
+class TlbMissCounter {
+ public:
+  TlbMissCounter() {
+#ifdef linux
+    perf_event_attr attr{};
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HW_CACHE;
+    attr.config = PERF_COUNT_HW_CACHE_DTLB |
+        (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+        (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    attr.disabled = 1;
+    attr.inherit = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    fd_ = ::syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+  }
+
+  ~TlbMissCounter() {
+#ifdef linux
+    if (fd_ >= 0) {
+      ::close(fd_);
+    }
+#endif
+  }
+
+  bool available() const {
+    return fd_ >= 0;
+  }
+
+  void start() {
+#ifdef linux
+    if (fd_ >= 0) {
+      ::ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+      ::ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+  }
+
+  /// Stops counting and returns the number of misses since start(). Misses of
+  /// threads started after start() are included once they have exited.
+  uint64_t stop() {
+    uint64_t count = 0;
+#ifdef linux
+    if (fd_ >= 0) {
+      ::ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+      if (::read(fd_, &count, sizeof(count)) != sizeof(count)) {
+        count = 0;
+      }
+    }
+#endif
+    return count;
+  }
+
+ private:
+  int32_t fd_{-1};
+};
+
+} // namespace facebook::velox::memory::test
@@ -90,19 +90,20 @@ void Connector::unregisterTracker(cache::ScanTracker* tracker) {
 
 std::shared_ptr<cache::ScanTracker> Connector::getTracker(
     const std::string& scanId,
-    int32_t loadQuantum) {
+    int32_t loadQuantum,
+    cache::FileGroupStats* fileGroupStats) {
   return trackers_.withWLock([&](auto& trackers) -> auto {
     auto it = trackers.find(scanId);
     if (it == trackers.end()) {
       auto newTracker = std::make_shared<cache::ScanTracker>(
-          scanId, unregisterTracker, loadQuantum);
+          scanId, unregisterTracker, loadQuantum, fileGroupStats);
       trackers[newTracker->id()] = newTracker;
       return newTracker;
     }
     std::shared_ptr<cache::ScanTracker> tracker = it->second.lock();
     if (!tracker) {
       tracker = std::make_shared<cache::ScanTracker>(
-          scanId, unregisterTracker, loadQuantum);
+          scanId, unregisterTracker, loadQuantum, fileGroupStats);
       trackers[tracker->id()] = tracker;
     }
     return tracker;
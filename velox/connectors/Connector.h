@@ -333,10 +333,12 @@ class Connector {
   // Returns a ScanTracker for 'id'. 'id' uniquely identifies the
   // tracker and different threads will share the same
   // instance. 'loadQuantum' is the largest single IO for the query
-  // being tracked.
+  // being tracked. A new tracker reports to 'fileGroupStats', the
+  // process-wide stats for SSD cache admission, if not null.
   static std::shared_ptr<cache::ScanTracker> getTracker(
       const std::string& scanId,
-      int32_t loadQuantum);
+      int32_t loadQuantum,
+      cache::FileGroupStats* FOLLY_NULLABLE fileGroupStats = nullptr);
 
   virtual folly::Executor* FOLLY_NULLABLE executor() const {
     return nullptr;
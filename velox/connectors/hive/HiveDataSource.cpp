@@ -17,6 +17,7 @@
 #include "velox/connectors/hive/HiveDataSource.h"
 
 #include "velox/common/caching/AsyncDataCache.h"
+#include "velox/common/caching/SsdCache.h"
 #include "velox/connectors/hive/HiveConnectorSplit.h"
 #include "velox/dwio/common/CachedBufferedInput.h"
 #include "velox/dwio/common/ReaderFactory.h"
@@ -680,7 +681,9 @@ std::unordered_map<std::string, RuntimeCounter> HiveDataSource::runtimeStats() {
         RuntimeCounter(
             ioStats_->rawOverreadBytes(), RuntimeCounter::Unit::kBytes)},
        {"queryThreadIoLatency",
-        RuntimeCounter(ioStats_->queryThreadIoLatency().count())}});
+        RuntimeCounter(ioStats_->queryThreadIoLatency().count())},
+       {"skippedRowGroupsByBloomFilter",
+        RuntimeCounter(ioStats_->skippedRowGroupsByBloomFilter())}});
   return res;
 }
 
@@ -777,13 +780,18 @@ HiveDataSource::createBufferedInput(
     const FileHandle& fileHandle,
     const dwio::common::ReaderOptions& readerOpts) {
   if (auto* asyncCache = dynamic_cast<cache::AsyncDataCache*>(allocator_)) {
+    // References and reads of the scan decide what the SSD cache admits.
+    auto* ssdCache = asyncCache->ssdCache();
     return std::make_unique<dwio::common::CachedBufferedInput>(
         fileHandle.file,
         readerOpts.getMemoryPool(),
         dwio::common::MetricsLog::voidLog(),
         fileHandle.uuid.id(),
         asyncCache,
-        Connector::getTracker(scanId_, readerOpts.loadQuantum()),
+        Connector::getTracker(
+            scanId_,
+            readerOpts.loadQuantum(),
+            ssdCache ? &ssdCache->groupStats() : nullptr),
         fileHandle.groupId.id(),
         ioStats_,
         executor_,
@@ -1980,6 +1980,10 @@ class WindowNode : public PlanNode {
     return windowFunctions_;
   }
 
+  bool canSpill(const QueryConfig& queryConfig) const override {
+    return queryConfig.windowSpillEnabled();
+  }
+
   std::string_view name() const override {
     return "Window";
   }
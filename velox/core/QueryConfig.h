@@ -69,6 +69,12 @@ class QueryConfig {
   static constexpr const char* kOperatorTrackCpuUsage =
       "track_operator_cpu_usage";
 
+  // If non-zero, samples on average one in every this many bytes allocated by
+  // a task and records the call stacks of the sampled allocations per
+  // operator. 0, i.e. disabled, by default.
+  static constexpr const char* kMemoryProfileSampleBytes =
+      "memory_profile_sample_bytes";
+
   // Flags used to configure the CAST operator:
 
   // This flag makes the Row conversion to by applied in a way that the casting
@@ -97,6 +103,12 @@ class QueryConfig {
   static constexpr const char* kAbandonPartialAggregationMinPct =
       "abandon_partial_aggregation_min_pct";
 
+  /// If true, partial aggregation tracks the reduction per hash partition of
+  /// the grouping keys and passes the rows of partitions that do not reduce
+  /// through as intermediate results while still aggregating the others.
+  static constexpr const char* kAdaptivePartialAggregationEnabled =
+      "adaptive_partial_aggregation_enabled";
+
   static constexpr const char* kMaxPartitionedOutputBufferSize =
       "max_page_partitioning_buffer_size";
 
@@ -124,6 +136,18 @@ class QueryConfig {
   static constexpr const char* kHashAdaptivityEnabled =
       "hash_adaptivity_enabled";
 
+  /// If true, the hash join build side produces Bloom filters over the join
+  /// keys if the hash table can't produce exact dynamic filters, e.g. for high
+  /// cardinality string or multi-key joins, and the probe side pushes them
+  /// down into the table scan.
+  static constexpr const char* kHashJoinBloomFilterPushdownEnabled =
+      "hash_join_bloom_filter_pushdown_enabled";
+
+  /// The max number of distinct build side keys to produce the join key Bloom
+  /// filters for. Each filter takes about 10 bits per key.
+  static constexpr const char* kHashJoinBloomFilterMaxEntries =
+      "hash_join_bloom_filter_max_entries";
+
   /// If true, the conjunction expression can reorder inputs based on the time
   /// taken to calculate them.
   static constexpr const char* kAdaptiveFilterReorderingEnabled =
@@ -142,6 +166,9 @@ class QueryConfig {
   /// OrderBy spilling flag, only applies if "spill_enabled" flag is set.
   static constexpr const char* kOrderBySpillEnabled = "order_by_spill_enabled";
 
+  /// Window spilling flag, only applies if "spill_enabled" flag is set.
+  static constexpr const char* kWindowSpillEnabled = "window_spill_enabled";
+
   /// The max memory that a final aggregation can use before spilling. If it 0,
   /// then there is no limit.
   static constexpr const char* kAggregationSpillMemoryThreshold =
@@ -157,6 +184,11 @@ class QueryConfig {
   static constexpr const char* kOrderBySpillMemoryThreshold =
       "order_by_spill_memory_threshold";
 
+  /// The max memory that a window can use before spilling. If it 0, then
+  /// there is no limit.
+  static constexpr const char* kWindowSpillMemoryThreshold =
+      "window_spill_memory_threshold";
+
   static constexpr const char* kTestingSpillPct = "testing.spill_pct";
 
   /// The max allowed spilling level with zero being the initial spilling level.
@@ -188,6 +220,11 @@ class QueryConfig {
   static constexpr const char* kSpillableReservationGrowthPct =
       "spillable_reservation_growth_pct";
 
+  /// The compression algorithm used to compress the spilled data. Supported
+  /// values are 'none', 'lz4', 'zstd' and 'snappy'.
+  static constexpr const char* kSpillCompressionKind =
+      "spill_compression_codec";
+
   /// If false, size function returns null for null input.
   static constexpr const char* kSparkLegacySizeOfNull =
       "spark.legacy_size_of_null";
@@ -210,6 +247,10 @@ class QueryConfig {
     return get<int32_t>(kAbandonPartialAggregationMinPct, 80);
   }
 
+  bool adaptivePartialAggregationEnabled() const {
+    return get<bool>(kAdaptivePartialAggregationEnabled, false);
+  }
+
   uint64_t aggregationSpillMemoryThreshold() const {
     static constexpr uint64_t kDefault = 0;
     return get<uint64_t>(kAggregationSpillMemoryThreshold, kDefault);
@@ -225,6 +266,11 @@ class QueryConfig {
     return get<uint64_t>(kOrderBySpillMemoryThreshold, kDefault);
   }
 
+  uint64_t windowSpillMemoryThreshold() const {
+    static constexpr uint64_t kDefault = 0;
+    return get<uint64_t>(kWindowSpillMemoryThreshold, kDefault);
+  }
+
   // Returns the target size for a Task's buffered output. The
   // producer Drivers are blocked when the buffered size exceeds
   // this. The Drivers are resumed when the buffered size goes below
@@ -256,6 +302,15 @@ class QueryConfig {
     return get<bool>(kHashAdaptivityEnabled, true);
   }
 
+  bool hashJoinBloomFilterPushdownEnabled() const {
+    return get<bool>(kHashJoinBloomFilterPushdownEnabled, false);
+  }
+
+  uint64_t hashJoinBloomFilterMaxEntries() const {
+    static constexpr uint64_t kDefault = 10'000'000;
+    return get<uint64_t>(kHashJoinBloomFilterMaxEntries, kDefault);
+  }
+
   uint32_t writeStrideSize() const {
     static constexpr uint32_t kDefault = 100'000;
     return kDefault;
@@ -325,6 +380,12 @@ class QueryConfig {
     return get<bool>(kOrderBySpillEnabled, true);
   }
 
+  /// Returns 'is window spilling enabled' flag. Must also check the
+  /// spillEnabled()!
+  bool windowSpillEnabled() const {
+    return get<bool>(kWindowSpillEnabled, true);
+  }
+
   // Returns a percentage of aggregation or join input batches that
   // will be forced to spill for testing. 0 means no extra spilling.
   int32_t testingSpillPct() const {
@@ -371,6 +432,11 @@ class QueryConfig {
     return get<double>(kSpillableReservationGrowthPct, kDefaultPct);
   }
 
+  /// Returns the name of the codec used to compress the spilled data.
+  std::string spillCompressionKind() const {
+    return get<std::string>(kSpillCompressionKind, "none");
+  }
+
   bool sparkLegacySizeOfNull() const {
     constexpr bool kDefault{true};
     return get<bool>(kSparkLegacySizeOfNull, kDefault);
@@ -384,6 +450,10 @@ class QueryConfig {
     return get<bool>(kOperatorTrackCpuUsage, true);
   }
 
+  uint64_t memoryProfileSampleBytes() const {
+    return get<uint64_t>(kMemoryProfileSampleBytes, 0);
+  }
+
   template <typename T>
   T get(const std::string& key, const T& defaultValue) const {
     return config_->get<T>(key, defaultValue);
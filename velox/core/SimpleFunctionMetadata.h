@@ -489,6 +489,7 @@ class UDFHolder final
   DECLARE_METHOD_RESOLVER(callNullable_method_resolver, callNullable);
   DECLARE_METHOD_RESOLVER(callNullFree_method_resolver, callNullFree);
   DECLARE_METHOD_RESOLVER(callAscii_method_resolver, callAscii);
+  DECLARE_METHOD_RESOLVER(callBatch_method_resolver, callBatch);
   DECLARE_METHOD_RESOLVER(initialize_method_resolver, initialize);
 
   // Check which flavor of the call() method is provided by the UDF object. UDFs
@@ -505,6 +506,7 @@ class UDFHolder final
   //
   // - bool|void callAscii(...)
   // - void initialize(...)
+  // - void callBatch(out*, args*..., size)
 
   // call():
   static constexpr bool udf_has_call_return_bool = util::has_method<
@@ -588,6 +590,26 @@ class UDFHolder final
         (udf_has_callAscii_return_void && udf_has_call_return_bool)),
       "The return type for callAscii() must match the return type for call().");
 
+  // callBatch(): Computes 'size' consecutive results from 'size' consecutive
+  // values of each argument. Used instead of call() when all arguments are
+  // flat and have no nulls, all rows are selected and the argument and result
+  // types are fixed-width primitives other than boolean. Lets the loop over
+  // rows be inlined into the UDF and vectorized by the compiler.
+  static constexpr bool udf_has_callBatch = util::has_method<
+      Fun,
+      callBatch_method_resolver,
+      void,
+      exec_return_type*,
+      const exec_arg_type<TArgs>*...,
+      int32_t>::value;
+
+  // callBatch() can't return nulls, so it must produce the same results as
+  // call() on rows that have no nulls.
+  static_assert(
+      !udf_has_callBatch ||
+          !(udf_has_call_return_bool || udf_has_callNullFree_return_bool),
+      "callBatch() requires call() and callNullFree() to return void.");
+
   // initialize():
   static constexpr bool udf_has_initialize = util::has_method<
       Fun,
@@ -714,6 +736,18 @@ class UDFHolder final
     }
   }
 
+  FOLLY_ALWAYS_INLINE void callBatch(
+      exec_return_type* out,
+      const typename exec_resolver<TArgs>::in_type*... args,
+      int32_t size) {
+    if constexpr (udf_has_callBatch) {
+      instance_.callBatch(out, args..., size);
+    } else {
+      VELOX_UNREACHABLE(
+          "callBatch should never be called if the UDF does not implement callBatch.");
+    }
+  }
+
   // Helper functions to handle void vs bool return type.
 
   FOLLY_ALWAYS_INLINE bool callImpl(
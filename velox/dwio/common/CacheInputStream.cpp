@@ -193,10 +193,16 @@ void CacheInputStream::loadSync(Region region) {
     }
     auto entry = pin_.checkedEntry();
     if (entry->isExclusive()) {
-      // Missed memory cache. Trying to load from ssd cache, and if again
-      // missed, fall back to remote fetching.
+      // Missed memory cache. Trying to load from the compressed copy of an
+      // evicted entry, then from ssd cache, and if again missed, fall back
+      // to remote fetching.
       entry->setGroupId(groupId_);
       entry->setTrackingId(trackingId_);
+      if (cache_->loadCompressed(*entry)) {
+        ioStats_->ramHit().increment(entry->size());
+        entry->setExclusiveToShared();
+        return;
+      }
       if (loadFromSsd(region, *entry)) {
         return;
       }
@@ -266,7 +272,10 @@ bool CacheInputStream::loadFromSsd(
     } catch (const std::exception&) {
       // Ignore error inside logging the error.
     }
-    throw;
+    // The entry is still exclusive. Fill it from storage instead, e.g. if
+    // the data on SSD does not match its checksum after a restart.
+    pin_ = std::move(pins[0]);
+    return false;
   }
   pin_ = std::move(pins[0]);
   ioStats_->ssdRead().increment(entry.size());
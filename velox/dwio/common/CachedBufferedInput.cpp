@@ -360,6 +360,31 @@ class DwioCoalescedLoadBase : public cache::CoalescedLoad {
     return keys;
   }
 
+  // Fills the entry of the exclusive 'pin' from a compressed copy kept when
+  // the entry was last evicted and moves 'pin' to 'filled'. Returns false if
+  // there is no such copy. Without this, the entry would be read again and
+  // the copy would stay behind as a stale duplicate.
+  bool loadCompressed(CachePin& pin, std::vector<CachePin>& filled) {
+    auto entry = pin.checkedEntry();
+    if (!cache_.loadCompressed(*entry)) {
+      return false;
+    }
+    if (ioStats_) {
+      ioStats_->ramHit().increment(entry->size());
+    }
+    filled.push_back(std::move(pin));
+    return true;
+  }
+
+  // Appends 'filled' to 'pins'.
+  static void appendPins(
+      std::vector<CachePin>& pins,
+      std::vector<CachePin>& filled) {
+    for (auto& pin : filled) {
+      pins.push_back(std::move(pin));
+    }
+  }
+
   std::vector<int32_t> makeSizes(std::vector<CacheRequest*> requests) {
     std::vector<int32_t> sizes;
     sizes.reserve(requests.size());
@@ -392,6 +417,7 @@ class DwioCoalescedLoad : public DwioCoalescedLoadBase {
 
   std::vector<CachePin> loadData(bool isPrefetch) override {
     std::vector<CachePin> pins;
+    std::vector<CachePin> filled;
     pins.reserve(keys_.size());
     cache_.makePins(
         keys_,
@@ -400,10 +426,12 @@ class DwioCoalescedLoad : public DwioCoalescedLoadBase {
           if (isPrefetch) {
             pin.checkedEntry()->setPrefetch(true);
           }
-          pins.push_back(std::move(pin));
+          if (!loadCompressed(pin, filled)) {
+            pins.push_back(std::move(pin));
+          }
         });
     if (pins.empty()) {
-      return pins;
+      return filled;
     }
     auto stats = cache::readPins(
         pins,
@@ -418,6 +446,7 @@ class DwioCoalescedLoad : public DwioCoalescedLoadBase {
           input_->read(buffers, offset, LogType::FILE);
         });
     updateStats(stats, isPrefetch, false);
+    appendPins(pins, filled);
     return pins;
   }
 
@@ -438,6 +467,7 @@ class SsdLoad : public DwioCoalescedLoadBase {
   std::vector<CachePin> loadData(bool isPrefetch) override {
     std::vector<SsdPin> ssdPins;
     std::vector<CachePin> pins;
+    std::vector<CachePin> filled;
     cache_.makePins(
         keys_,
         [&](int32_t index) { return sizes_[index]; },
@@ -445,15 +475,19 @@ class SsdLoad : public DwioCoalescedLoadBase {
           if (isPrefetch) {
             pin.checkedEntry()->setPrefetch(true);
           }
+          if (loadCompressed(pin, filled)) {
+            return;
+          }
           pins.push_back(std::move(pin));
           ssdPins.push_back(std::move(requests_[index].ssdPin));
         });
     if (pins.empty()) {
-      return pins;
+      return filled;
     }
     assert(!ssdPins.empty()); // for lint.
     auto stats = ssdPins[0].file()->load(ssdPins, pins);
     updateStats(stats, isPrefetch, true);
+    appendPins(pins, filled);
     return pins;
   }
 };
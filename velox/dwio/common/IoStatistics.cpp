@@ -46,6 +46,10 @@ uint64_t IoStatistics::totalScanTime() const {
   return totalScanTime_.load(std::memory_order_relaxed);
 }
 
+uint64_t IoStatistics::skippedRowGroupsByBloomFilter() const {
+  return skippedRowGroupsByBloomFilter_.load(std::memory_order_relaxed);
+}
+
 uint64_t IoStatistics::incRawBytesRead(int64_t v) {
   return rawBytesRead_.fetch_add(v, std::memory_order_relaxed);
 }
@@ -70,6 +74,10 @@ uint64_t IoStatistics::incTotalScanTime(int64_t v) {
   return totalScanTime_.fetch_add(v, std::memory_order_relaxed);
 }
 
+uint64_t IoStatistics::incSkippedRowGroupsByBloomFilter(int64_t v) {
+  return skippedRowGroupsByBloomFilter_.fetch_add(v, std::memory_order_relaxed);
+}
+
 void IoStatistics::incOperationCounters(
     const std::string& operation,
     const uint64_t resourceThrottleCount,
@@ -100,6 +108,7 @@ void IoStatistics::merge(const IoStatistics& other) {
   totalScanTime_ += other.totalScanTime_;
 
   rawOverreadBytes_ += other.rawOverreadBytes_;
+  skippedRowGroupsByBloomFilter_ += other.skippedRowGroupsByBloomFilter_;
   prefetch_.merge(other.prefetch_);
   read_.merge(other.read_);
   ramHit_.merge(other.ramHit_);
@@ -71,6 +71,7 @@ class IoStatistics {
   uint64_t inputBatchSize() const;
   uint64_t outputBatchSize() const;
   uint64_t totalScanTime() const;
+  uint64_t skippedRowGroupsByBloomFilter() const;
 
   uint64_t incRawBytesRead(int64_t);
   uint64_t incRawOverreadBytes(int64_t);
@@ -78,6 +79,7 @@ class IoStatistics {
   uint64_t incInputBatchSize(int64_t);
   uint64_t incOutputBatchSize(int64_t);
   uint64_t incTotalScanTime(int64_t);
+  uint64_t incSkippedRowGroupsByBloomFilter(int64_t);
 
   IoCounter& prefetch() {
     return prefetch_;
@@ -121,6 +123,9 @@ class IoStatistics {
   std::atomic<uint64_t> outputBatchSize_{0};
   std::atomic<uint64_t> rawOverreadBytes_{0};
   std::atomic<uint64_t> totalScanTime_{0};
+  // Row groups or stripes skipped because a bloom filter in the file showed
+  // no values passing the filter.
+  std::atomic<uint64_t> skippedRowGroupsByBloomFilter_{0};
 
   // Planned read from storage or SSD.
   IoCounter prefetch_;
@@ -163,6 +163,10 @@ void SelectiveIntegerColumnReader::processFilter(
           velox::common::NegatedBigintValuesUsingBitmask,
           isDense>(filter, rows, extractValues);
       break;
+    case velox::common::FilterKind::kValuesUsingBloomFilter:
+      readHelper<Reader, velox::common::ValuesUsingBloomFilter, isDense>(
+          filter, rows, extractValues);
+      break;
     default:
       readHelper<Reader, velox::common::Filter, isDense>(
           filter, rows, extractValues);
@@ -523,12 +523,17 @@ struct RuntimeStatistics {
   // Number of strides (row groups) skipped based on statistics.
   int64_t skippedStrides{0};
 
+  // Number of data pages skipped based on page level statistics, e.g. the
+  // Parquet page index.
+  int64_t skippedPages{0};
+
   std::unordered_map<std::string, RuntimeCounter> toMap() {
     return {
         {"skippedSplits", RuntimeCounter(skippedSplits)},
         {"skippedSplitBytes",
          RuntimeCounter(skippedSplitBytes, RuntimeCounter::Unit::kBytes)},
-        {"skippedStrides", RuntimeCounter(skippedStrides)}};
+        {"skippedStrides", RuntimeCounter(skippedStrides)},
+        {"skippedPages", RuntimeCounter(skippedPages)}};
   }
 };
 
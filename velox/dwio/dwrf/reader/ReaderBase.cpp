@@ -185,6 +185,8 @@ ReaderBase::ReaderBase(
   schema_ = std::dynamic_pointer_cast<const RowType>(
       convertType(*footer_, 0, fileColumnNamesReadAsLowerCase));
   DWIO_ENSURE_NOT_NULL(schema_, "invalid schema");
+  // Counts the open of the file for SSD cache admission.
+  input_->setNumStripes(footer_->stripesSize());
 
   // load stripe index/footer cache
   if (cacheSize > 0) {
@@ -164,6 +164,10 @@ void SelectiveStringDictionaryColumnReader::processFilter(
       readHelper<common::NegatedBytesValues, isDense>(
           filter, rows, extractValues);
       break;
+    case common::FilterKind::kValuesUsingBloomFilter:
+      readHelper<common::ValuesUsingBloomFilter, isDense>(
+          filter, rows, extractValues);
+      break;
     default:
       readHelper<common::Filter, isDense>(filter, rows, extractValues);
       break;
@@ -411,6 +411,10 @@ void SelectiveStringDirectColumnReader::processFilter(
       readHelper<common::NegatedBytesValues, isDense>(
           filter, rows, extractValues);
       break;
+    case common::FilterKind::kValuesUsingBloomFilter:
+      readHelper<common::ValuesUsingBloomFilter, isDense>(
+          filter, rows, extractValues);
+      break;
     default:
       readHelper<common::Filter, isDense>(filter, rows, extractValues);
       break;
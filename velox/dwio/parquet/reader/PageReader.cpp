@@ -37,6 +37,23 @@ void PageReader::seekToPage(int64_t row) {
   // 'rowOfPage_' is the row number of the first row of the next page.
   rowOfPage_ += numRowsInPage_;
   for (;;) {
+    if (row != kRepDefOnly && !columnPageIndex_.empty() &&
+        row < columnPageIndex_.numRows &&
+        static_cast<int64_t>(pageStart_) >=
+            columnPageIndex_.pageLocations[0].offset) {
+      // Past the dictionary. Go directly to the page containing 'row'
+      // instead of reading through the headers of the pages before it.
+      auto& location = columnPageIndex_.pageLocations[pageOfRow(row)];
+      if (location.offset > static_cast<int64_t>(pageStart_)) {
+        std::vector<uint64_t> position = {
+            static_cast<uint64_t>(location.offset)};
+        dwio::common::PositionProvider provider(position);
+        inputStream_->seekToPosition(provider);
+        bufferStart_ = bufferEnd_ = nullptr;
+        pageStart_ = location.offset;
+        rowOfPage_ = location.first_row_index;
+      }
+    }
     auto dataStart = pageStart_;
     if (chunkSize_ <= pageStart_) {
       // This may happen if seeking to exactly end of row group.
@@ -237,6 +254,67 @@ void PageReader::updateRowInfoAfterPageSkipped() {
   }
 }
 
+void PageReader::setPageIndex(ColumnPageIndex pageIndex) {
+  VELOX_CHECK(isTopLevel_, "Page index is only used for top level columns");
+  VELOX_CHECK_EQ(
+      pageIndex.pageLocations.size(), pageIndex.skippedPages.size());
+  VELOX_CHECK(
+      pageIndex.empty() || pageIndex.pageLocations[0].first_row_index == 0);
+  columnPageIndex_ = std::move(pageIndex);
+}
+
+int32_t PageReader::pageOfRow(int64_t row) const {
+  auto& locations = columnPageIndex_.pageLocations;
+  auto it = std::upper_bound(
+      locations.begin(),
+      locations.end(),
+      row,
+      [](int64_t row, const thrift::PageLocation& location) {
+        return row < location.first_row_index;
+      });
+  VELOX_DCHECK(it != locations.begin());
+  return it - locations.begin() - 1;
+}
+
+bool PageReader::isSkippedRow(int64_t row) const {
+  if (columnPageIndex_.empty()) {
+    return false;
+  }
+  if (row >= columnPageIndex_.numRows) {
+    return true;
+  }
+  return columnPageIndex_.skippedPages[pageOfRow(row)];
+}
+
+int64_t PageReader::endOfSkippedRows(int64_t row) const {
+  if (row >= columnPageIndex_.numRows) {
+    return columnPageIndex_.numRows;
+  }
+  auto& skippedPages = columnPageIndex_.skippedPages;
+  auto page = pageOfRow(row);
+  while (page < skippedPages.size() && skippedPages[page]) {
+    ++page;
+  }
+  return page < skippedPages.size()
+      ? columnPageIndex_.pageLocations[page].first_row_index
+      : columnPageIndex_.numRows;
+}
+
+void PageReader::skipRowsOnSkippedPages() {
+  while (currentVisitorRow_ < numVisitorRows_) {
+    auto row = visitBase_ + visitorRows_[currentVisitorRow_];
+    if (!isSkippedRow(row)) {
+      return;
+    }
+    auto end = endOfSkippedRows(row) - visitBase_;
+    currentVisitorRow_ = std::lower_bound(
+                             visitorRows_ + currentVisitorRow_,
+                             visitorRows_ + numVisitorRows_,
+                             end) -
+        visitorRows_;
+  }
+}
+
 void PageReader::prepareDataPageV1(const PageHeader& pageHeader, int64_t row) {
   VELOX_CHECK(
       pageHeader.type == thrift::PageType::DATA_PAGE &&
@@ -693,6 +771,12 @@ void PageReader::skip(int64_t numRows) {
     // Return if no skip and position not at end of page or before first page.
     return;
   }
+  if (isSkippedRow(firstUnvisited_ + numRows)) {
+    // The target page has no hits and is not read. The next read seeks
+    // directly to the page of its first row.
+    firstUnvisited_ += numRows;
+    return;
+  }
   auto toSkip = numRows;
   if (firstUnvisited_ + numRows >= rowOfPage_ + numRowsInPage_) {
     seekToPage(firstUnvisited_ + numRows);
@@ -822,6 +906,14 @@ bool PageReader::rowsForPage(
   if (currentVisitorRow_ == numVisitorRows_) {
     return false;
   }
+  if (hasFilter && !columnPageIndex_.empty()) {
+    // Rows on pages without hits are dropped without reading the pages.
+    skipRowsOnSkippedPages();
+    if (currentVisitorRow_ == numVisitorRows_) {
+      firstUnvisited_ = visitBase_ + visitorRows_[numVisitorRows_ - 1] + 1;
+      return false;
+    }
+  }
   int32_t numToVisit;
   // Check if the first row to go to is in the current page. If not, seek to the
   // page that contains the row.
@@ -831,6 +923,11 @@ bool PageReader::rowsForPage(
     if (hasChunkRepDefs_) {
       numLeafNullsConsumed_ = rowOfPage_;
     }
+    if (!columnPageIndex_.empty()) {
+      // The decoder is at the start of the page. skip() below is relative to
+      // this.
+      firstUnvisited_ = rowOfPage_;
+    }
   }
   auto& scanState = reader.scanState();
   if (isDictionary()) {
@@ -28,6 +28,25 @@
 
 namespace facebook::velox::parquet {
 
+/// Data pages of a ColumnChunk from the Parquet OffsetIndex together with the
+/// pages that the ColumnIndex shows to have no rows passing the filter of the
+/// column. Offsets in 'pageLocations' are relative to the start of the
+/// ColumnChunk.
+struct ColumnPageIndex {
+  std::vector<thrift::PageLocation> pageLocations;
+
+  // True for each page in 'pageLocations' that has no rows passing the
+  // filter.
+  std::vector<bool> skippedPages;
+
+  // Number of rows in the row group.
+  int64_t numRows{0};
+
+  bool empty() const {
+    return pageLocations.empty();
+  }
+};
+
 /// Manages access to pages inside a ColumnChunk. Interprets page headers and
 /// encodings and presents the combination of pages and encoded values as a
 /// continuous stream accessible via readWithVisitor().
@@ -66,6 +85,12 @@ class PageReader {
         chunkSize_(chunkSize),
         nullConcatenation_(pool_) {}
 
+  /// Sets the page index of the ColumnChunk. Rows on skipped pages produce no
+  /// hits when reading with a filter and their pages are neither read nor
+  /// decoded. Seeks go directly to the page offset instead of reading through
+  /// the headers of the pages in between. Only for top level columns.
+  void setPageIndex(ColumnPageIndex pageIndex);
+
   /// Advances 'numRows' top level rows.
   void skip(int64_t numRows);
 
@@ -181,6 +206,20 @@ class PageReader {
   // next page.
   void updateRowInfoAfterPageSkipped();
 
+  // Returns the index in 'columnPageIndex_' of the page that contains 'row'.
+  int32_t pageOfRow(int64_t row) const;
+
+  // True if 'row' is on a page that 'columnPageIndex_' shows to have no hits
+  // for the filter or if 'row' is at or past the end of the ColumnChunk.
+  bool isSkippedRow(int64_t row) const;
+
+  // Returns the first row after the run of skipped pages that contains 'row'.
+  int64_t endOfSkippedRows(int64_t row) const;
+
+  // Advances 'currentVisitorRow_' past the rows to visit that are on skipped
+  // pages.
+  void skipRowsOnSkippedPages();
+
   void prepareDataPageV1(const thrift::PageHeader& pageHeader, int64_t row);
   void prepareDataPageV2(const thrift::PageHeader& pageHeader, int64_t row);
   void prepareDictionary(const thrift::PageHeader& pageHeader);
@@ -422,6 +461,10 @@ class PageReader {
   // Offset of first byte after current page' header.
   uint64_t pageDataStart_{0};
 
+  // Page locations and pages without hits from the Parquet page index. Empty
+  // if the ColumnChunk has no page index or there are no pages to skip.
+  ColumnPageIndex columnPageIndex_;
+
   // Number of bytes starting at pageData_ for current encoded data.
   int32_t encodedDataSize_{0};
 
@@ -15,17 +15,41 @@
  */
 
 #include "velox/dwio/parquet/reader/ParquetData.h"
+#include "velox/common/base/BloomFilter.h"
 #include "velox/dwio/parquet/reader/Statistics.h"
 
+#define XXH_INLINE_ALL
+#include <xxhash.h>
+
 namespace facebook::velox::parquet {
 
 using thrift::RowGroup;
 
 std::unique_ptr<dwio::common::FormatData> ParquetParams::toFormatData(
     const std::shared_ptr<const dwio::common::TypeWithId>& type,
-    const common::ScanSpec& /*scanSpec*/) {
-  return std::make_unique<ParquetData>(type, metaData_.row_groups, pool());
+    const common::ScanSpec& scanSpec) {
+  return std::make_unique<ParquetData>(
+      type, metaData_.row_groups, pool(), &scanSpec, input_, skippedPages_);
+}
+
+namespace {
+// Reads a thrift struct of 'length' bytes from 'stream'.
+template <typename T>
+T readThriftStruct(dwio::common::SeekableInputStream& stream, int32_t length) {
+  std::vector<char> copy(length);
+  const char* bufferStart = nullptr;
+  const char* bufferEnd = nullptr;
+  dwio::common::readBytes(
+      length, &stream, copy.data(), bufferStart, bufferEnd);
+  std::shared_ptr<thrift::ThriftTransport> transport =
+      std::make_shared<thrift::ThriftBufferedTransport>(copy.data(), length);
+  apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport> protocol(
+      transport);
+  T result;
+  result.read(&protocol);
+  return result;
 }
+} // namespace
 
 void ParquetData::filterRowGroups(
     const common::ScanSpec& scanSpec,
@@ -47,6 +71,13 @@ void ParquetData::filterRowGroups(
       bits::setBit(result.filterResult.data(), i);
       continue;
     }
+    if (scanSpec.filter() && !bloomFilterMatches(i, scanSpec.filter())) {
+      bits::setBit(result.filterResult.data(), i);
+      if (auto* stats = input_->getInputStream()->getStats()) {
+        stats->incSkippedRowGroupsByBloomFilter(1);
+      }
+      continue;
+    }
     for (int j = 0; j < scanSpec.numMetadataFilters(); ++j) {
       auto* metadataFilter = scanSpec.metadataFilterAt(j);
       if (!rowGroupMatches(i, metadataFilter)) {
@@ -82,6 +113,203 @@ bool ParquetData::rowGroupMatches(
   return true;
 }
 
+namespace {
+// Size of the first read for a BloomFilterHeader. Headers are usually a few
+// tens of bytes. A header that does not fit is read again with a longer read.
+constexpr uint64_t kBloomFilterHeaderReadSize = 256;
+
+// Reads the BloomFilterHeader at 'offset' in 'input' into 'header' and sets
+// 'headerSize' to the number of bytes it takes. Returns false if the header
+// does not end before 'fileSize'.
+bool readBloomFilterHeader(
+    dwio::common::BufferedInput& input,
+    uint64_t offset,
+    uint64_t fileSize,
+    thrift::BloomFilterHeader& header,
+    uint64_t& headerSize) {
+  auto readSize = std::min(kBloomFilterHeaderReadSize, fileSize - offset);
+  for (;;) {
+    auto stream =
+        input.read(offset, readSize, dwio::common::LogType::STRIPE_INDEX);
+    std::vector<char> copy(readSize);
+    const char* bufferStart = nullptr;
+    const char* bufferEnd = nullptr;
+    dwio::common::readBytes(
+        readSize, stream.get(), copy.data(), bufferStart, bufferEnd);
+    auto transport = std::make_shared<thrift::ThriftBufferedTransport>(
+        copy.data(), readSize);
+    apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport>
+        protocol(transport);
+    thrift::BloomFilterHeader result;
+    try {
+      result.read(&protocol);
+    } catch (const dwio::common::exception::LoggedException&) {
+      // The transport ran out of bytes, so the header is longer than
+      // 'readSize'.
+      if (readSize == fileSize - offset) {
+        return false;
+      }
+      readSize = std::min(readSize * 4, fileSize - offset);
+      continue;
+    }
+    header = std::move(result);
+    headerSize = transport->bytesRead();
+    return true;
+  }
+}
+
+template <typename T>
+uint64_t bloomFilterHash(T value) {
+  return XXH64(&value, sizeof(value), 0);
+}
+
+// Adds the hashes of 'values' for a column stored as 'parquetType' to
+// 'hashes'. Values out of range for the physical type are left out since
+// they cannot occur in the column.
+bool addIntegerHashes(
+    const std::vector<int64_t>& values,
+    thrift::Type::type parquetType,
+    std::vector<uint64_t>& hashes) {
+  if (parquetType == thrift::Type::INT64) {
+    for (auto value : values) {
+      hashes.push_back(bloomFilterHash(value));
+    }
+    return true;
+  }
+  if (parquetType == thrift::Type::INT32) {
+    for (auto value : values) {
+      if (value >= std::numeric_limits<int32_t>::min() &&
+          value <= std::numeric_limits<int32_t>::max()) {
+        hashes.push_back(bloomFilterHash(static_cast<int32_t>(value)));
+      }
+    }
+    return true;
+  }
+  return false;
+}
+} // namespace
+
+// static
+bool ParquetData::bloomFilterHashes(
+    const common::Filter& filter,
+    const Type& type,
+    thrift::Type::type parquetType,
+    std::vector<uint64_t>& hashes) {
+  hashes.clear();
+  switch (type.kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::DATE:
+      if (type.isDecimal()) {
+        return false;
+      }
+      switch (filter.kind()) {
+        case common::FilterKind::kBigintRange: {
+          auto range = static_cast<const common::BigintRange*>(&filter);
+          return range->isSingleValue() &&
+              addIntegerHashes({range->lower()}, parquetType, hashes);
+        }
+        case common::FilterKind::kBigintValuesUsingHashTable:
+          return addIntegerHashes(
+              static_cast<const common::BigintValuesUsingHashTable&>(filter)
+                  .values(),
+              parquetType,
+              hashes);
+        case common::FilterKind::kBigintValuesUsingBitmask:
+          return addIntegerHashes(
+              static_cast<const common::BigintValuesUsingBitmask&>(filter)
+                  .values(),
+              parquetType,
+              hashes);
+        default:
+          return false;
+      }
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      if (parquetType != thrift::Type::BYTE_ARRAY) {
+        return false;
+      }
+      switch (filter.kind()) {
+        case common::FilterKind::kBytesRange: {
+          auto range = static_cast<const common::BytesRange*>(&filter);
+          if (!range->isSingleValue()) {
+            return false;
+          }
+          hashes.push_back(
+              XXH64(range->lower().data(), range->lower().size(), 0));
+          return true;
+        }
+        case common::FilterKind::kBytesValues:
+          for (auto& value :
+               static_cast<const common::BytesValues&>(filter).values()) {
+            hashes.push_back(XXH64(value.data(), value.size(), 0));
+          }
+          return true;
+        default:
+          return false;
+      }
+    default:
+      return false;
+  }
+}
+
+bool ParquetData::bloomFilterMatches(
+    uint32_t rowGroupId,
+    common::Filter* filter) {
+  // Nulls are not in the bloom filter.
+  if (!input_ || maxRepeat_ > 0 || filter->testNull() ||
+      !type_->parquetType_.has_value()) {
+    return true;
+  }
+  auto& chunk = rowGroups_[rowGroupId].columns[type_->column];
+  if (!chunk.__isset.meta_data ||
+      !chunk.meta_data.__isset.bloom_filter_offset) {
+    return true;
+  }
+  std::vector<uint64_t> hashes;
+  if (!bloomFilterHashes(
+          *filter, *type_->type, type_->parquetType_.value(), hashes)) {
+    return true;
+  }
+
+  const uint64_t fileSize = input_->getReadFile()->size();
+  const uint64_t offset = chunk.meta_data.bloom_filter_offset;
+  if (offset >= fileSize) {
+    return true;
+  }
+  thrift::BloomFilterHeader header;
+  uint64_t headerSize;
+  if (!readBloomFilterHeader(*input_, offset, fileSize, header, headerSize)) {
+    return true;
+  }
+  using SplitBlockFilter = SplitBlockBloomFilter<>;
+  if (!header.algorithm.__isset.BLOCK || !header.hash.__isset.XXHASH ||
+      !header.compression.__isset.UNCOMPRESSED || header.numBytes <= 0 ||
+      header.numBytes % SplitBlockFilter::kBytesPerBlock != 0 ||
+      offset + headerSize + header.numBytes > fileSize) {
+    return true;
+  }
+
+  std::vector<uint32_t> blocks(header.numBytes / sizeof(uint32_t));
+  auto stream = input_->read(
+      offset + headerSize,
+      header.numBytes,
+      dwio::common::LogType::STRIPE_INDEX);
+  const char* bufferStart = nullptr;
+  const char* bufferEnd = nullptr;
+  dwio::common::readBytes(
+      header.numBytes, stream.get(), blocks.data(), bufferStart, bufferEnd);
+  auto numBlocks = header.numBytes / SplitBlockFilter::kBytesPerBlock;
+  for (auto hash : hashes) {
+    if (SplitBlockFilter::test(blocks.data(), numBlocks, hash)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 void ParquetData::enqueueRowGroup(
     uint32_t index,
     dwio::common::BufferedInput& input) {
@@ -105,10 +333,135 @@ void ParquetData::enqueueRowGroup(
       ? metaData.total_uncompressed_size
       : metaData.total_compressed_size;
 
+  pageIndexes_.resize(rowGroups_.size());
+  pageIndexes_[index] = readPageIndex(index, chunkReadOffset);
+  auto& pageIndex = pageIndexes_[index];
+  if (!pageIndex.empty()) {
+    if (numSkippedPages_) {
+      *numSkippedPages_ += std::count(
+          pageIndex.skippedPages.begin(), pageIndex.skippedPages.end(), true);
+    }
+    // Rows after the last page with hits are never read, so the pages after it
+    // are not loaded.
+    auto& locations = pageIndex.pageLocations;
+    auto lastPage = locations.size() - 1;
+    while (lastPage > 0 && pageIndex.skippedPages[lastPage]) {
+      --lastPage;
+    }
+    auto readEnd =
+        locations[lastPage].offset + locations[lastPage].compressed_page_size;
+    readSize = std::min<uint64_t>(readSize, readEnd);
+  }
+
   auto id = dwio::common::StreamIdentifier(type_->column);
   streams_[index] = input.enqueue({chunkReadOffset, readSize}, &id);
 }
 
+bool ParquetData::enqueuePageIndex(
+    uint32_t index,
+    dwio::common::BufferedInput& input) {
+  columnIndexStream_.reset();
+  offsetIndexStream_.reset();
+  pageIndexRowGroup_ = -1;
+  auto* filter = scanSpec_ ? scanSpec_->filter() : nullptr;
+  // Only top level columns have pages that start at row boundaries known from
+  // the OffsetIndex alone. Null-only filters are read with readNullsOnly(),
+  // which does not skip pages.
+  if (!filter || maxRepeat_ > 0 || maxDefine_ > 1 ||
+      filter->kind() == common::FilterKind::kIsNull ||
+      filter->kind() == common::FilterKind::kIsNotNull) {
+    return false;
+  }
+  auto& chunk = rowGroups_[index].columns[type_->column];
+  if (!chunk.__isset.column_index_offset ||
+      !chunk.__isset.column_index_length ||
+      !chunk.__isset.offset_index_offset ||
+      !chunk.__isset.offset_index_length) {
+    return false;
+  }
+  columnIndexStream_ = input.enqueue(
+      {static_cast<uint64_t>(chunk.column_index_offset),
+       static_cast<uint64_t>(chunk.column_index_length)});
+  offsetIndexStream_ = input.enqueue(
+      {static_cast<uint64_t>(chunk.offset_index_offset),
+       static_cast<uint64_t>(chunk.offset_index_length)});
+  pageIndexRowGroup_ = index;
+  return true;
+}
+
+ColumnPageIndex ParquetData::readPageIndex(
+    uint32_t index,
+    uint64_t chunkOffset) {
+  if (pageIndexRowGroup_ != index) {
+    return {};
+  }
+  auto columnIndexStream = std::move(columnIndexStream_);
+  auto offsetIndexStream = std::move(offsetIndexStream_);
+  pageIndexRowGroup_ = -1;
+  auto& chunk = rowGroups_[index].columns[type_->column];
+  auto columnIndex = readThriftStruct<thrift::ColumnIndex>(
+      *columnIndexStream, chunk.column_index_length);
+  auto offsetIndex = readThriftStruct<thrift::OffsetIndex>(
+      *offsetIndexStream, chunk.offset_index_length);
+  auto* filter = scanSpec_->filter();
+  auto numRows = rowGroups_[index].num_rows;
+  auto skipped =
+      skippedPages(columnIndex, offsetIndex, numRows, type_->type, filter);
+  if (std::find(skipped.begin(), skipped.end(), true) == skipped.end()) {
+    return {};
+  }
+  ColumnPageIndex pageIndex;
+  pageIndex.pageLocations = std::move(offsetIndex.page_locations);
+  for (auto& location : pageIndex.pageLocations) {
+    VELOX_CHECK_GE(location.offset, static_cast<int64_t>(chunkOffset));
+    location.offset -= chunkOffset;
+  }
+  pageIndex.skippedPages = std::move(skipped);
+  pageIndex.numRows = numRows;
+  return pageIndex;
+}
+
+// static
+std::vector<bool> ParquetData::skippedPages(
+    const thrift::ColumnIndex& columnIndex,
+    const thrift::OffsetIndex& offsetIndex,
+    int64_t numRows,
+    const TypePtr& type,
+    common::Filter* filter) {
+  auto& locations = offsetIndex.page_locations;
+  auto numPages = locations.size();
+  if (numPages == 0 || locations[0].first_row_index != 0 ||
+      columnIndex.null_pages.size() != numPages ||
+      columnIndex.min_values.size() != numPages ||
+      columnIndex.max_values.size() != numPages) {
+    return {};
+  }
+  bool hasNullCounts = columnIndex.__isset.null_counts &&
+      columnIndex.null_counts.size() == numPages;
+  std::vector<bool> skipped(numPages);
+  for (auto i = 0; i < numPages; ++i) {
+    auto nextRow =
+        i + 1 < numPages ? locations[i + 1].first_row_index : numRows;
+    auto numRowsInPage = nextRow - locations[i].first_row_index;
+    // Express the page's entry in the ColumnIndex as chunk level statistics
+    // so that the filter is tested the same way as for row groups.
+    thrift::Statistics pageStats;
+    if (columnIndex.null_pages[i]) {
+      pageStats.__set_null_count(numRowsInPage);
+    } else {
+      pageStats.__set_min_value(columnIndex.min_values[i]);
+      pageStats.__set_max_value(columnIndex.max_values[i]);
+      if (hasNullCounts) {
+        pageStats.__set_null_count(columnIndex.null_counts[i]);
+      }
+    }
+    auto stats =
+        buildColumnStatisticsFromThrift(pageStats, *type, numRowsInPage);
+    skipped[i] = !testFilter(filter, stats.get(), numRowsInPage, type);
+  }
+  return skipped;
+}
+
 dwio::common::PositionProvider ParquetData::seekToRowGroup(uint32_t index) {
   static std::vector<uint64_t> empty;
   VELOX_CHECK_LT(index, streams_.size());
@@ -120,6 +473,9 @@ dwio::common::PositionProvider ParquetData::seekToRowGroup(uint32_t index) {
       type_,
       metadata.codec,
       metadata.total_compressed_size);
+  if (index < pageIndexes_.size() && !pageIndexes_[index].empty()) {
+    reader_->setPageIndex(std::move(pageIndexes_[index]));
+  }
   return dwio::common::PositionProvider(empty);
 }
 
@@ -28,14 +28,26 @@
 namespace facebook::velox::parquet {
 class ParquetParams : public dwio::common::FormatParams {
  public:
-  ParquetParams(memory::MemoryPool& pool, const thrift::FileMetaData& metaData)
-      : FormatParams(pool), metaData_(metaData) {}
+  ParquetParams(
+      memory::MemoryPool& pool,
+      const thrift::FileMetaData& metaData,
+      dwio::common::BufferedInput* FOLLY_NULLABLE input = nullptr,
+      int64_t* FOLLY_NULLABLE skippedPages = nullptr)
+      : FormatParams(pool),
+        metaData_(metaData),
+        input_(input),
+        skippedPages_(skippedPages) {}
   std::unique_ptr<dwio::common::FormatData> toFormatData(
       const std::shared_ptr<const dwio::common::TypeWithId>& type,
       const common::ScanSpec& scanSpec) override;
 
  private:
   const thrift::FileMetaData& metaData_;
+  // Input of the file. Used for reading bloom filters when filtering row
+  // groups.
+  dwio::common::BufferedInput* FOLLY_NULLABLE input_;
+  // Counter of data pages skipped by the page index of all columns.
+  int64_t* FOLLY_NULLABLE skippedPages_;
 };
 
 /// Format-specific data created for each leaf column of a Parquet rowgroup.
@@ -44,15 +56,29 @@ class ParquetData : public dwio::common::FormatData {
   ParquetData(
       const std::shared_ptr<const dwio::common::TypeWithId>& type,
       const std::vector<thrift::RowGroup>& rowGroups,
-      memory::MemoryPool& pool)
+      memory::MemoryPool& pool,
+      const common::ScanSpec* FOLLY_NULLABLE scanSpec = nullptr,
+      dwio::common::BufferedInput* FOLLY_NULLABLE input = nullptr,
+      int64_t* FOLLY_NULLABLE numSkippedPages = nullptr)
       : pool_(pool),
         type_(std::static_pointer_cast<const ParquetTypeWithId>(type)),
         rowGroups_(rowGroups),
+        scanSpec_(scanSpec),
+        input_(input),
+        numSkippedPages_(numSkippedPages),
         maxDefine_(type_->maxDefine_),
         maxRepeat_(type_->maxRepeat_),
         rowsInRowGroup_(-1) {}
 
-  /// Prepares to read data for 'index'th row group.
+  /// Enqueues the ColumnIndex and OffsetIndex of the ColumnChunk in 'index'th
+  /// row group in 'input' if the column has a filter that can skip pages.
+  /// Returns true if anything was enqueued. 'input' must be loaded before
+  /// enqueueRowGroup() for the same row group, which parses the indices.
+  bool enqueuePageIndex(uint32_t index, dwio::common::BufferedInput& input);
+
+  /// Prepares to read data for 'index'th row group. If the page index was
+  /// enqueued by enqueuePageIndex(), leaves out the pages after the last page
+  /// with possible hits.
   void enqueueRowGroup(uint32_t index, dwio::common::BufferedInput& input);
 
   /// Positions 'this' at 'index'th row group. enqueueRowGroup must be called
@@ -172,7 +198,39 @@ class ParquetData : public dwio::common::FormatData {
     return true;
   }
 
+  /// Returns a flag for each page in 'offsetIndex' that is true if
+  /// 'columnIndex' shows that the page has no rows passing 'filter'. Returns
+  /// an empty vector if the indices are inconsistent. 'numRows' is the number
+  /// of rows in the row group.
+  static std::vector<bool> skippedPages(
+      const thrift::ColumnIndex& columnIndex,
+      const thrift::OffsetIndex& offsetIndex,
+      int64_t numRows,
+      const TypePtr& type,
+      common::Filter* FOLLY_NONNULL filter);
+
+  /// Sets 'hashes' to the Parquet bloom filter hashes of the values that pass
+  /// 'filter' for a column of 'type' stored as 'parquetType'. Returns false if
+  /// 'filter' does not consist of discrete values or if the types are not
+  /// supported, in which case the bloom filter cannot be used.
+  static bool bloomFilterHashes(
+      const common::Filter& filter,
+      const Type& type,
+      thrift::Type::type parquetType,
+      std::vector<uint64_t>& hashes);
+
  private:
+  // True if the bloom filter of the column in 'rowGroupId' may contain a value
+  // passing 'filter' or if there is no bloom filter usable with 'filter'.
+  bool bloomFilterMatches(uint32_t rowGroupId, common::Filter* filter);
+
+  // Parses the page index of the ColumnChunk of 'this' in 'index'th row group
+  // loaded after enqueuePageIndex() and returns the pages without hits for the
+  // filter of the column. Page offsets are made relative to 'chunkOffset'.
+  // Returns an empty ColumnPageIndex if the page index was not enqueued or
+  // there is nothing to skip.
+  ColumnPageIndex readPageIndex(uint32_t index, uint64_t chunkOffset);
+
   /// True if 'filter' may have hits for the column of 'this' according to the
   /// stats in 'rowGroup'.
   bool rowGroupMatches(uint32_t rowGroupId, common::Filter* filter);
@@ -181,9 +239,25 @@ class ParquetData : public dwio::common::FormatData {
   memory::MemoryPool& pool_;
   std::shared_ptr<const ParquetTypeWithId> type_;
   const std::vector<thrift::RowGroup>& rowGroups_;
+  // ScanSpec of the column. The filter is used for skipping pages by the page
+  // index.
+  const common::ScanSpec* FOLLY_NULLABLE scanSpec_;
+  // Input for reading bloom filters in filterRowGroups(). Row group data is
+  // read from the input given to enqueueRowGroup().
+  dwio::common::BufferedInput* FOLLY_NULLABLE input_;
   // Streams for this column in each of 'rowGroups_'. Will be created on or
   // ahead of first use, not at construction.
   std::vector<std::unique_ptr<dwio::common::SeekableInputStream>> streams_;
+  // Page index for this column in each of 'rowGroups_'. Set in
+  // enqueueRowGroup() and handed to the PageReader in seekToRowGroup().
+  std::vector<ColumnPageIndex> pageIndexes_;
+  // ColumnIndex and OffsetIndex of row group 'pageIndexRowGroup_' enqueued by
+  // enqueuePageIndex(). -1 if none is pending.
+  std::unique_ptr<dwio::common::SeekableInputStream> columnIndexStream_;
+  std::unique_ptr<dwio::common::SeekableInputStream> offsetIndexStream_;
+  int64_t pageIndexRowGroup_{-1};
+  // Counter of data pages skipped by the page index. Owned by the row reader.
+  int64_t* FOLLY_NULLABLE numSkippedPages_;
 
   const uint32_t maxDefine_;
   const uint32_t maxRepeat_;
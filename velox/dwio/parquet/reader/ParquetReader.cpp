@@ -44,6 +44,8 @@ ReaderBase::ReaderBase(
 
   loadFileMetaData();
   initializeSchema();
+  // Counts the open of the file for SSD cache admission.
+  input_->setNumStripes(fileMetaData_->row_groups.size());
 }
 
 void ReaderBase::loadFileMetaData() {
@@ -468,19 +470,13 @@ void ReaderBase::scheduleRowGroups(
       currentGroup + 1 < rowGroupIds.size() ? rowGroupIds[currentGroup + 1] : 0;
   auto input = inputs_[thisGroup].get();
   if (!input) {
-    auto newInput = input_->clone();
-    reader.enqueueRowGroup(thisGroup, *newInput);
-    newInput->load(dwio::common::LogType::STRIPE);
-    inputs_[thisGroup] = std::move(newInput);
+    loadRowGroup(thisGroup, reader);
   }
   for (auto counter = 0; counter < FLAGS_parquet_prefetch_rowgroups;
        ++counter) {
     if (nextGroup) {
       if (inputs_.count(nextGroup) != 0) {
-        auto newInput = input_->clone();
-        reader.enqueueRowGroup(nextGroup, *newInput);
-        newInput->load(dwio::common::LogType::STRIPE);
-        inputs_[nextGroup] = std::move(newInput);
+        loadRowGroup(nextGroup, reader);
       }
     } else {
       break;
@@ -493,6 +489,21 @@ void ReaderBase::scheduleRowGroups(
   }
 }
 
+void ReaderBase::loadRowGroup(uint32_t group, StructColumnReader& reader) {
+  // The page indices decide which pages of the filtered columns are enqueued,
+  // so they are read first. They are small and the writers place the indices
+  // of all columns next to each other, so this is a single coalesced read per
+  // row group instead of two reads per column.
+  auto indexInput = input_->clone();
+  if (reader.enqueuePageIndex(group, *indexInput)) {
+    indexInput->load(dwio::common::LogType::STRIPE_INDEX);
+  }
+  auto newInput = input_->clone();
+  reader.enqueueRowGroup(group, *newInput);
+  newInput->load(dwio::common::LogType::STRIPE);
+  inputs_[group] = std::move(newInput);
+}
+
 int64_t ReaderBase::rowGroupUncompressedSize(
     int32_t rowGroupIndex,
     const dwio::common::TypeWithId& type) const {
@@ -535,7 +546,11 @@ ParquetRowReader::ParquetRowReader(
   if (rowGroups_.empty()) {
     return; // TODO
   }
-  ParquetParams params(pool_, readerBase_->fileMetaData());
+  ParquetParams params(
+      pool_,
+      readerBase_->fileMetaData(),
+      &readerBase_->bufferedInput(),
+      &skippedPages_);
 
   columnReader_ = ParquetColumnReader::build(
       readerBase_->schemaWithId(), // Id is schema id
@@ -640,6 +655,7 @@ bool ParquetRowReader::advanceToNextRowGroup() {
 void ParquetRowReader::updateRuntimeStats(
     dwio::common::RuntimeStatistics& stats) const {
   stats.skippedStrides += skippedRowGroups_;
+  stats.skippedPages += skippedPages_;
 }
 
 void ParquetRowReader::resetFilterCaches() {
@@ -77,6 +77,10 @@ class ReaderBase {
       int32_t currentGroup,
       StructColumnReader& reader);
 
+  /// Enqueues and loads the streams of 'group' in a new input, after loading
+  /// the page indices used for skipping pages of the filtered columns.
+  void loadRowGroup(uint32_t group, StructColumnReader& reader);
+
   /// Returns the uncompressed size for columns in 'type' and its children in
   /// row
   /// group.
@@ -182,6 +186,9 @@ class ParquetRowReader : public dwio::common::RowReader {
   // Number of row groups skipped based on stats.
   int32_t skippedRowGroups_{0};
 
+  // Number of data pages skipped based on the page index.
+  int64_t skippedPages_{0};
+
   std::unique_ptr<dwio::common::SelectiveColumnReader> columnReader_;
 
   RowTypePtr requestedType_;
@@ -108,6 +108,22 @@ void StructColumnReader::enqueueRowGroup(
   }
 }
 
+bool StructColumnReader::enqueuePageIndex(
+    uint32_t index,
+    dwio::common::BufferedInput& input) {
+  bool enqueued = false;
+  for (auto& child : children_) {
+    if (dynamic_cast<StructColumnReader*>(child) ||
+        dynamic_cast<ListColumnReader*>(child) ||
+        dynamic_cast<MapColumnReader*>(child)) {
+      continue;
+    }
+    enqueued |=
+        child->formatData().as<ParquetData>().enqueuePageIndex(index, input);
+  }
+  return enqueued;
+}
+
 void StructColumnReader::seekToRowGroup(uint32_t index) {
   SelectiveColumnReader::seekToRowGroup(index);
   BufferPtr noBuffer;
@@ -36,6 +36,11 @@ class StructColumnReader : public dwio::common::SelectiveStructColumnReader {
   /// Creates the streams for 'rowGroup in 'input'. Does not load yet.
   void enqueueRowGroup(uint32_t index, dwio::common::BufferedInput& input);
 
+  /// Enqueues the page indices of the filtered top level columns of 'index'th
+  /// row group in 'input'. Returns true if anything was enqueued. 'input' must
+  /// be loaded before enqueueRowGroup() for the same row group.
+  bool enqueuePageIndex(uint32_t index, dwio::common::BufferedInput& input);
+
   // No-op in Parquet. All readers switch row groups at the same time, there is
   // no on-demand skipping to a new row group.
   void advanceFieldReader(
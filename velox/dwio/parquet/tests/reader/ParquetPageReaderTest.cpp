@@ -15,6 +15,7 @@
  */
 
 #include "velox/dwio/parquet/reader/PageReader.h"
+#include "velox/dwio/parquet/reader/ParquetData.h"
 #include "velox/dwio/parquet/reader/ParquetReader.h"
 #include "velox/dwio/parquet/tests/ParquetReaderTestBase.h"
 
@@ -106,3 +107,44 @@ TEST_F(ParquetPageReaderTest, corruptedPageHeader) {
 
   EXPECT_THROW(pageReader->readPageHeader(), VeloxException);
 }
+
+TEST_F(ParquetPageReaderTest, pageIndexSkippedPages) {
+  auto encode = [](int64_t value) {
+    return std::string(reinterpret_cast<const char*>(&value), sizeof(value));
+  };
+  // Four pages of 100 rows with values 0-99, 100-199 and 200-299 followed by a
+  // page of nulls.
+  thrift::ColumnIndex columnIndex;
+  thrift::OffsetIndex offsetIndex;
+  for (auto i = 0; i < 4; ++i) {
+    bool isNullPage = i == 3;
+    columnIndex.null_pages.push_back(isNullPage);
+    columnIndex.min_values.push_back(isNullPage ? "" : encode(i * 100));
+    columnIndex.max_values.push_back(isNullPage ? "" : encode(i * 100 + 99));
+    columnIndex.null_counts.push_back(isNullPage ? 100 : 0);
+    thrift::PageLocation location;
+    location.offset = 4 + i * 1000;
+    location.compressed_page_size = 1000;
+    location.first_row_index = i * 100;
+    offsetIndex.page_locations.push_back(location);
+  }
+  columnIndex.__isset.null_counts = true;
+
+  BigintRange range(150, 250, false);
+  EXPECT_EQ(
+      ParquetData::skippedPages(
+          columnIndex, offsetIndex, 400, BIGINT(), &range),
+      std::vector<bool>({true, false, false, true}));
+
+  BigintRange rangeWithNulls(150, 160, true);
+  EXPECT_EQ(
+      ParquetData::skippedPages(
+          columnIndex, offsetIndex, 400, BIGINT(), &rangeWithNulls),
+      std::vector<bool>({true, false, true, false}));
+
+  // Inconsistent indices are not used.
+  columnIndex.min_values.pop_back();
+  EXPECT_TRUE(ParquetData::skippedPages(
+                  columnIndex, offsetIndex, 400, BIGINT(), &range)
+                  .empty());
+}
@@ -14,10 +14,15 @@
  * limitations under the License.
  */
 
+#include "velox/common/base/BloomFilter.h"
+#include "velox/dwio/parquet/reader/ParquetData.h"
 #include "velox/dwio/parquet/reader/ParquetReader.h"
 #include "velox/dwio/parquet/tests/ParquetReaderTestBase.h"
 #include "velox/expression/ExprToSubfieldFilter.h"
 
+#define XXH_INLINE_ALL
+#include <xxhash.h>
+
 using namespace facebook::velox;
 using namespace facebook::velox::common;
 using namespace facebook::velox::dwio::common;
@@ -289,3 +294,126 @@ TEST_F(ParquetReaderTest, intMultipleFilters) {
       std::move(filters),
       expected);
 }
+
+TEST_F(ParquetReaderTest, bloomFilterHashes) {
+  // Parquet bloom filters hash the plain encoding of values with XXH64.
+  SplitBlockBloomFilter<> int32Bloom;
+  int32Bloom.reset(100);
+  SplitBlockBloomFilter<> int64Bloom;
+  int64Bloom.reset(100);
+  for (int32_t i = 0; i < 100; ++i) {
+    int32Bloom.insert(XXH64(&i, sizeof(i), 0));
+    int64_t value = i;
+    int64Bloom.insert(XXH64(&value, sizeof(value), 0));
+  }
+  auto mayContain = [](const SplitBlockBloomFilter<>& bloom,
+                       const std::vector<uint64_t>& hashes) {
+    for (auto hash : hashes) {
+      if (bloom.mayContain(hash)) {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  std::vector<uint64_t> hashes;
+  auto inList = createBigintValues({10, 20, 30}, false);
+  ASSERT_TRUE(ParquetData::bloomFilterHashes(
+      *inList, *INTEGER(), thrift::Type::INT32, hashes));
+  EXPECT_EQ(3, hashes.size());
+  EXPECT_TRUE(mayContain(int32Bloom, hashes));
+  ASSERT_TRUE(ParquetData::bloomFilterHashes(
+      *inList, *BIGINT(), thrift::Type::INT64, hashes));
+  EXPECT_TRUE(mayContain(int64Bloom, hashes));
+
+  auto missing = createBigintValues({1'000, 2'000, 3'000'000'000}, false);
+  ASSERT_TRUE(ParquetData::bloomFilterHashes(
+      *missing, *INTEGER(), thrift::Type::INT32, hashes));
+  // Values out of the INT32 range cannot occur in the column.
+  EXPECT_EQ(2, hashes.size());
+  EXPECT_FALSE(mayContain(int32Bloom, hashes));
+
+  BigintRange equal(50, 50, false);
+  ASSERT_TRUE(ParquetData::bloomFilterHashes(
+      equal, *BIGINT(), thrift::Type::INT64, hashes));
+  EXPECT_TRUE(mayContain(int64Bloom, hashes));
+
+  // Ranges of more than one value do not use the bloom filter.
+  BigintRange range(50, 60, false);
+  EXPECT_FALSE(ParquetData::bloomFilterHashes(
+      range, *BIGINT(), thrift::Type::INT64, hashes));
+
+  SplitBlockBloomFilter<> stringBloom;
+  stringBloom.reset(10);
+  std::string present = "present";
+  stringBloom.insert(XXH64(present.data(), present.size(), 0));
+  BytesValues strings(std::vector<std::string>{"present", "absent"}, false);
+  ASSERT_TRUE(ParquetData::bloomFilterHashes(
+      strings, *VARCHAR(), thrift::Type::BYTE_ARRAY, hashes));
+  EXPECT_TRUE(mayContain(stringBloom, hashes));
+  BytesValues absent(std::vector<std::string>{"absent"}, false);
+  ASSERT_TRUE(ParquetData::bloomFilterHashes(
+      absent, *VARCHAR(), thrift::Type::BYTE_ARRAY, hashes));
+  EXPECT_FALSE(mayContain(stringBloom, hashes));
+}
+
+TEST_F(ParquetReaderTest, pageIndexSkipsPages) {
+  // page_index.parquet holds two BIGINT columns c0: [0..999] and c1: c0 * 2
+  // in one row group with a ColumnIndex and OffsetIndex for each column. c0
+  // has 10 pages of 100 rows and c1 has 15 pages of 70 rows except the last.
+  // Only pages 2 and 7 of c0 have hits, so the other 8 pages are skipped.
+  auto schema = ROW({"c0", "c1"}, {BIGINT(), BIGINT()});
+  auto expected = vectorMaker_->rowVector(
+      {vectorMaker_->flatVector<int64_t>({250, 260, 750}),
+       vectorMaker_->flatVector<int64_t>({500, 520, 1'500})});
+
+  const auto filePath(getExampleFilePath("page_index.parquet"));
+  ReaderOptions readerOpts{defaultPool.get()};
+  auto reader = createReader(filePath, readerOpts);
+  EXPECT_EQ(reader.numberOfRows(), 1'000ULL);
+
+  auto scanSpec = makeScanSpec(schema);
+  scanSpec->getOrCreateChild(Subfield("c0"))
+      ->setFilter(createBigintValues({250, 260, 750}, false));
+  auto rowReaderOpts = getReaderOpts(schema);
+  rowReaderOpts.setScanSpec(scanSpec);
+  auto rowReader = reader.createRowReader(rowReaderOpts);
+  assertReadExpected(schema, *rowReader, expected, *pool_);
+
+  RuntimeStatistics stats;
+  rowReader->updateRuntimeStats(stats);
+  EXPECT_EQ(stats.skippedPages, 8);
+  EXPECT_EQ(stats.skippedStrides, 0);
+}
+
+TEST_F(ParquetReaderTest, bloomFilterSkipsRowGroups) {
+  // bloom_filter.parquet holds one BIGINT column c0 in two row groups of 100
+  // rows with a bloom filter each: even numbers in [0, 198] and odd numbers in
+  // [1, 199]. The min and max of both row groups include all the filtered
+  // values, so only the bloom filters skip row groups. The bloom filter
+  // header of the second row group is longer than the first read of a header.
+  auto schema = ROW({"c0"}, {BIGINT()});
+  auto read = [&](std::unique_ptr<Filter> filter, const VectorPtr& expected) {
+    const auto filePath(getExampleFilePath("bloom_filter.parquet"));
+    ReaderOptions readerOpts{defaultPool.get()};
+    auto reader = createReader(filePath, readerOpts);
+    EXPECT_EQ(reader.numberOfRows(), 200ULL);
+    auto scanSpec = makeScanSpec(schema);
+    scanSpec->getOrCreateChild(Subfield("c0"))->setFilter(std::move(filter));
+    auto rowReaderOpts = getReaderOpts(schema);
+    rowReaderOpts.setScanSpec(scanSpec);
+    auto rowReader = reader.createRowReader(rowReaderOpts);
+    assertReadExpected(
+        schema, *rowReader, vectorMaker_->rowVector({expected}), *pool_);
+    RuntimeStatistics stats;
+    rowReader->updateRuntimeStats(stats);
+    EXPECT_EQ(stats.skippedStrides, 1);
+  };
+
+  read(
+      std::make_unique<BigintRange>(101, 101, false),
+      vectorMaker_->flatVector<int64_t>({101}));
+  read(
+      createBigintValues({100, 102, 1'000}, false),
+      vectorMaker_->flatVector<int64_t>({100, 102}));
+}
@@ -86,6 +86,11 @@ class ThriftBufferedTransport : public ThriftTransport {
     return len;
   }
 
+  // Returns the number of bytes consumed by read().
+  uint64_t bytesRead() const {
+    return offset_;
+  }
+
  private:
   const uint8_t* inputBuf_;
   const uint64_t size_;
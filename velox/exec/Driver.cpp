@@ -71,7 +71,8 @@ std::optional<Spiller::Config> DriverCtx::makeSpillConfig(
           queryConfig.spillStartPartitionBit() +
               queryConfig.spillPartitionBits()),
       queryConfig.maxSpillLevel(),
-      queryConfig.testingSpillPct());
+      queryConfig.testingSpillPct(),
+      spillCompressionKindFromString(queryConfig.spillCompressionKind()));
 }
 
 std::atomic_uint64_t BlockingState::numBlockedDrivers_{0};
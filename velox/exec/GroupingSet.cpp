@@ -15,6 +15,8 @@
  */
 #include "velox/exec/GroupingSet.h"
 #include "velox/exec/Aggregate.h"
+#include "velox/exec/ContainerRowSerde.h"
+#include "velox/exec/OperatorUtils.h"
 #include "velox/exec/Task.h"
 
 namespace facebook::velox::exec {
@@ -45,6 +47,26 @@ std::vector<std::optional<column_index_t>> maskChannels(
   }
   return masks;
 }
+
+// Returns true if partial aggregation may pass through rows per hash
+// partition. Pass-through rows are converted to intermediate results like
+// after abandoning partial aggregation, which is not supported for masked and
+// sorted aggregates.
+bool canPassThroughPartitions(
+    const std::vector<AggregateInfo>& aggregates,
+    bool isPartial,
+    bool isRawInput,
+    bool hasKeys,
+    bool hasPreGroupedKeys) {
+  if (!isPartial || !isRawInput || !hasKeys || hasPreGroupedKeys ||
+      aggregates.empty()) {
+    return false;
+  }
+  return std::all_of(
+      aggregates.begin(), aggregates.end(), [](const auto& aggregate) {
+        return !aggregate.mask.has_value() && aggregate.sortingKeys.empty();
+      });
+}
 } // namespace
 
 GroupingSet::GroupingSet(
@@ -77,7 +99,26 @@ GroupingSet::GroupingSet(
                       ->queryCtx()
                       ->queryConfig()
                       .hashAdaptivityEnabled()),
-      pool_(*operatorCtx->pool()) {
+      pool_(*operatorCtx->pool()),
+      adaptivePartialAggregation_(
+          operatorCtx->driverCtx()
+              ->queryConfig()
+              .adaptivePartialAggregationEnabled() &&
+          canPassThroughPartitions(
+              aggregates_,
+              isPartial_,
+              isRawInput_,
+              !hashers_.empty(),
+              !preGroupedKeyChannels_.empty())),
+      passThroughMinRows_(std::max<int64_t>(
+          1,
+          operatorCtx->driverCtx()
+                  ->queryConfig()
+                  .abandonPartialAggregationMinRows() /
+              kNumPassThroughPartitions)),
+      passThroughMinPct_(operatorCtx->driverCtx()
+                             ->queryConfig()
+                             .abandonPartialAggregationMinPct()) {
   VELOX_CHECK_NOT_NULL(nonReclaimableSection_);
   VELOX_CHECK(pool_.trackUsage());
   for (auto& hasher : hashers_) {
@@ -216,7 +257,21 @@ void GroupingSet::addInputForActiveRows(
   *nonReclaimableSection_ = true;
 
   table_->prepareForProbe(*lookup_, input, activeRows_, ignoreNullKeys_);
+  if (adaptivePartialAggregation_) {
+    selectPassThroughRows(input);
+    if (passThroughInput_ != nullptr) {
+      // The aggregates see only part of the rows and the rest is read again
+      // by getPassThroughOutput().
+      mayPushdown = false;
+    }
+    if (lookup_->rows.empty()) {
+      return;
+    }
+  }
   table_->groupProbe(*lookup_);
+  if (adaptivePartialAggregation_) {
+    updatePassThroughPartitions();
+  }
   masks_.addInput(input, activeRows_);
 
   auto* groups = lookup_->hits.data();
@@ -327,6 +382,26 @@ void GroupingSet::createHashTable() {
         rows.rowSizeOffset());
   }
 
+  if (adaptivePartialAggregation_ &&
+      std::any_of(aggregates_.begin(), aggregates_.end(), [](const auto& agg) {
+        return !agg.function->supportsToIntermediate();
+      })) {
+    // Rows for converting pass-through rows to intermediate results. The
+    // layout is the same as in 'table_' so that the aggregates can use the
+    // offsets they got for 'table_'.
+    intermediateRows_ = std::make_unique<RowContainer>(
+        rows.keyTypes(),
+        !ignoreNullKeys_,
+        accumulators(),
+        std::vector<TypePtr>{},
+        false, // hasNext
+        false, // isJoinBuild
+        false, // hasProbedFlag
+        false, // hasNormalizedKey
+        &pool_,
+        ContainerRowSerde::instance());
+  }
+
   lookup_ = std::make_unique<HashLookup>(table_->hashers());
   if (!isAdaptive_ && table_->hashMode() != BaseHashTable::HashMode::kHash) {
     table_->forceGenericHashMode();
@@ -590,6 +665,73 @@ void GroupingSet::resetPartial() {
   if (table_ != nullptr) {
     table_->clear();
   }
+  partitionNumRows_.fill(0);
+  partitionNumNewGroups_.fill(0);
+}
+
+void GroupingSet::selectPassThroughRows(const RowVectorPtr& input) {
+  VELOX_CHECK_NULL(passThroughInput_);
+  auto& rows = lookup_->rows;
+  const auto& hashes = lookup_->hashes;
+  // The partitions are recorded before probing since probing in normalized
+  // key mode overwrites the hashes.
+  rowPartitions_.resize(activeRows_.end());
+  int32_t numKept = 0;
+  for (auto row : rows) {
+    const auto partition = passThroughPartition(hashes[row]);
+    if (passThroughPartitions_[partition]) {
+      passThroughRows_.push_back(row);
+      activeRows_.setValid(row, false);
+    } else {
+      rowPartitions_[row] = partition;
+      rows[numKept++] = row;
+    }
+  }
+  if (passThroughRows_.empty()) {
+    return;
+  }
+  rows.resize(numKept);
+  activeRows_.updateBounds();
+  // Lazy columns are loaded in full so that the aggregated rows and the rows
+  // passed through are read from the same vectors.
+  for (auto& child : input->children()) {
+    child->loadedVector();
+  }
+  passThroughInput_ = input;
+}
+
+void GroupingSet::updatePassThroughPartitions() {
+  for (auto row : lookup_->rows) {
+    ++partitionNumRows_[rowPartitions_[row]];
+  }
+  for (auto row : lookup_->newGroups) {
+    ++partitionNumNewGroups_[rowPartitions_[row]];
+  }
+  for (auto i = 0; i < kNumPassThroughPartitions; ++i) {
+    if (passThroughPartitions_[i] ||
+        partitionNumRows_[i] < passThroughMinRows_) {
+      continue;
+    }
+    if (100 * partitionNumNewGroups_[i] >=
+        passThroughMinPct_ * partitionNumRows_[i]) {
+      passThroughPartitions_[i] = true;
+      ++numPassThroughPartitions_;
+    }
+  }
+}
+
+void GroupingSet::getPassThroughOutput(RowVectorPtr& result) {
+  VELOX_CHECK_NOT_NULL(passThroughInput_);
+  const vector_size_t numRows = passThroughRows_.size();
+  auto indices = allocateIndices(numRows, &pool_);
+  std::copy(
+      passThroughRows_.begin(),
+      passThroughRows_.end(),
+      indices->asMutable<vector_size_t>());
+  auto input = exec::wrap(numRows, std::move(indices), passThroughInput_);
+  passThroughInput_ = nullptr;
+  passThroughRows_.clear();
+  toIntermediate(input, result);
 }
 
 bool GroupingSet::isPartialFull(int64_t maxBytes) {
@@ -740,7 +882,8 @@ void GroupingSet::spill(int64_t targetRows, int64_t targetBytes) {
         spillConfig_->maxFileSize,
         spillConfig_->minSpillRunSize,
         Spiller::spillPool(),
-        spillConfig_->executor);
+        spillConfig_->executor,
+        spillConfig_->compressionKind);
   }
   spiller_->spill(targetRows, targetBytes);
   if (table_->rows()->numRows() == 0) {
@@ -881,10 +1024,18 @@ void GroupingSet::abandonPartialAggregation() {
   table_ = nullptr;
 }
 
+void GroupingSet::clearAfterToIntermediate(Aggregate& function) const {
+  // Before abandoning, 'function' also accumulates for the groups in
+  // 'table_' and its state must be kept.
+  if (abandonedPartialAggregation_) {
+    function.clear();
+  }
+}
+
 void GroupingSet::toIntermediate(
     const RowVectorPtr& input,
     RowVectorPtr& result) {
-  VELOX_CHECK(abandonedPartialAggregation_);
+  VELOX_CHECK(abandonedPartialAggregation_ || adaptivePartialAggregation_);
   VELOX_CHECK(result.unique());
   if (!isRawInput_) {
     result = input;
@@ -931,7 +1082,7 @@ void GroupingSet::toIntermediate(
       std::fill(firstGroup_.begin(), firstGroup_.end(), intermediateGroups_[0]);
       function->extractAccumulators(
           firstGroup_.data(), intermediateGroups_.size(), &aggregateVector);
-      function->clear();
+      clearAfterToIntermediate(*function);
       continue;
     }
 
@@ -951,7 +1102,7 @@ void GroupingSet::toIntermediate(
         intermediateGroups_.data(),
         intermediateGroups_.size(),
         &aggregateVector);
-    function->clear();
+    clearAfterToIntermediate(*function);
   }
   if (intermediateRows_) {
     intermediateRows_->eraseRows(folly::Range<char**>(
@@ -121,7 +121,44 @@ class GroupingSet {
   /// Returns an estimate of the average row size.
   std::optional<int64_t> estimateRowSize() const;
 
+  /// Returns true if the last addInput() passed through rows of partitions
+  /// that are not reducing well and getPassThroughOutput() must be called
+  /// before adding more input. Only happens in adaptive partial aggregation.
+  bool hasPassThroughOutput() const {
+    return passThroughInput_ != nullptr;
+  }
+
+  /// Translates the rows passed through by the last addInput() to
+  /// intermediate results in 'result'.
+  void getPassThroughOutput(RowVectorPtr& result);
+
+  /// Returns the number of hash partitions whose rows are passed through.
+  int32_t numPassThroughPartitions() const {
+    return numPassThroughPartitions_;
+  }
+
+  /// Number of hash partitions tracked by adaptive partial aggregation.
+  static constexpr int32_t kNumPassThroughPartitions = 16;
+
  private:
+  // Returns the hash partition of a row with 'hash' from the lookup.
+  static int32_t passThroughPartition(uint64_t hash) {
+    return (hash * 0x9E3779B97F4A7C15ULL) >> 60;
+  }
+
+  // Assigns the rows of 'lookup_' to hash partitions. Removes the rows of
+  // pass-through partitions from 'activeRows_' and 'lookup_' and remembers
+  // them for getPassThroughOutput().
+  void selectPassThroughRows(const RowVectorPtr& input);
+
+  // Clears the state 'function' keeps about groups after converting rows to
+  // intermediate results with 'intermediateRows_'.
+  void clearAfterToIntermediate(Aggregate& function) const;
+
+  // Updates the per-partition reduction after a probe of 'lookup_' and starts
+  // passing through partitions that do not reduce well.
+  void updatePassThroughPartitions();
+
   void addInputForActiveRows(const RowVectorPtr& input, bool mayPushdown);
 
   void addRemainingInput();
@@ -308,6 +345,34 @@ class GroupingSet {
   // Temporary for case where an aggregate in toIntermediate() outputs post-init
   // state of aggregate for all rows.
   std::vector<char*> firstGroup_;
+
+  // True if partial aggregation decides per hash partition between
+  // aggregating and passing rows through. Set if enabled in the query config
+  // for a partial aggregation of raw input without masks or sorting keys.
+  const bool adaptivePartialAggregation_;
+
+  // Minimum number of rows per partition before deciding to pass it through.
+  const int64_t passThroughMinRows_;
+
+  // Minimum percentage of new groups per input row for passing through.
+  const int32_t passThroughMinPct_;
+
+  // Number of input rows and new groups per partition since the last
+  // resetPartial().
+  std::array<int64_t, kNumPassThroughPartitions> partitionNumRows_{};
+  std::array<int64_t, kNumPassThroughPartitions> partitionNumNewGroups_{};
+
+  // True for the partitions that are passed through. Once a partition is
+  // passed through it stays so for the lifetime of 'this'.
+  std::array<bool, kNumPassThroughPartitions> passThroughPartitions_{};
+  int32_t numPassThroughPartitions_{0};
+
+  // Hash partition of each row of 'lookup_' in the current input.
+  std::vector<uint8_t> rowPartitions_;
+
+  // Input and rows of the last addInput() that are passed through.
+  RowVectorPtr passThroughInput_;
+  std::vector<vector_size_t> passThroughRows_;
 };
 
 } // namespace facebook::velox::exec
@@ -226,6 +226,10 @@ void HashAggregation::updateRuntimeStats() {
       RuntimeMetric(hashTableStats.numDistinct);
   runtimeStats["hashtable.numTombstones"] =
       RuntimeMetric(hashTableStats.numTombstones);
+  if (groupingSet_->numPassThroughPartitions() > 0) {
+    runtimeStats["passThroughPartitions"] =
+        RuntimeMetric(groupingSet_->numPassThroughPartitions());
+  }
 }
 
 void HashAggregation::recordSpillStats() {
@@ -315,6 +319,15 @@ RowVectorPtr HashAggregation::getOutput() {
     input_ = nullptr;
     return nullptr;
   }
+  if (groupingSet_->hasPassThroughOutput()) {
+    // Rows of hash partitions that do not reduce well in adaptive partial
+    // aggregation. These go out before any flush of the hash table.
+    prepareOutput(0);
+    groupingSet_->getPassThroughOutput(output_);
+    numOutputRows_ += output_->size();
+    addRuntimeStat("passThroughRows", RuntimeCounter(output_->size()));
+    return output_;
+  }
   if (abandonedPartialAggregation_) {
     if (noMoreInput_) {
       finished_ = true;
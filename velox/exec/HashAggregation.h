@@ -32,7 +32,8 @@ class HashAggregation : public Operator {
   RowVectorPtr getOutput() override;
 
   bool needsInput() const override {
-    return !noMoreInput_ && !partialFull_;
+    return !noMoreInput_ && !partialFull_ &&
+        !groupingSet_->hasPassThroughOutput();
   }
 
   void noMoreInput() override;
@@ -209,7 +209,8 @@ void HashBuild::setupSpiller(SpillPartition* spillPartition) {
       spillConfig.maxFileSize,
       spillConfig.minSpillRunSize,
       Spiller::spillPool(),
-      spillConfig.executor);
+      spillConfig.executor,
+      spillConfig.compressionKind);
 
   const int32_t numPartitions = spiller_->hashBits().numPartitions();
   spillInputIndicesBuffers_.resize(numPartitions);
@@ -753,6 +754,14 @@ bool HashBuild::finishHashBuild() {
           lockedStats->spilledRows += spillStats.spilledRows;
           lockedStats->spilledPartitions += spillStats.spilledPartitions;
           lockedStats->spilledFiles += spillStats.spilledFiles;
+          if (spillStats.spilledBytes > 0) {
+            lockedStats->addRuntimeStat(
+                fmt::format(
+                    "spilledBytesAtLevel{}",
+                    spillConfig()->spillLevel(spiller_->hashBits().begin())),
+                RuntimeCounter(
+                    spillStats.spilledBytes, RuntimeCounter::Unit::kBytes));
+          }
         }
 
         spiller_->finishSpill(spillPartitions);
@@ -773,11 +782,16 @@ bool HashBuild::finishHashBuild() {
           allowPrallelJoinBuild ? operatorCtx_->task()->queryCtx()->executor()
                                 : nullptr);
 
+      auto keyBloomFilters = spillPartitions.empty()
+          ? makeKeyBloomFilters()
+          : std::vector<std::shared_ptr<common::Filter>>{};
+
       addRuntimeStats();
       if (joinBridge_->setHashTable(
               std::move(table_),
               std::move(spillPartitions),
-              joinHasNullKeys_)) {
+              joinHasNullKeys_,
+              std::move(keyBloomFilters))) {
         spillGroup_->restart();
       }
     }
@@ -786,6 +800,135 @@ bool HashBuild::finishHashBuild() {
   return true;
 }
 
+namespace {
+template <typename T>
+void addTypedKeysToBloomFilter(
+    const BaseVector& keys,
+    vector_size_t numRows,
+    SplitBlockBloomFilter<>& bloomFilter) {
+  const auto* flatKeys = keys.asUnchecked<FlatVector<T>>();
+  for (auto i = 0; i < numRows; ++i) {
+    if (flatKeys->isNullAt(i)) {
+      continue;
+    }
+    const auto value = flatKeys->valueAt(i);
+    if constexpr (std::is_same_v<T, StringView>) {
+      bloomFilter.insert(common::ValuesUsingBloomFilter::hashBytes(
+          value.data(), value.size()));
+    } else if constexpr (std::is_same_v<T, Date>) {
+      bloomFilter.insert(
+          common::ValuesUsingBloomFilter::hashInt64(value.days()));
+    } else {
+      bloomFilter.insert(common::ValuesUsingBloomFilter::hashInt64(value));
+    }
+  }
+}
+
+void addToBloomFilter(
+    const BaseVector& keys,
+    vector_size_t numRows,
+    SplitBlockBloomFilter<>& bloomFilter) {
+  switch (keys.typeKind()) {
+    case TypeKind::TINYINT:
+      return addTypedKeysToBloomFilter<int8_t>(keys, numRows, bloomFilter);
+    case TypeKind::SMALLINT:
+      return addTypedKeysToBloomFilter<int16_t>(keys, numRows, bloomFilter);
+    case TypeKind::INTEGER:
+      return addTypedKeysToBloomFilter<int32_t>(keys, numRows, bloomFilter);
+    case TypeKind::BIGINT:
+      return addTypedKeysToBloomFilter<int64_t>(keys, numRows, bloomFilter);
+    case TypeKind::DATE:
+      return addTypedKeysToBloomFilter<Date>(keys, numRows, bloomFilter);
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      return addTypedKeysToBloomFilter<StringView>(keys, numRows, bloomFilter);
+    default:
+      VELOX_UNREACHABLE(
+          "Unsupported Bloom filter key type: {}", keys.type()->toString());
+  }
+}
+
+// Returns true if the pushed down Bloom filter on a key of 'type' can be
+// evaluated by the table scan, see ValuesUsingBloomFilter.
+bool isBloomFilterKeyType(const Type& type) {
+  switch (type.kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::DATE:
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      return true;
+    default:
+      return false;
+  }
+}
+} // namespace
+
+std::vector<std::shared_ptr<common::Filter>> HashBuild::makeKeyBloomFilters()
+    const {
+  const auto& queryConfig = operatorCtx_->driverCtx()->queryConfig();
+  // Only the joins which drop the probe rows without a match can filter the
+  // probe input, the same as for the exact filters pushed down by HashProbe.
+  // If the table is not in kHash mode, the probe side pushes down exact
+  // filters instead.
+  if (!queryConfig.hashJoinBloomFilterPushdownEnabled() ||
+      !(isInnerJoin(joinType_) || isLeftSemiFilterJoin(joinType_) ||
+        isRightSemiFilterJoin(joinType_) ||
+        isRightSemiProjectJoin(joinType_)) ||
+      table_->hashMode() != BaseHashTable::HashMode::kHash ||
+      table_->numDistinct() == 0 ||
+      table_->numDistinct() > queryConfig.hashJoinBloomFilterMaxEntries()) {
+    return {};
+  }
+
+  const auto numKeys = keyChannels_.size();
+  std::vector<SplitBlockBloomFilter<>> bloomFilters(numKeys);
+  std::vector<VectorPtr> keys(numKeys);
+  bool hasBloomFilter = false;
+  for (auto i = 0; i < numKeys; ++i) {
+    if (isBloomFilterKeyType(*tableType_->childAt(i))) {
+      bloomFilters[i].reset(table_->numDistinct());
+      hasBloomFilter = true;
+    }
+  }
+  if (!hasBloomFilter) {
+    return {};
+  }
+
+  constexpr int32_t kBatchSize = 1'024;
+  std::vector<char*> rows(kBatchSize);
+  BaseHashTable::RowsIterator iter;
+  for (;;) {
+    const auto numRows = table_->listAllRows(
+        &iter, kBatchSize, RowContainer::kUnlimited, rows.data());
+    if (numRows == 0) {
+      break;
+    }
+    for (auto i = 0; i < numKeys; ++i) {
+      if (!bloomFilters[i].isSet()) {
+        continue;
+      }
+      if (keys[i] == nullptr) {
+        keys[i] =
+            BaseVector::create(tableType_->childAt(i), kBatchSize, pool());
+      }
+      table_->rows()->extractColumn(rows.data(), numRows, i, keys[i]);
+      addToBloomFilter(*keys[i], numRows, bloomFilters[i]);
+    }
+  }
+
+  std::vector<std::shared_ptr<common::Filter>> filters(numKeys);
+  for (auto i = 0; i < numKeys; ++i) {
+    if (bloomFilters[i].isSet()) {
+      filters[i] = std::make_shared<common::ValuesUsingBloomFilter>(
+          std::move(bloomFilters[i]), false);
+    }
+  }
+  return filters;
+}
+
 void HashBuild::postHashBuildProcess() {
   checkRunning();
 
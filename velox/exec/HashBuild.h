@@ -100,6 +100,13 @@ class HashBuild final : public Operator {
   // barrier for the next round of hash table build operation if it needs.
   bool finishHashBuild();
 
+  // Invoked by the last build driver after the hash table has been built to
+  // produce the Bloom filters over the join keys to push down into the probe
+  // side scan. Returns an empty vector if it doesn't apply to the join or the
+  // hash table, otherwise one filter per join key with null for the keys of
+  // unsupported types.
+  std::vector<std::shared_ptr<common::Filter>> makeKeyBloomFilters() const;
+
   // Invoked after the hash table has been built. It waits for any spill data to
   // process after the probe side has finished processing the previously built
   // hash table. If disk spilling is not enabled or there is no more spill data,
@@ -41,7 +41,8 @@ void HashJoinBridge::addBuilder() {
 bool HashJoinBridge::setHashTable(
     std::unique_ptr<BaseHashTable> table,
     SpillPartitionSet spillPartitionSet,
-    bool hasNullKeys) {
+    bool hasNullKeys,
+    std::vector<std::shared_ptr<common::Filter>> keyBloomFilters) {
   VELOX_CHECK_NOT_NULL(table, "setHashTable called with null table");
 
   auto spillPartitionIdSet = toSpillPartitionIdSet(spillPartitionSet);
@@ -71,7 +72,8 @@ bool HashJoinBridge::setHashTable(
         std::move(table),
         std::move(restoringSpillPartitionId_),
         std::move(spillPartitionIdSet),
-        hasNullKeys);
+        hasNullKeys,
+        std::move(keyBloomFilters));
     restoringSpillPartitionId_.reset();
 
     hasSpillData = !spillPartitionSets_.empty();
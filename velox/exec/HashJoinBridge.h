@@ -37,11 +37,14 @@ class HashJoinBridge : public JoinBridge {
   /// 'spillPartitionSet' contains the spilled partitions while building
   /// 'table'. The function returns true if there is spill data to restore
   /// after HashProbe operators process 'table', otherwise false. This only
-  /// applies if the disk spilling is enabled.
+  /// applies if the disk spilling is enabled. 'keyBloomFilters' optionally
+  /// contains one Bloom filter per join key for the probe side to push down,
+  /// see HashBuildResult.
   bool setHashTable(
       std::unique_ptr<BaseHashTable> table,
       SpillPartitionSet spillPartitionSet,
-      bool hasNullKeys);
+      bool hasNullKeys,
+      std::vector<std::shared_ptr<common::Filter>> keyBloomFilters = {});
 
   void setAntiJoinHasNullKeys();
 
@@ -56,11 +59,13 @@ class HashJoinBridge : public JoinBridge {
         std::shared_ptr<BaseHashTable> _table,
         std::optional<SpillPartitionId> _restoredPartitionId,
         SpillPartitionIdSet _spillPartitionIds,
-        bool _hasNullKeys)
+        bool _hasNullKeys,
+        std::vector<std::shared_ptr<common::Filter>> _keyBloomFilters = {})
         : hasNullKeys(_hasNullKeys),
           table(std::move(_table)),
           restoredPartitionId(std::move(_restoredPartitionId)),
-          spillPartitionIds(std::move(_spillPartitionIds)) {}
+          spillPartitionIds(std::move(_spillPartitionIds)),
+          keyBloomFilters(std::move(_keyBloomFilters)) {}
 
     HashBuildResult() : hasNullKeys(true) {}
 
@@ -68,6 +73,11 @@ class HashJoinBridge : public JoinBridge {
     std::shared_ptr<BaseHashTable> table;
     std::optional<SpillPartitionId> restoredPartitionId;
     SpillPartitionIdSet spillPartitionIds;
+    /// Bloom filters over the join keys of 'table', indexed by join key. Empty
+    /// if not built. An entry is null if the key type is not supported. Only
+    /// produced if 'table' is in kHash mode, in which case the probe side can't
+    /// derive exact filters from the table's VectorHashers.
+    std::vector<std::shared_ptr<common::Filter>> keyBloomFilters;
   };
 
   /// Invoked by HashProbe operator to get the table to probe which is built by
@@ -247,7 +247,8 @@ void HashProbe::maybeSetupSpillInput(
       spillConfig.maxFileSize,
       spillConfig.minSpillRunSize,
       Spiller::spillPool(),
-      spillConfig.executor);
+      spillConfig.executor,
+      spillConfig.compressionKind);
   // Set the spill partitions to the corresponding ones at the build side. The
   // hash probe operator itself won't trigger any spilling.
   spiller_->setPartitionsSpilled(toPartitionNumSet(spillInputPartitionIds_));
@@ -298,24 +299,32 @@ void HashProbe::asyncWaitForHashTable() {
   } else if (
       (isInnerJoin(joinType_) || isLeftSemiFilterJoin(joinType_) ||
        isRightSemiFilterJoin(joinType_) || isRightSemiProjectJoin(joinType_)) &&
-      table_->hashMode() != BaseHashTable::HashMode::kHash && !isSpillInput() &&
-      !hasMoreSpillData()) {
+      (table_->hashMode() != BaseHashTable::HashMode::kHash ||
+       !hashBuildResult->keyBloomFilters.empty()) &&
+      !isSpillInput() && !hasMoreSpillData()) {
     // Find out whether there are any upstream operators that can accept
     // dynamic filters on all or a subset of the join keys. Create dynamic
-    // filters to push down.
+    // filters to push down. In kHash mode, the hashers can't produce exact
+    // filters, so push down the Bloom filters made by the build side instead.
     //
     // NOTE: this optimization is not applied in the following cases: (1) if the
     // probe input is read from spilled data and there is no upstream operators
     // involved; (2) if there is spill data to restore, then we can't filter
     // probe inputs solely based on the current table's join keys.
     const auto& buildHashers = table_->hashers();
+    const auto& keyBloomFilters = hashBuildResult->keyBloomFilters;
     auto channels = operatorCtx_->driverCtx()->driver->canPushdownFilters(
         this, keyChannels_);
     for (auto i = 0; i < keyChannels_.size(); i++) {
-      if (channels.find(keyChannels_[i]) != channels.end()) {
+      if (channels.find(keyChannels_[i]) == channels.end()) {
+        continue;
+      }
+      if (table_->hashMode() != BaseHashTable::HashMode::kHash) {
         if (auto filter = buildHashers[i]->getFilter(false)) {
           dynamicFilters_.emplace(keyChannels_[i], std::move(filter));
         }
+      } else if (keyBloomFilters[i] != nullptr) {
+        dynamicFilters_.emplace(keyChannels_[i], keyBloomFilters[i]);
       }
     }
   }
@@ -363,6 +372,9 @@ void HashProbe::addSpillInput() {
     noMoreInputInternal();
     return;
   }
+  // Probe rows read back from disk. Together with the input rows, this gives
+  // the re-read amplification of recursive spilling.
+  addRuntimeStat("spillReadRows", RuntimeCounter(input_->size()));
 
   addInput(std::move(input_));
 }
@@ -475,9 +487,11 @@ void HashProbe::clearDynamicFilters() {
   // The join can be completely replaced with a pushed down
   // filter when the following conditions are met:
   //  * hash table has a single key with unique values,
-  //  * build side has no dependent columns.
+  //  * build side has no dependent columns,
+  //  * the pushed down filter is exact, i.e. not a Bloom filter.
   if (keyChannels_.size() == 1 && !table_->hasDuplicateKeys() &&
-      tableOutputProjections_.empty() && !filter_ && !dynamicFilters_.empty()) {
+      tableOutputProjections_.empty() && !filter_ && !dynamicFilters_.empty() &&
+      table_->hashMode() != BaseHashTable::HashMode::kHash) {
     canReplaceWithDynamicFilter_ = true;
   }
 
@@ -1344,6 +1358,17 @@ void HashProbe::noMoreInputInternal() {
   if (!spillInputPartitionIds_.empty()) {
     VELOX_CHECK_EQ(
         spillInputPartitionIds_.size(), spiller_->spilledPartitionSet().size());
+    // Only reported as runtime stats. The operator spill stats count the build
+    // side partitions.
+    const auto spillStats = spiller_->stats();
+    if (spillStats.spilledBytes > 0) {
+      addRuntimeStat(
+          fmt::format(
+              "spilledBytesAtLevel{}",
+              spillConfig_->spillLevel(spiller_->hashBits().begin())),
+          RuntimeCounter(
+              spillStats.spilledBytes, RuntimeCounter::Unit::kBytes));
+    }
     spiller_->finishSpill(spillPartitionSet_);
   }
 
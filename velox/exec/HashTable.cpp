@@ -55,7 +55,9 @@ HashTable<ignoreNullKeys>::HashTable(
     bool isJoinBuild,
     bool hasProbedFlag,
     memory::MemoryPool* pool)
-    : BaseHashTable(std::move(hashers)), isJoinBuild_(isJoinBuild) {
+    : BaseHashTable(std::move(hashers)),
+      isJoinBuild_(isJoinBuild),
+      simdNormalizedKeyProbe_(process::hasAvx2()) {
   std::vector<TypePtr> keys;
   for (auto& hasher : hashers_) {
     keys.push_back(hasher->type());
@@ -391,11 +393,26 @@ FOLLY_ALWAYS_INLINE void HashTable<ignoreNullKeys>::fullProbe(
 }
 
 namespace {
+// Same as folly::hash::twang_mix64() but also works on a batch of
+// keys. Uses only shifts and adds, which have SIMD versions for 64 bit
+// lanes on AVX2.
+template <typename T>
+FOLLY_ALWAYS_INLINE T twangMix64(T key) {
+  key = (~key) + (key << 21);
+  key = key ^ (key >> 24);
+  key = (key + (key << 3)) + (key << 8);
+  key = key ^ (key >> 14);
+  key = (key + (key << 2)) + (key << 4);
+  key = key ^ (key >> 28);
+  key = key + (key << 31);
+  return key;
+}
+
 // Normalized keys have non0-random bits. Bits need to be propagated
 // up to make a tag byte and down so that non-lowest bits of
 // normalized key affect the hash table index.
-inline uint64_t mixNormalizedKey(uint64_t k, uint8_t bits) {
-  return folly::hasher<uint64_t>()(k);
+inline uint64_t mixNormalizedKey(uint64_t k, uint8_t /*bits*/) {
+  return twangMix64(k);
 }
 
 void populateNormalizedKeys(HashLookup& lookup, int8_t sizeBits) {
@@ -405,8 +422,16 @@ void populateNormalizedKeys(HashLookup& lookup, int8_t sizeBits) {
   int32_t end = lookup.rows.back() + 1;
   if (end / 4 < lookup.rows.size()) {
     // For more than 1/4 of the positions in use, run the loop on all
-    // elements, since the loop will do 4 at a time.
-    for (auto row = 0; row < end; ++row) {
+    // elements, since the loop will do a SIMD width at a time.
+    using Batch = xsimd::batch<uint64_t>;
+    int32_t row = 0;
+    for (; row + static_cast<int32_t>(Batch::size) <= end;
+         row += Batch::size) {
+      auto hash = Batch::load_unaligned(hashes + row);
+      hash.store_unaligned(keys + row);
+      twangMix64(hash).store_unaligned(hashes + row);
+    }
+    for (; row < end; ++row) {
       auto hash = hashes[row];
       keys[row] = hash; // NOLINT
       hashes[row] = mixNormalizedKey(hash, sizeBits);
@@ -565,9 +590,93 @@ void HashTable<ignoreNullKeys>::joinProbe(HashLookup& lookup) {
   }
 }
 
+template <bool ignoreNullKeys>
+int32_t HashTable<ignoreNullKeys>::joinNormalizedKeyProbeSimd(
+    HashLookup& lookup) {
+  using Batch = xsimd::batch<int64_t>;
+  constexpr int32_t kWidth = Batch::size;
+  const int32_t numProbes = lookup.rows.size();
+  const vector_size_t* rows = lookup.rows.data();
+  const uint64_t* keys = lookup.normalizedKeys.data();
+  const uint64_t* hashes = lookup.hashes.data();
+  char** hits = lookup.hits.data();
+  const auto kEmptyGroup = TagVector::broadcast(ProbeState::kEmptyTag);
+  // The normalized key is right below the row, see
+  // RowContainer::normalizedKey().
+  const auto kKeyOffset =
+      Batch::broadcast(-static_cast<int64_t>(sizeof(normalized_key_t)));
+  alignas(64) int64_t candidates[kWidth];
+  ProbeState state;
+  int32_t probeIndex = 0;
+  for (; probeIndex + kWidth <= numProbes; probeIndex += kWidth) {
+    uint16_t hasCandidate = 0;
+    uint16_t unresolved = 0;
+    for (auto lane = 0; lane < kWidth; ++lane) {
+      const auto row = rows[probeIndex + lane];
+      const auto hash = hashes[row];
+      const auto tagIndex = ProbeState::tagsByteOffset(hash, sizeMask_);
+      const auto tagsInTable = loadTags(tags_, tagIndex);
+      const uint16_t tagHits = simd::toBitMask(
+          tagsInTable == TagVector::broadcast(hashTag(hash)));
+      candidates[lane] = 0;
+      if (tagHits) {
+        candidates[lane] = tagIndex + __builtin_ctz(tagHits);
+        hasCandidate |= 1 << lane;
+      } else if (simd::toBitMask(tagsInTable == kEmptyGroup)) {
+        hits[row] = nullptr;
+      } else {
+        unresolved |= 1 << lane;
+      }
+    }
+    if (hasCandidate) {
+      const auto mask = simd::fromBitMask<int64_t>(hasCandidate);
+      const auto zero = Batch::broadcast(0);
+      // The indices are passed as a batch, which has a gather for every
+      // architecture.
+      const auto groups = simd::maskGather(
+          zero,
+          mask,
+          reinterpret_cast<const int64_t*>(table_),
+          Batch::load_aligned(candidates));
+      // The rows are at arbitrary addresses, so the gather is relative to a
+      // null base with a scale of 1.
+      const auto groupKeys = simd::maskGather<int64_t, int64_t, 1>(
+          zero,
+          mask,
+          static_cast<const int64_t*>(nullptr),
+          groups + kKeyOffset);
+      const auto wantedKeys = simd::gather(
+          reinterpret_cast<const int64_t*>(keys), rows + probeIndex);
+      const uint16_t matches =
+          simd::toBitMask(groupKeys == wantedKeys) & hasCandidate;
+      groups.store_aligned(candidates);
+      for (auto lane = 0; lane < kWidth; ++lane) {
+        if (matches & (1 << lane)) {
+          hits[rows[probeIndex + lane]] =
+              reinterpret_cast<char*>(candidates[lane]);
+        }
+      }
+      // A first tag match with a different key is resolved by the full probe.
+      unresolved |= hasCandidate & ~matches;
+    }
+    while (unresolved) {
+      const auto row =
+          rows[probeIndex + bits::getAndClearLastSetBit(unresolved)];
+      state.preProbe(tags_, sizeMask_, hashes[row], row);
+      state.firstProbe(table_, 0);
+      hits[row] =
+          state.joinNormalizedKeyFullProbe(tags_, table_, sizeMask_, keys);
+    }
+  }
+  return probeIndex;
+}
+
 template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::joinNormalizedKeyProbe(HashLookup& lookup) {
   int32_t probeIndex = 0;
+  if (simdNormalizedKeyProbe_) {
+    probeIndex = joinNormalizedKeyProbeSimd(lookup);
+  }
   int32_t numProbes = lookup.rows.size();
   const vector_size_t* rows = lookup.rows.data();
   ProbeState state1;
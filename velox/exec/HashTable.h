@@ -478,6 +478,11 @@ class HashTable : public BaseHashTable {
     setHashMode(mode, numNew);
   }
 
+  /// Enables or disables the SIMD batch probe of kNormalizedKey join tables.
+  void testingSetSimdNormalizedKeyProbe(bool enable) {
+    simdNormalizedKeyProbe_ = enable;
+  }
+
  private:
   // Returns the number of entries after which the table gets rehashed.
   static uint64_t rehashSize(int64_t size) {
@@ -628,6 +633,13 @@ class HashTable : public BaseHashTable {
   // Shortcut for probe with normalized keys.
   void joinNormalizedKeyProbe(HashLookup& lookup);
 
+  // Probes batches of rows of 'lookup' in kNormalizedKey mode. Compares the
+  // first tag group of each row of a batch and checks the normalized keys of
+  // the first tag matches with gathered loads. Rows that are not resolved by
+  // this go through the full probe one at a time. Returns the number of rows
+  // processed, which is a multiple of the batch size.
+  int32_t joinNormalizedKeyProbeSimd(HashLookup& lookup);
+
   // Adds a row to a hash join table in kArray hash mode. Returns true
   // if a new entry was made and false if the row was added to an
   // existing set of rows with the same key.
@@ -669,6 +681,10 @@ class HashTable : public BaseHashTable {
   int8_t sizeBits_;
   bool isJoinBuild_ = false;
 
+  // If true, joinNormalizedKeyProbe() starts with
+  // joinNormalizedKeyProbeSimd(). True if the CPU has AVX2.
+  bool simdNormalizedKeyProbe_;
+
   // Set at join build time if the table has duplicates, meaning that
   // the join can be cardinality increasing. Atomic for tsan because
   // many threads can set this.
@@ -29,55 +29,65 @@ void notify(std::vector<ContinuePromise>& promises) {
 bool LocalExchangeMemoryManager::increaseMemoryUsage(
     ContinueFuture* future,
     int64_t added) {
-  std::lock_guard<std::mutex> l(mutex_);
-  bufferedBytes_ += added;
-
-  if (bufferedBytes_ >= maxBufferSize_) {
-    promises_.emplace_back("LocalExchangeMemoryManager::updateMemoryUsage");
-    *future = promises_.back().getSemiFuture();
-    return true;
+  if (bufferedBytes_.fetch_add(added) + added < maxBufferSize_) {
+    return false;
   }
 
-  return false;
+  std::lock_guard<std::mutex> l(mutex_);
+  // Publish the promise before checking the size again. A concurrent
+  // decreaseMemoryUsage() either sees 'hasPromises_' or is seen here.
+  hasPromises_ = true;
+  if (bufferedBytes_ < maxBufferSize_) {
+    hasPromises_ = !promises_.empty();
+    return false;
+  }
+  promises_.emplace_back("LocalExchangeMemoryManager::updateMemoryUsage");
+  *future = promises_.back().getSemiFuture();
+  return true;
 }
 
 std::vector<ContinuePromise> LocalExchangeMemoryManager::decreaseMemoryUsage(
     int64_t removed) {
   std::vector<ContinuePromise> promises;
+  if (bufferedBytes_.fetch_sub(removed) - removed >= maxBufferSize_ ||
+      !hasPromises_) {
+    return promises;
+  }
   {
     std::lock_guard<std::mutex> l(mutex_);
-    bufferedBytes_ -= removed;
-
     if (bufferedBytes_ < maxBufferSize_) {
       promises = std::move(promises_);
+      hasPromises_ = false;
     }
   }
   return promises;
 }
 
 void LocalExchangeQueue::addProducer() {
-  queue_.withWLock([&](auto& /*queue*/) {
-    VELOX_CHECK(!noMoreProducers_, "addProducer called after noMoreProducers");
-    ++pendingProducers_;
-  });
+  std::lock_guard<std::mutex> l(mutex_);
+  VELOX_CHECK(!noMoreProducers_, "addProducer called after noMoreProducers");
+  ++pendingProducers_;
 }
 
 void LocalExchangeQueue::noMoreProducers() {
   std::vector<ContinuePromise> consumerPromises;
   std::vector<ContinuePromise> producerPromises;
-  queue_.withWLock([&](auto& queue) {
+  {
+    std::lock_guard<std::mutex> l(mutex_);
     VELOX_CHECK(!noMoreProducers_, "noMoreProducers can be called only once");
     noMoreProducers_ = true;
     if (pendingProducers_ == 0) {
       // No more data will be produced.
+      noMoreData_ = true;
       consumerPromises = std::move(consumerPromises_);
+      hasConsumerPromises_ = false;
 
-      if (queue.empty()) {
+      if (queue_.empty()) {
         // All data has been consumed.
         producerPromises = std::move(producerPromises_);
       }
     }
-  });
+  }
   notify(consumerPromises);
   notify(producerPromises);
 }
@@ -85,29 +95,33 @@ void LocalExchangeQueue::noMoreProducers() {
 BlockingReason LocalExchangeQueue::enqueue(
     RowVectorPtr input,
     ContinueFuture* future) {
+  if (closed_) {
+    return BlockingReason::kNotBlocked;
+  }
   auto inputBytes = input->estimateFlatSize();
+  queue_.enqueue(std::move(input));
+  const bool blockedOnConsumer =
+      memoryManager_->increaseMemoryUsage(future, inputBytes);
 
-  std::vector<ContinuePromise> consumerPromises;
-  bool blockedOnConsumer = false;
-  bool isClosed = queue_.withWLock([&](auto& queue) {
-    if (closed_) {
-      return true;
-    }
-    queue.push(std::move(input));
-    consumerPromises = std::move(consumerPromises_);
-
-    if (memoryManager_->increaseMemoryUsage(future, inputBytes)) {
-      blockedOnConsumer = true;
-    }
-
-    return false;
-  });
-
-  if (isClosed) {
+  // Pairs with the fences in next() and close(). Either the consumer or
+  // closer sees 'input' or this sees their flag.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (closed_) {
+    // close() may have drained the queue before 'input' was added.
+    auto memoryPromises = drain();
+    notify(memoryPromises);
     return BlockingReason::kNotBlocked;
   }
 
-  notify(consumerPromises);
+  if (hasConsumerPromises_) {
+    std::vector<ContinuePromise> consumerPromises;
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      consumerPromises = std::move(consumerPromises_);
+      hasConsumerPromises_ = false;
+    }
+    notify(consumerPromises);
+  }
 
   if (blockedOnConsumer) {
     return BlockingReason::kWaitForConsumer;
@@ -119,30 +133,40 @@ BlockingReason LocalExchangeQueue::enqueue(
 void LocalExchangeQueue::noMoreData() {
   std::vector<ContinuePromise> consumerPromises;
   std::vector<ContinuePromise> producerPromises;
-  queue_.withWLock([&](auto queue) {
+  {
+    std::lock_guard<std::mutex> l(mutex_);
     VELOX_CHECK_GT(pendingProducers_, 0);
     --pendingProducers_;
     if (noMoreProducers_ && pendingProducers_ == 0) {
+      noMoreData_ = true;
       consumerPromises = std::move(consumerPromises_);
-      if (queue.empty()) {
+      hasConsumerPromises_ = false;
+      // Pairs with the fence in next(). Either the consumer fetching the last
+      // data sees 'noMoreData_' or this sees the empty queue.
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (queue_.empty()) {
         producerPromises = std::move(producerPromises_);
       }
     }
-  });
+  }
   notify(consumerPromises);
   notify(producerPromises);
 }
 
 BlockingReason LocalExchangeQueue::next(
     ContinueFuture* future,
-    memory::MemoryPool* pool,
+    memory::MemoryPool* /*pool*/,
     RowVectorPtr* data) {
-  std::vector<ContinuePromise> producerPromises;
-  std::vector<ContinuePromise> memoryPromises;
-  auto blockingReason = queue_.withWLock([&](auto& queue) {
-    *data = nullptr;
-    if (queue.empty()) {
-      if (isFinishedLocked(queue)) {
+  *data = nullptr;
+  if (!queue_.try_dequeue(*data)) {
+    std::lock_guard<std::mutex> l(mutex_);
+    // Publish the wait before looking at the queue again. A concurrent
+    // enqueue() either sees 'hasConsumerPromises_' or is seen here.
+    hasConsumerPromises_ = true;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!queue_.try_dequeue(*data)) {
+      if (isFinished()) {
+        hasConsumerPromises_ = !consumerPromises_.empty();
         return BlockingReason::kNotBlocked;
       }
 
@@ -151,73 +175,80 @@ BlockingReason LocalExchangeQueue::next(
 
       return BlockingReason::kWaitForProducer;
     }
+    hasConsumerPromises_ = !consumerPromises_.empty();
+  }
 
-    *data = queue.front();
-    queue.pop();
-
-    memoryPromises =
-        memoryManager_->decreaseMemoryUsage((*data)->estimateFlatSize());
-
-    if (noMoreProducers_ && pendingProducers_ == 0 && queue.empty()) {
-      producerPromises = std::move(producerPromises_);
-    }
-
-    return BlockingReason::kNotBlocked;
-  });
+  auto memoryPromises =
+      memoryManager_->decreaseMemoryUsage((*data)->estimateFlatSize());
+  auto producerPromises = checkAllDataFetched();
   notify(memoryPromises);
   notify(producerPromises);
-  return blockingReason;
+  return BlockingReason::kNotBlocked;
 }
 
-bool LocalExchangeQueue::isFinishedLocked(
-    const std::queue<RowVectorPtr>& queue) const {
-  if (closed_) {
-    return true;
+std::vector<ContinuePromise> LocalExchangeQueue::checkAllDataFetched() {
+  std::vector<ContinuePromise> producerPromises;
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (!noMoreData_ || !queue_.empty()) {
+    return producerPromises;
   }
+  std::lock_guard<std::mutex> l(mutex_);
+  producerPromises = std::move(producerPromises_);
+  return producerPromises;
+}
 
-  if (noMoreProducers_ && pendingProducers_ == 0 && queue.empty()) {
-    return true;
+std::vector<ContinuePromise> LocalExchangeQueue::drain() {
+  uint64_t freedBytes = 0;
+  RowVectorPtr data;
+  while (queue_.try_dequeue(data)) {
+    freedBytes += data->estimateFlatSize();
   }
-
-  return false;
+  if (freedBytes == 0) {
+    return {};
+  }
+  return memoryManager_->decreaseMemoryUsage(freedBytes);
 }
 
 BlockingReason LocalExchangeQueue::isFinished(ContinueFuture* future) {
-  return queue_.withWLock([&](auto& queue) {
-    if (isFinishedLocked(queue)) {
-      return BlockingReason::kNotBlocked;
-    }
+  std::lock_guard<std::mutex> l(mutex_);
+  if (isFinished()) {
+    return BlockingReason::kNotBlocked;
+  }
 
-    producerPromises_.emplace_back("LocalExchangeQueue::isFinished");
-    *future = producerPromises_.back().getSemiFuture();
+  producerPromises_.emplace_back("LocalExchangeQueue::isFinished");
+  *future = producerPromises_.back().getSemiFuture();
 
-    return BlockingReason::kWaitForConsumer;
-  });
+  return BlockingReason::kWaitForConsumer;
 }
 
 bool LocalExchangeQueue::isFinished() {
-  return queue_.withWLock([&](auto& queue) { return isFinishedLocked(queue); });
+  if (closed_) {
+    return true;
+  }
+
+  if (noMoreData_ && queue_.empty()) {
+    return true;
+  }
+
+  return false;
 }
 
 void LocalExchangeQueue::close() {
   std::vector<ContinuePromise> producerPromises;
   std::vector<ContinuePromise> consumerPromises;
   std::vector<ContinuePromise> memoryPromises;
-  queue_.withWLock([&](auto& queue) {
-    uint64_t freedBytes = 0;
-    while (!queue.empty()) {
-      freedBytes += queue.front()->estimateFlatSize();
-      queue.pop();
-    }
-
-    if (freedBytes) {
-      memoryPromises = memoryManager_->decreaseMemoryUsage(freedBytes);
-    }
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    closed_ = true;
+    // Pairs with the fence in enqueue(). Data added concurrently is either
+    // drained here or by the producer.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    memoryPromises = drain();
 
     producerPromises = std::move(producerPromises_);
     consumerPromises = std::move(consumerPromises_);
-    closed_ = true;
-  });
+    hasConsumerPromises_ = false;
+  }
   notify(producerPromises);
   notify(consumerPromises);
   notify(memoryPromises);
@@ -15,13 +15,16 @@
  */
 #pragma once
 
+#include <folly/concurrency/UnboundedQueue.h>
+
 #include "velox/exec/Operator.h"
 #include "velox/exec/VectorHasher.h"
 
 namespace facebook::velox::exec {
 
 /// Keeps track of the total size in bytes of the data buffered in all
-/// LocalExchangeQueues.
+/// LocalExchangeQueues. The size is updated with atomics and a mutex is only
+/// taken when a producer needs to wait or be woken up.
 class LocalExchangeMemoryManager {
  public:
   explicit LocalExchangeMemoryManager(int64_t maxBufferSize)
@@ -38,8 +41,11 @@ class LocalExchangeMemoryManager {
 
  private:
   const int64_t maxBufferSize_;
+  std::atomic<int64_t> bufferedBytes_{0};
+  // True if 'promises_' may be non-empty. Lets decreaseMemoryUsage() skip
+  // 'mutex_' when no producer waits.
+  std::atomic<bool> hasPromises_{false};
   std::mutex mutex_;
-  int64_t bufferedBytes_{0};
   std::vector<ContinuePromise> promises_;
 };
 
@@ -49,6 +55,10 @@ class LocalExchangeMemoryManager {
 /// must be called after all producers have been registered. A producer calls
 /// 'enqueue' multiple time to put the data and calls 'noMoreData' when done.
 /// Consumers call 'next' repeatedly to fetch the data.
+///
+/// The data is kept in a lock-free queue. 'enqueue' and 'next' take a mutex
+/// only when a consumer has to wait for data, when a waiting consumer has to
+/// be woken up or when the last data is fetched after all producers are done.
 class LocalExchangeQueue {
  public:
   LocalExchangeQueue(
@@ -97,11 +107,28 @@ class LocalExchangeQueue {
   void close();
 
  private:
-  bool isFinishedLocked(const std::queue<RowVectorPtr>& queue) const;
+  // Removes all data from 'queue_'. Returns the promises of producers to
+  // fulfill for the freed memory.
+  std::vector<ContinuePromise> drain();
+
+  // Called after fetching data. If no more data will be produced and 'queue_'
+  // is empty, returns the promises of producers waiting for all data to be
+  // fetched.
+  std::vector<ContinuePromise> checkAllDataFetched();
 
   std::shared_ptr<LocalExchangeMemoryManager> memoryManager_;
   const int partition_;
-  folly::Synchronized<std::queue<RowVectorPtr>> queue_;
+  // The number of buffered vectors is limited by 'memoryManager_', so the
+  // queue does not need a bound of its own.
+  folly::UMPMCQueue<RowVectorPtr, false> queue_;
+  // Serializes registering and fulfilling promises and the producer count.
+  std::mutex mutex_;
+  // True if 'consumerPromises_' may be non-empty. Lets enqueue() skip 'mutex_'
+  // when no consumer waits.
+  std::atomic<bool> hasConsumerPromises_{false};
+  // True once noMoreProducers_ is true and pendingProducers_ is zero.
+  std::atomic<bool> noMoreData_{false};
+  std::atomic<bool> closed_{false};
   // Satisfied when data becomes available or all producers report that they
   // finished producing, e.g. queue_ is not empty or noMoreProducers_ is true
   // and pendingProducers_ is zero.
@@ -112,7 +139,6 @@ class LocalExchangeQueue {
   std::vector<ContinuePromise> producerPromises_;
   int pendingProducers_{0};
   bool noMoreProducers_{false};
-  bool closed_{false};
 };
 
 /// Fetches data for a single partition produced by local exchange from
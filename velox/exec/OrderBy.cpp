@@ -244,7 +244,8 @@ void OrderBy::spill(int64_t targetRows, int64_t targetBytes) {
         spillConfig.maxFileSize,
         spillConfig.minSpillRunSize,
         Spiller::spillPool(),
-        spillConfig.executor);
+        spillConfig.executor,
+        spillConfig.compressionKind);
     VELOX_CHECK_EQ(spiller_->state().maxPartitions(), 1);
   }
   spiller_->spill(targetRows, targetBytes);
@@ -15,6 +15,11 @@
  */
 
 #include "velox/exec/Spill.h"
+
+#include <lz4.h>
+#include <snappy.h>
+#include <zstd.h>
+
 #include "velox/common/file/FileSystems.h"
 #include "velox/exec/OperatorUtils.h"
 #include "velox/serializers/PrestoSerializer.h"
@@ -31,6 +36,85 @@ static const serializer::presto::PrestoVectorSerde::PrestoOptions
 
 std::atomic<int32_t> SpillFile::ordinalCounter_;
 
+folly::io::CodecType spillCompressionKindFromString(const std::string& name) {
+  static const std::unordered_map<std::string, folly::io::CodecType>
+      kCompressionKinds = {
+          {"none", folly::io::CodecType::NO_COMPRESSION},
+          {"lz4", folly::io::CodecType::LZ4},
+          {"zstd", folly::io::CodecType::ZSTD},
+          {"snappy", folly::io::CodecType::SNAPPY},
+      };
+  auto it = kCompressionKinds.find(name);
+  VELOX_USER_CHECK(
+      it != kCompressionKinds.end(),
+      "Unsupported spill compression kind: {}",
+      name);
+  VELOX_USER_CHECK(
+      folly::io::hasCodec(it->second),
+      "Spill compression kind {} is not available in this build",
+      name);
+  return it->second;
+}
+
+namespace {
+// Returns the data of 'buffer' after making it hold at least 'size' bytes.
+// 'buffer' is reallocated from 'pool' if it is too small.
+char* ensureBufferSize(
+    BufferPtr& buffer,
+    int32_t size,
+    memory::MemoryPool& pool) {
+  if (buffer == nullptr || buffer->capacity() < size) {
+    buffer.reset();
+    buffer = AlignedBuffer::allocate<char>(size, &pool);
+  }
+  return buffer->asMutable<char>();
+}
+
+// Decompresses 'input' into 'output' of exactly 'outputSize' bytes. The
+// batches are compressed by folly::io::Codec in SpillFileList::flush(), which
+// produces the plain block formats of the underlying libraries. These are
+// decompressed with the libraries directly so that the result goes to a
+// buffer of the spill memory pool.
+void decompress(
+    folly::io::CodecType kind,
+    const char* input,
+    int32_t inputSize,
+    char* output,
+    int32_t outputSize) {
+  switch (kind) {
+    case folly::io::CodecType::LZ4: {
+      const auto size =
+          LZ4_decompress_safe(input, output, inputSize, outputSize);
+      VELOX_CHECK_EQ(size, outputSize, "LZ4 spill decompression failed");
+      break;
+    }
+    case folly::io::CodecType::ZSTD: {
+      const auto size = ZSTD_decompress(output, outputSize, input, inputSize);
+      VELOX_CHECK(
+          !ZSTD_isError(size),
+          "ZSTD spill decompression failed: {}",
+          ZSTD_getErrorName(size));
+      VELOX_CHECK_EQ(size, static_cast<size_t>(outputSize));
+      break;
+    }
+    case folly::io::CodecType::SNAPPY: {
+      size_t size;
+      VELOX_CHECK(
+          snappy::GetUncompressedLength(input, inputSize, &size) &&
+              size == static_cast<size_t>(outputSize),
+          "Snappy spill decompression failed");
+      VELOX_CHECK(
+          snappy::RawUncompress(input, inputSize, output),
+          "Snappy spill decompression failed");
+      break;
+    }
+    default:
+      VELOX_UNREACHABLE(
+          "Unsupported spill compression kind: {}", static_cast<int>(kind));
+  }
+}
+} // namespace
+
 void SpillInput::next(bool /*throwIfPastEnd*/) {
   int32_t readBytes = std::min(input_->size() - offset_, buffer_->capacity());
   VELOX_CHECK_LT(0, readBytes, "Reading past end of spill file");
@@ -67,10 +151,36 @@ void SpillFile::startRead() {
 
 bool SpillFile::nextBatch(RowVectorPtr& rowVector) {
   if (input_->atEnd()) {
+    compressedBuffer_.reset();
+    uncompressedBuffer_.reset();
     return false;
   }
+  if (compressionKind_ == folly::io::CodecType::NO_COMPRESSION) {
+    VectorStreamGroup::read(
+        input_.get(), &pool_, type_, &rowVector, &kDefaultSerdeOptions);
+    return true;
+  }
+
+  // Each compressed batch is prefixed with its uncompressed and compressed
+  // byte sizes. See SpillFileList::flush().
+  const auto uncompressedSize = input_->read<int32_t>();
+  const auto compressedSize = input_->read<int32_t>();
+  auto* compressed = ensureBufferSize(compressedBuffer_, compressedSize, pool_);
+  input_->readBytes(compressed, compressedSize);
+  auto* uncompressed =
+      ensureBufferSize(uncompressedBuffer_, uncompressedSize, pool_);
+  decompress(
+      compressionKind_,
+      compressed,
+      compressedSize,
+      uncompressed,
+      uncompressedSize);
+
+  ByteStream batchInput;
+  batchInput.setRange(
+      {reinterpret_cast<uint8_t*>(uncompressed), uncompressedSize, 0});
   VectorStreamGroup::read(
-      input_.get(), &pool_, type_, &rowVector, &kDefaultSerdeOptions);
+      &batchInput, &pool_, type_, &rowVector, &kDefaultSerdeOptions);
   return true;
 }
 
@@ -85,7 +195,8 @@ WriteFile& SpillFileList::currentOutput() {
         numSortingKeys_,
         sortCompareFlags_,
         fmt::format("{}-{}", path_, files_.size()),
-        pool_));
+        pool_,
+        compressionKind_));
   }
   return files_.back()->output();
 }
@@ -97,7 +208,19 @@ void SpillFileList::flush() {
     batch_->flush(&out);
     batch_.reset();
     auto iobuf = out.getIOBuf();
+    const auto uncompressedSize = iobuf->computeChainDataLength();
+    uncompressedBytes_ += uncompressedSize;
     auto& file = currentOutput();
+    if (codec_ != nullptr) {
+      // Prefixes the compressed batch with its uncompressed and compressed
+      // sizes so that the reader can decompress it as a whole.
+      iobuf = codec_->compress(iobuf.get());
+      const int32_t header[2] = {
+          static_cast<int32_t>(uncompressedSize),
+          static_cast<int32_t>(iobuf->computeChainDataLength())};
+      file.append(std::string_view(
+          reinterpret_cast<const char*>(header), sizeof(header)));
+    }
     for (auto& range : *iobuf) {
       file.append(std::string_view(
           reinterpret_cast<const char*>(range.data()), range.size()));
@@ -144,6 +267,11 @@ void SpillFileList::recordRuntimeStats() {
         "spillFileSize",
         RuntimeCounter(file->size(), RuntimeCounter::Unit::kBytes));
   }
+  if (codec_ != nullptr) {
+    addThreadLocalRuntimeStat(
+        "spillUncompressedBytes",
+        RuntimeCounter(uncompressedBytes_, RuntimeCounter::Unit::kBytes));
+  }
 }
 
 std::vector<std::string> SpillFileList::testingSpilledFilePaths() const {
@@ -173,7 +301,8 @@ void SpillState::appendToPartition(
         sortCompareFlags_,
         fmt::format("{}-spill-{}", path_, partition),
         targetFileSize_,
-        pool_);
+        pool_,
+        compressionKind_);
   }
 
   IndexRange range{0, rows->size()};
@@ -221,6 +350,16 @@ uint64_t SpillState::spilledBytes() const {
   return bytes;
 }
 
+uint64_t SpillState::spilledUncompressedBytes() const {
+  uint64_t bytes = 0;
+  for (auto& list : files_) {
+    if (list != nullptr) {
+      bytes += list->spilledUncompressedBytes();
+    }
+  }
+  return bytes;
+}
+
 uint32_t SpillState::spilledPartitions() const {
   return spilledPartitionSet_.size();
 }
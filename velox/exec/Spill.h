@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <folly/compression/Compression.h>
 #include <folly/container/F14Set.h>
 
 #include "velox/common/file/File.h"
@@ -27,6 +28,10 @@
 
 namespace facebook::velox::exec {
 
+/// Returns the codec type used to compress spill files from its config name.
+/// The supported names are 'none', 'lz4', 'zstd' and 'snappy'.
+folly::io::CodecType spillCompressionKindFromString(const std::string& name);
+
 // Input stream backed by spill file.
 class SpillInput : public ByteStream {
  public:
@@ -68,10 +73,13 @@ class SpillFile {
       int32_t numSortingKeys,
       const std::vector<CompareFlags>& sortCompareFlags,
       const std::string& path,
-      memory::MemoryPool& pool)
+      memory::MemoryPool& pool,
+      folly::io::CodecType compressionKind =
+          folly::io::CodecType::NO_COMPRESSION)
       : type_(std::move(type)),
         numSortingKeys_(numSortingKeys),
         sortCompareFlags_(sortCompareFlags),
+        compressionKind_(compressionKind),
         pool_(pool),
         ordinal_(ordinalCounter_++),
         path_(fmt::format("{}-{}", path, ordinal_)) {
@@ -139,6 +147,7 @@ class SpillFile {
   const RowTypePtr type_;
   const int32_t numSortingKeys_;
   const std::vector<CompareFlags> sortCompareFlags_;
+  const folly::io::CodecType compressionKind_;
   memory::MemoryPool& pool_;
 
   // Ordinal number used for making a label for debugging.
@@ -149,6 +158,11 @@ class SpillFile {
   uint64_t fileSize_ = 0;
   std::unique_ptr<WriteFile> output_;
   std::unique_ptr<SpillInput> input_;
+  // Compressed and decompressed bytes of the batch being read if
+  // 'compressionKind_' is set. Allocated from 'pool_' and reused across
+  // batches.
+  BufferPtr compressedBuffer_;
+  BufferPtr uncompressedBuffer_;
 };
 
 using SpillFiles = std::vector<std::unique_ptr<SpillFile>>;
@@ -163,6 +177,8 @@ class SpillFileList {
   /// data is sorted. 'path' is a file path prefix. ' 'targetFileSize' is the
   /// target byte size of a single file in the file set. 'pool' is used for
   /// buffering and constructing the result data read from 'this'.
+  /// 'compressionKind' specifies the codec to compress each serialized batch
+  /// with before writing it to the file.
   ///
   /// When writing sorted spill runs, the caller is responsible for buffering
   /// and sorting the data. write is called multiple times, followed by flush().
@@ -172,13 +188,20 @@ class SpillFileList {
       const std::vector<CompareFlags>& sortCompareFlags,
       const std::string& path,
       uint64_t targetFileSize,
-      memory::MemoryPool& pool)
+      memory::MemoryPool& pool,
+      folly::io::CodecType compressionKind =
+          folly::io::CodecType::NO_COMPRESSION)
       : type_(type),
         numSortingKeys_(numSortingKeys),
         sortCompareFlags_(sortCompareFlags),
         path_(path),
         targetFileSize_(targetFileSize),
-        pool_(pool) {
+        compressionKind_(compressionKind),
+        pool_(pool),
+        codec_(
+            compressionKind_ == folly::io::CodecType::NO_COMPRESSION
+                ? nullptr
+                : folly::io::getCodec(compressionKind_)) {
     // NOTE: if the associated spilling operator has specified the sort
     // comparison flags, then it must match the number of sorting keys.
     VELOX_CHECK(
@@ -207,6 +230,12 @@ class SpillFileList {
 
   uint64_t spilledBytes() const;
 
+  /// Returns the serialized byte size of the spilled data before compression.
+  /// This is the same as spilledBytes() if compression is not enabled.
+  uint64_t spilledUncompressedBytes() const {
+    return uncompressedBytes_;
+  }
+
   uint64_t spilledFiles() const {
     return files_.size();
   }
@@ -229,9 +258,15 @@ class SpillFileList {
   const std::vector<CompareFlags> sortCompareFlags_;
   const std::string path_;
   const uint64_t targetFileSize_;
+  const folly::io::CodecType compressionKind_;
   memory::MemoryPool& pool_;
+  // Compresses the serialized batches. Null if compression is not enabled.
+  const std::unique_ptr<folly::io::Codec> codec_;
   std::unique_ptr<VectorStreamGroup> batch_;
   SpillFiles files_;
+  // The serialized byte size of all the batches written to 'files_' before
+  // compression.
+  uint64_t uncompressedBytes_{0};
 };
 
 // A source of sorted spilled RowVectors coming either from a file or memory.
@@ -332,7 +367,7 @@ class SpillMergeStream : public MergeStream {
     ensureRows();
     decoded_.resize(index + 1);
     for (auto i = oldSize; i <= index; ++i) {
-      decoded_[index].decode(*rowVector_->childAt(index), rows_);
+      decoded_[i].decode(*rowVector_->childAt(i), rows_);
     }
   }
 
@@ -549,19 +584,22 @@ class SpillState {
   /// 'numSortingKeys' is the number of leading columns on which the data is
   /// sorted, 0 if only hash partitioning is used. 'targetFileSize' is the
   /// target size of a single file.  'pool' owns the memory for state and
-  /// results.
+  /// results. 'compressionKind' is the codec used to compress the spill files.
   SpillState(
       const std::string& path,
       int32_t maxPartitions,
       int32_t numSortingKeys,
       const std::vector<CompareFlags>& sortCompareFlags,
       uint64_t targetFileSize,
-      memory::MemoryPool& pool)
+      memory::MemoryPool& pool,
+      folly::io::CodecType compressionKind =
+          folly::io::CodecType::NO_COMPRESSION)
       : path_(path),
         maxPartitions_(maxPartitions),
         numSortingKeys_(numSortingKeys),
         sortCompareFlags_(sortCompareFlags),
         targetFileSize_(targetFileSize),
+        compressionKind_(compressionKind),
         pool_(pool),
         files_(maxPartitions_) {}
 
@@ -583,6 +621,10 @@ class SpillState {
     return targetFileSize_;
   }
 
+  folly::io::CodecType compressionKind() const {
+    return compressionKind_;
+  }
+
   memory::MemoryPool& pool() const {
     return pool_;
   }
@@ -628,6 +670,9 @@ class SpillState {
 
   uint64_t spilledBytes() const;
 
+  /// Returns the spilled bytes before compression.
+  uint64_t spilledUncompressedBytes() const;
+
   /// Return the number of spilled partitions.
   uint32_t spilledPartitions() const;
 
@@ -646,6 +691,7 @@ class SpillState {
   const int32_t numSortingKeys_;
   const std::vector<CompareFlags> sortCompareFlags_;
   const uint64_t targetFileSize_;
+  const folly::io::CodecType compressionKind_;
 
   memory::MemoryPool& pool_;
 
@@ -38,7 +38,8 @@ Spiller::Spiller(
     uint64_t targetFileSize,
     uint64_t minSpillRunSize,
     memory::MemoryPool& pool,
-    folly::Executor* executor)
+    folly::Executor* executor,
+    folly::io::CodecType compressionKind)
     : Spiller(
           type,
           container,
@@ -51,7 +52,8 @@ Spiller::Spiller(
           targetFileSize,
           minSpillRunSize,
           pool,
-          executor) {
+          executor,
+          compressionKind) {
   VELOX_CHECK_EQ(type_, Type::kOrderBy);
 }
 
@@ -63,7 +65,8 @@ Spiller::Spiller(
     uint64_t targetFileSize,
     uint64_t minSpillRunSize,
     memory::MemoryPool& pool,
-    folly::Executor* FOLLY_NULLABLE executor)
+    folly::Executor* FOLLY_NULLABLE executor,
+    folly::io::CodecType compressionKind)
     : Spiller(
           type,
           nullptr,
@@ -76,7 +79,8 @@ Spiller::Spiller(
           targetFileSize,
           minSpillRunSize,
           pool,
-          executor) {
+          executor,
+          compressionKind) {
   VELOX_CHECK_EQ(type_, Type::kHashJoinProbe);
 }
 
@@ -92,7 +96,8 @@ Spiller::Spiller(
     uint64_t targetFileSize,
     uint64_t minSpillRunSize,
     memory::MemoryPool& pool,
-    folly::Executor* executor)
+    folly::Executor* executor,
+    folly::io::CodecType compressionKind)
     : type_(type),
       container_(container),
       eraser_(eraser),
@@ -105,7 +110,8 @@ Spiller::Spiller(
           numSortingKeys,
           sortCompareFlags,
           targetFileSize,
-          pool),
+          pool,
+          compressionKind),
       pool_(pool),
       executor_(executor) {
   TestValue::adjust(
@@ -47,7 +47,9 @@ class Spiller {
         int32_t _spillableReservationGrowthPct,
         const HashBitRange& _hashBitRange,
         int32_t _maxSpillLevel,
-        int32_t _testSpillPct)
+        int32_t _testSpillPct,
+        folly::io::CodecType _compressionKind =
+            folly::io::CodecType::NO_COMPRESSION)
         : filePath(_filePath),
           maxFileSize(
               _maxFileSize == 0 ? std::numeric_limits<int64_t>::max()
@@ -57,7 +59,8 @@ class Spiller {
           spillableReservationGrowthPct(_spillableReservationGrowthPct),
           hashBitRange(_hashBitRange),
           maxSpillLevel(_maxSpillLevel),
-          testSpillPct(_testSpillPct) {}
+          testSpillPct(_testSpillPct),
+          compressionKind(_compressionKind) {}
 
     /// Returns the spilling level with given 'startBitOffset'.
     ///
@@ -104,6 +107,9 @@ class Spiller {
     // Percentage of input batches to be spilled for testing. 0 means no
     // spilling for test.
     int32_t testSpillPct;
+
+    // The codec used to compress the spilled data.
+    folly::io::CodecType compressionKind;
   };
 
   using SpillRows = std::vector<char*, memory::StlAllocator<char*>>;
@@ -121,7 +127,9 @@ class Spiller {
       uint64_t targetFileSize,
       uint64_t minSpillRunSize,
       memory::MemoryPool& pool,
-      folly::Executor* FOLLY_NULLABLE executor);
+      folly::Executor* FOLLY_NULLABLE executor,
+      folly::io::CodecType compressionKind =
+          folly::io::CodecType::NO_COMPRESSION);
 
   Spiller(
       Type type,
@@ -131,7 +139,9 @@ class Spiller {
       uint64_t targetFileSize,
       uint64_t minSpillRunSize,
       memory::MemoryPool& pool,
-      folly::Executor* FOLLY_NULLABLE executor);
+      folly::Executor* FOLLY_NULLABLE executor,
+      folly::io::CodecType compressionKind =
+          folly::io::CodecType::NO_COMPRESSION);
 
   Spiller(
       Type type,
@@ -145,7 +155,9 @@ class Spiller {
       uint64_t targetFileSize,
       uint64_t minSpillRunSize,
       memory::MemoryPool& pool,
-      folly::Executor* FOLLY_NULLABLE executor);
+      folly::Executor* FOLLY_NULLABLE executor,
+      folly::io::CodecType compressionKind =
+          folly::io::CodecType::NO_COMPRESSION);
 
   /// Spills rows from 'this' until there are under 'targetRows' rows
   /// and 'targetBytes' of allocated variable length space in use. spill()
@@ -263,16 +275,21 @@ class Spiller {
     /// the total number of spilled partitions X number of operators.
     uint32_t spilledPartitions{0};
     uint64_t spilledFiles{0};
+    /// The spilled bytes before compression. It is the same as 'spilledBytes'
+    /// if spill compression is not enabled.
+    uint64_t spilledUncompressedBytes{0};
 
     Stats(
         uint64_t _spilledBytes,
         uint64_t _spilledRows,
         uint32_t _spilledPartitions,
-        uint64_t _spilledFiles)
+        uint64_t _spilledFiles,
+        uint64_t _spilledUncompressedBytes = 0)
         : spilledBytes(_spilledBytes),
           spilledRows(_spilledRows),
           spilledPartitions(_spilledPartitions),
-          spilledFiles(_spilledFiles) {}
+          spilledFiles(_spilledFiles),
+          spilledUncompressedBytes(_spilledUncompressedBytes) {}
 
     Stats() = default;
 
@@ -281,6 +298,7 @@ class Spiller {
       spilledRows += other.spilledRows;
       spilledPartitions += other.spilledPartitions;
       spilledFiles += other.spilledFiles;
+      spilledUncompressedBytes += other.spilledUncompressedBytes;
       return *this;
     }
   };
@@ -290,7 +308,8 @@ class Spiller {
         state_.spilledBytes(),
         spilledRows_,
         state_.spilledPartitions(),
-        spilledFiles()};
+        spilledFiles(),
+        state_.spilledUncompressedBytes()};
   }
 
   /// Return the number of spilled files we have.
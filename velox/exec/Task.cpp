@@ -322,6 +322,11 @@ void Task::initTaskPool() {
   VELOX_CHECK_NULL(pool_);
   pool_ = queryCtx_->pool()->addAggregateChild(
       fmt::format("task.{}", taskId_.c_str()), createTaskReclaimer());
+  const auto sampleBytes = queryCtx_->queryConfig().memoryProfileSampleBytes();
+  if (sampleBytes > 0) {
+    pool_->setAllocationProfiler(
+        std::make_shared<memory::AllocationProfiler>(sampleBytes));
+  }
 }
 
 velox::memory::MemoryPool* Task::getOrAddNodePool(
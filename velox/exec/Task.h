@@ -103,6 +103,12 @@ class Task : public std::enable_shared_from_this<Task> {
     return pool_.get();
   }
 
+  /// Returns the profiler sampling the allocations of this task if
+  /// 'memory_profile_sample_bytes' is set in the query config, otherwise null.
+  memory::AllocationProfiler* allocationProfiler() const {
+    return pool_->allocationProfiler();
+  }
+
   /// Returns ConsumerSupplier passed in the constructor.
   ConsumerSupplier consumerSupplier() const {
     return consumerSupplier_;
@@ -51,11 +51,14 @@ Window::Window(
           windowNode->outputType(),
           operatorId,
           windowNode->id(),
-          "Window"),
+          "Window",
+          windowNode->canSpill(driverCtx->queryConfig())
+              ? driverCtx->makeSpillConfig(operatorId)
+              : std::nullopt),
       numInputColumns_(windowNode->sources()[0]->outputType()->size()),
-      data_(std::make_unique<RowContainer>(
-          windowNode->sources()[0]->outputType()->children(),
-          pool())),
+      spillMemoryThreshold_(operatorCtx_->driverCtx()
+                                ->queryConfig()
+                                .windowSpillMemoryThreshold()),
       decodedInputVectors_(numInputColumns_),
       stringAllocator_(pool()) {
   auto inputType = windowNode->sources()[0]->outputType();
@@ -71,18 +74,67 @@ Window::Window(
   allKeyInfo_.insert(
       allKeyInfo_.cend(), sortKeyInfo_.begin(), sortKeyInfo_.end());
 
+  createRowContainer(inputType);
+  createWindowPartition();
+  createWindowFunctions(windowNode, inputType);
+}
+
+void Window::createRowContainer(const RowTypePtr& inputType) {
+  containerChannels_.resize(numInputColumns_, kConstantChannel);
+  std::vector<TypePtr> keyTypes;
+  std::vector<TypePtr> dependentTypes;
+  std::vector<std::string> names;
+  std::vector<TypePtr> types;
+  auto addColumn = [&](column_index_t channel) {
+    containerChannels_[channel] = types.size();
+    names.push_back(inputType->nameOf(channel));
+    types.push_back(inputType->childAt(channel));
+  };
+
+  // A key column might be both a partition and a sort key. Only its first
+  // occurrence matters for the ordering of the rows.
+  for (const auto& [channel, sortOrder] : allKeyInfo_) {
+    if (containerChannels_[channel] != kConstantChannel) {
+      continue;
+    }
+    addColumn(channel);
+    keyTypes.push_back(types.back());
+    spillCompareFlags_.push_back(
+        {sortOrder.isNullsFirst(), sortOrder.isAscending(), false});
+  }
+  for (column_index_t channel = 0; channel < numInputColumns_; ++channel) {
+    if (containerChannels_[channel] != kConstantChannel) {
+      continue;
+    }
+    addColumn(channel);
+    dependentTypes.push_back(types.back());
+  }
+
+  data_ = std::make_unique<RowContainer>(keyTypes, dependentTypes, pool());
+  spillType_ = ROW(std::move(names), std::move(types));
+
+  for (auto* keyInfo : {&partitionKeyInfo_, &sortKeyInfo_, &allKeyInfo_}) {
+    for (auto& key : *keyInfo) {
+      key.first = containerChannels_[key.first];
+    }
+  }
+}
+
+void Window::createWindowPartition() {
+  // The WindowPartition is structured over all the input columns data in the
+  // input column order. Individual functions access its input argument column
+  // values from it. The RowColumns are copied by the WindowPartition, so its
+  // fine to use a local variable here.
   std::vector<exec::RowColumn> inputColumns;
-  for (int i = 0; i < inputType->children().size(); i++) {
-    inputColumns.push_back(data_->columnAt(i));
+  std::vector<TypePtr> inputTypes;
+  inputColumns.reserve(numInputColumns_);
+  inputTypes.reserve(numInputColumns_);
+  for (auto i = 0; i < numInputColumns_; ++i) {
+    inputColumns.push_back(data_->columnAt(containerChannels_[i]));
+    inputTypes.push_back(spillType_->childAt(containerChannels_[i]));
   }
-  // The WindowPartition is structured over all the input columns data.
-  // Individual functions access its input argument column values from it.
-  // The RowColumns are copied by the WindowPartition, so its fine to use
-  // a local variable here.
   windowPartition_ =
-      std::make_unique<WindowPartition>(inputColumns, inputType->children());
-
-  createWindowFunctions(windowNode, inputType);
+      std::make_unique<WindowPartition>(inputColumns, inputTypes);
 }
 
 Window::WindowFrame Window::createWindowFrame(
@@ -152,6 +204,12 @@ void Window::createWindowFunctions(
 }
 
 void Window::addInput(RowVectorPtr input) {
+  ensureInputFits(input);
+
+  // Prevents the memory arbitrator to reclaim memory from this operator during
+  // the execution below.
+  NonReclaimableSection guard(this);
+
   for (auto col = 0; col < input->childrenSize(); ++col) {
     decodedInputVectors_[col].decode(*input->childAt(col));
   }
@@ -161,12 +219,150 @@ void Window::addInput(RowVectorPtr input) {
     char* newRow = data_->newRow();
 
     for (auto col = 0; col < input->childrenSize(); ++col) {
-      data_->store(decodedInputVectors_[col], row, newRow, col);
+      data_->store(
+          decodedInputVectors_[col], row, newRow, containerChannels_[col]);
     }
   }
   numRows_ += input->size();
 }
 
+void Window::ensureInputFits(const RowVectorPtr& input) {
+  // Check if spilling is enabled or not.
+  if (!spillConfig_.has_value()) {
+    return;
+  }
+
+  const int64_t numRows = data_->numRows();
+  if (numRows == 0) {
+    // 'data_' is empty. Nothing to spill.
+    return;
+  }
+  auto [freeRows, outOfLineFreeBytes] = data_->freeSpace();
+  const auto outOfLineBytes =
+      data_->stringAllocator().retainedSize() - outOfLineFreeBytes;
+  const int64_t outOfLineBytesPerRow = outOfLineBytes / numRows;
+  const int64_t flatInputBytes = input->estimateFlatSize();
+
+  const auto& spillConfig = spillConfig_.value();
+  // Test-only spill path.
+  if (spillConfig.testSpillPct &&
+      (folly::hasher<uint64_t>()(++spillTestCounter_)) % 100 <=
+          spillConfig.testSpillPct) {
+    const int64_t rowsToSpill = std::max<int64_t>(1, numRows / 10);
+    spill(
+        numRows - rowsToSpill,
+        std::max<int64_t>(
+            0, outOfLineBytes - (rowsToSpill * outOfLineBytesPerRow)));
+    return;
+  }
+
+  const auto currentUsage = pool()->currentBytes();
+  if (spillMemoryThreshold_ != 0 && currentUsage > spillMemoryThreshold_) {
+    const int64_t bytesToSpill =
+        currentUsage * spillConfig.spillableReservationGrowthPct / 100;
+    auto rowsToSpill = std::max<int64_t>(
+        1, bytesToSpill / (data_->fixedRowSize() + outOfLineBytesPerRow));
+    spill(
+        std::max<int64_t>(0, numRows - rowsToSpill),
+        std::max<int64_t>(
+            0, outOfLineBytes - (rowsToSpill * outOfLineBytesPerRow)));
+    return;
+  }
+
+  if (freeRows > input->size() &&
+      (outOfLineBytes == 0 || outOfLineFreeBytes >= flatInputBytes)) {
+    // Enough free rows for input rows and enough variable length free
+    // space for the flat size of the whole vector. If outOfLineBytes
+    // is 0 there is no need for variable length space.
+    return;
+  }
+
+  // If there is variable length data we take the flat size of the input as a
+  // cap on the new variable length data needed.
+  const int64_t incrementBytes =
+      data_->sizeIncrement(input->size(), outOfLineBytes ? flatInputBytes : 0);
+
+  // There must be at least 2x the increment in reservation.
+  if (pool()->availableReservation() > 2 * incrementBytes) {
+    return;
+  }
+
+  // Check if can increase reservation. The increment is the larger of twice the
+  // maximum increment from this input and 'spillableReservationGrowthPct_' of
+  // the current reservation.
+  const auto targetIncrementBytes = std::max<int64_t>(
+      incrementBytes * 2,
+      currentUsage * spillConfig.spillableReservationGrowthPct / 100);
+  if (pool()->maybeReserve(targetIncrementBytes)) {
+    return;
+  }
+
+  const int64_t rowsToSpill = std::max<int64_t>(
+      1, targetIncrementBytes / (data_->fixedRowSize() + outOfLineBytesPerRow));
+  spill(
+      std::max<int64_t>(0, numRows - rowsToSpill),
+      std::max<int64_t>(
+          0, outOfLineBytes - (rowsToSpill * outOfLineBytesPerRow)));
+}
+
+void Window::reclaim(uint64_t targetBytes) {
+  VELOX_CHECK(canReclaim());
+
+  // NOTE: a window operator is reclaimable if it hasn't started output
+  // processing and is not under non-reclaimable execution section.
+  if (noMoreInput_ || nonReclaimableSection_) {
+    LOG(WARNING) << "Can't reclaim from window operator, noMoreInput_["
+                 << noMoreInput_ << "], nonReclaimableSection_["
+                 << nonReclaimableSection_ << "], " << toString();
+    return;
+  }
+
+  spill(0, targetBytes);
+  VELOX_CHECK_EQ(data_->numRows(), 0);
+  data_->clear();
+  // Release the minimum reserved memory.
+  pool()->release();
+}
+
+void Window::spill(int64_t targetRows, int64_t targetBytes) {
+  VELOX_CHECK_GE(targetRows, 0);
+  VELOX_CHECK_GE(targetBytes, 0);
+
+  if (spiller_ == nullptr) {
+    const auto& spillConfig = spillConfig_.value();
+    // The spilled rows are sorted on (partition keys + sort keys), so a window
+    // spills like an order by with a single spill partition.
+    spiller_ = std::make_unique<Spiller>(
+        Spiller::Type::kOrderBy,
+        data_.get(),
+        [&](folly::Range<char**> rows) { data_->eraseRows(rows); },
+        spillType_,
+        data_->keyTypes().size(),
+        spillCompareFlags_,
+        spillConfig.filePath,
+        spillConfig.maxFileSize,
+        spillConfig.minSpillRunSize,
+        Spiller::spillPool(),
+        spillConfig.executor,
+        spillConfig.compressionKind);
+    VELOX_CHECK_EQ(spiller_->state().maxPartitions(), 1);
+  }
+  spiller_->spill(targetRows, targetBytes);
+}
+
+void Window::recordSpillStats() {
+  VELOX_CHECK_NOT_NULL(spiller_);
+  VELOX_CHECK(noMoreInput_);
+
+  const auto spillStats = spiller_->stats();
+  auto lockedStats = stats_.wlock();
+  lockedStats->spilledBytes = spillStats.spilledBytes;
+  lockedStats->spilledRows = spillStats.spilledRows;
+  lockedStats->spilledPartitions = spillStats.spilledPartitions;
+  lockedStats->spilledFiles = spillStats.spilledFiles;
+  VELOX_DCHECK_LE(lockedStats->spilledPartitions, 1);
+}
+
 inline bool Window::compareRowsWithKeys(
     const char* lhs,
     const char* rhs,
@@ -267,6 +463,30 @@ void Window::noMoreInput() {
     return;
   }
 
+  if (spiller_ != nullptr) {
+    // There is only one spill partition, so all the rows left in 'data_' are
+    // merged with the spilled runs.
+    Spiller::SpillRows nonSpilledRows = spiller_->finishSpill();
+    VELOX_CHECK(nonSpilledRows.empty());
+    recordSpillStats();
+    createPeerAndFrameBuffers();
+
+    VELOX_CHECK_NULL(spillMerge_);
+    spillMerge_ = spiller_->startMerge(0);
+    // The merge reads the unspilled rows from the current row container, so
+    // keep it alive and use a new one to hold a window partition at a time.
+    unspilledData_ = std::move(data_);
+    const auto numKeys = unspilledData_->keyTypes().size();
+    const auto& columnTypes = unspilledData_->columnTypes();
+    data_ = std::make_unique<RowContainer>(
+        unspilledData_->keyTypes(),
+        std::vector<TypePtr>(columnTypes.begin() + numKeys, columnTypes.end()),
+        pool());
+    createWindowPartition();
+    loadNextSpilledPartition();
+    return;
+  }
+
   // At this point we have seen all the input rows. We can start
   // outputting rows now.
   // However, some preparation is needed. The rows should be
@@ -276,6 +496,70 @@ void Window::noMoreInput() {
   createPeerAndFrameBuffers();
 }
 
+bool Window::isSamePartition(
+    const char* row,
+    SpillMergeStream& stream,
+    vector_size_t index) {
+  for (const auto& key : partitionKeyInfo_) {
+    if (data_->compare(
+            row,
+            data_->columnAt(key.first),
+            stream.decoded(key.first),
+            index,
+            {key.second.isNullsFirst(), key.second.isAscending(), true})) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void Window::loadNextSpilledPartition() {
+  VELOX_CHECK_NOT_NULL(spillMerge_);
+  data_->clear();
+  sortedRows_.clear();
+  partitionStartRows_.clear();
+  numRows_ = 0;
+  numProcessedRows_ = 0;
+  currentPartition_ = 0;
+  peerStartRow_ = 0;
+  peerEndRow_ = 0;
+
+  char* lastRow = nullptr;
+  for (;;) {
+    if (nextSpillStream_ == nullptr) {
+      nextSpillStream_ = spillMerge_->next();
+      if (nextSpillStream_ == nullptr) {
+        break;
+      }
+    }
+    const auto index = nextSpillStream_->currentIndex();
+    if (lastRow != nullptr &&
+        !isSamePartition(lastRow, *nextSpillStream_, index)) {
+      // Keep the stream positioned at the first row of the next partition.
+      break;
+    }
+
+    lastRow = data_->newRow();
+    for (auto i = 0; i < spillType_->size(); ++i) {
+      data_->store(nextSpillStream_->decoded(i), index, lastRow, i);
+    }
+    ++numRows_;
+    nextSpillStream_->pop();
+    nextSpillStream_ = nullptr;
+  }
+
+  if (numRows_ == 0) {
+    return;
+  }
+
+  // The merged rows are already sorted by (partition keys + sort keys) and
+  // the row container lists them in the insertion order.
+  sortedRows_.resize(numRows_);
+  RowContainerIterator iter;
+  data_->listRows(&iter, numRows_, sortedRows_.data());
+  computePartitionStartRows();
+}
+
 void Window::callResetPartition(vector_size_t partitionNumber) {
   partitionOffset_ = 0;
   auto partitionSize = partitionStartRows_[partitionNumber + 1] -
@@ -593,7 +877,7 @@ RowVectorPtr Window::getOutput() {
     data_->extractColumn(
         sortedRows_.data() + numProcessedRows_,
         numOutputRows,
-        i,
+        containerChannels_[i],
         result->childAt(i));
   }
 
@@ -613,8 +897,20 @@ RowVectorPtr Window::getOutput() {
     result->childAt(j) = windowOutputs[j - numInputColumns_];
   }
 
+  if (spillMerge_ != nullptr && numProcessedRows_ == numRows_) {
+    loadNextSpilledPartition();
+  }
   finished_ = (numProcessedRows_ == sortedRows_.size());
   return result;
 }
 
+void Window::close() {
+  Operator::close();
+
+  spillMerge_.reset();
+  spiller_.reset();
+  unspilledData_.reset();
+  data_.reset();
+}
+
 } // namespace facebook::velox::exec
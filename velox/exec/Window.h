@@ -17,6 +17,7 @@
 
 #include "velox/exec/Operator.h"
 #include "velox/exec/RowContainer.h"
+#include "velox/exec/Spiller.h"
 #include "velox/exec/WindowFunction.h"
 #include "velox/exec/WindowPartition.h"
 
@@ -34,6 +35,12 @@ namespace facebook::velox::exec {
 ///
 /// We will revise this algorithm in the future using a HashTable based
 /// approach pending some profiling results.
+///
+/// If spilling is enabled, the input rows are spilled sorted by (partition_by
+/// keys + order_by keys) when the operator runs out of memory. At output time,
+/// the spilled runs are merged and the partitions are read back into the
+/// RowContainer one at a time, so that only a single window partition needs to
+/// fit in memory.
 class Window : public Operator {
  public:
   Window(
@@ -59,6 +66,10 @@ class Window : public Operator {
     return finished_;
   }
 
+  void reclaim(uint64_t targetBytes) override;
+
+  void close() override;
+
  private:
   // Used for k preceding/following frames. Index is the column index if k is a
   // column. value is used to read column values from the column index when k
@@ -86,6 +97,40 @@ class Window : public Operator {
       const std::shared_ptr<const core::WindowNode>& windowNode,
       const RowTypePtr& inputType);
 
+  // Helper function to create the RowContainer 'data_' and the
+  // WindowPartition over it. The partition and sort key columns are stored
+  // first in 'data_' so that the spiller can sort the spilled rows on them.
+  void createRowContainer(const RowTypePtr& inputType);
+
+  // Creates 'windowPartition_' over the columns of 'data_'.
+  void createWindowPartition();
+
+  // Checks if input will fit in the existing memory and increases
+  // reservation if not. If reservation cannot be increased, spills enough to
+  // make 'input' fit.
+  void ensureInputFits(const RowVectorPtr& input);
+
+  // Spills content until under 'targetRows' and under 'targetBytes' of out of
+  // line data are left. If 'targetRows' is 0, spills everything and physically
+  // frees the data in the 'data_'.
+  void spill(int64_t targetRows, int64_t targetBytes);
+
+  // Invoked to record the spilling stats in operator stats after processing all
+  // the inputs.
+  void recordSpillStats();
+
+  // Reads the rows of the next window partition from 'spillMerge_' into
+  // 'data_' and resets the output state to process it. Sets 'numRows_' to 0
+  // if all the spilled partitions have been processed.
+  void loadNextSpilledPartition();
+
+  // Returns true if the row at 'index' of 'stream' belongs to the same
+  // partition as 'row' in 'data_'.
+  bool isSamePartition(
+      const char* row,
+      SpillMergeStream& stream,
+      vector_size_t index);
+
   // Helper function to create the buffers for peer and frame
   // row indices to send in window function apply invocations.
   void createPeerAndFrameBuffers();
@@ -161,9 +206,24 @@ class Window : public Operator {
   bool finished_ = false;
   const vector_size_t numInputColumns_;
 
+  // The maximum memory usage that a window can hold before spilling.
+  // If it is zero, then there is no such limit.
+  const uint64_t spillMemoryThreshold_;
+
+  // The column index in 'data_' of each input column.
+  std::vector<column_index_t> containerChannels_;
+
+  // The row type of 'data_' which is also used for spilling. The partition
+  // and sort key columns come first.
+  RowTypePtr spillType_;
+
+  // The compare flags of the leading key columns in 'spillType_'.
+  std::vector<CompareFlags> spillCompareFlags_;
+
   // The Window operator needs to see all the input rows before starting
   // any function computation. As the Window operators gets input rows
-  // we store the rows in the RowContainer (data_).
+  // we store the rows in the RowContainer (data_). If spilling has been
+  // triggered, this only holds the window partition being output.
   std::unique_ptr<RowContainer> data_;
 
   // The decodedInputVectors_ are reused across addInput() calls to decode
@@ -174,9 +234,10 @@ class Window : public Operator {
   // buffers.
   HashStringAllocator stringAllocator_;
 
-  // The below 3 vectors represent the ChannelIndex of the partition keys,
-  // the order by keys and the concatenation of the 2. These keyInfo are
-  // used for sorting by those key combinations during the processing.
+  // The below 3 vectors represent the column index in 'data_' of the
+  // partition keys, the order by keys and the concatenation of the 2. These
+  // keyInfo are used for sorting by those key combinations during the
+  // processing.
   // partitionKeyInfo_ is used to separate partitions in the rows.
   // sortKeyInfo_ is used to identify peer rows in a partition.
   // allKeyInfo_ is a combination of (partitionKeyInfo_ and sortKeyInfo_).
@@ -263,6 +324,24 @@ class Window : public Operator {
 
   // Tracks how far along the partition rows have been output.
   vector_size_t partitionOffset_ = 0;
+
+  std::unique_ptr<Spiller> spiller_;
+
+  // Counts input batches and triggers spilling if folly hash of this % 100 <=
+  // 'testSpillPct_';.
+  uint64_t spillTestCounter_{0};
+
+  // Holds the rows that were not spilled when the input ended. These are
+  // merged with the spilled runs by 'spillMerge_' while 'data_' only holds the
+  // window partition being output.
+  std::unique_ptr<RowContainer> unspilledData_;
+
+  // Set to read back spilled data if disk spilling has been triggered.
+  std::unique_ptr<TreeOfLosers<SpillMergeStream>> spillMerge_;
+
+  // The stream positioned at the first row of the next spilled partition.
+  // This is set when the previous partition has been fully read.
+  SpillMergeStream* nextSpillStream_{nullptr};
 };
 
 } // namespace facebook::velox::exec
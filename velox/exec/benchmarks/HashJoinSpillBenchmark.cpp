@@ -0,0 +1,358 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <folly/String.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/init/Init.h>
+
+#include "velox/common/base/SuccinctPrinter.h"
+#include "velox/common/memory/SharedArbitrator.h"
+#include "velox/common/time/Timer.h"
+#include "velox/core/QueryConfig.h"
+#include "velox/exec/tests/utils/Cursor.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
+#include "velox/functions/prestosql/aggregates/RegisterAggregateFunctions.h"
+#include "velox/functions/prestosql/registration/RegistrationFunctions.h"
+#include "velox/parse/TypeResolver.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+DEFINE_double(
+    scale_factor,
+    0.1,
+    "TPC-H scale factor of the orders and lineitem data. Each driver reads "
+    "all of it");
+DEFINE_int32(num_drivers, 4, "Number of drivers per pipeline");
+DEFINE_int64(
+    memory_capacity_mb,
+    8 << 10,
+    "Capacity of the shared memory arbitrator");
+DEFINE_int32(
+    num_caps,
+    4,
+    "Number of query memory caps to run with. The i-th cap is 1/2^i of the "
+    "peak memory of the join without spilling");
+DEFINE_string(
+    partition_bits,
+    "1,2,3",
+    "Comma separated values of spiller_partition_bits to run with");
+DEFINE_string(
+    max_spill_levels,
+    "0,1,4",
+    "Comma separated values of max_spill_level to run with");
+
+/// Measures how hash join spilling behaves under shrinking memory. Runs a
+/// lineitem x orders join on o_orderkey, first without spilling to find the
+/// peak memory, then with query memory caps of 1/2, 1/4... of that. The caps
+/// are enforced by the shared arbitrator, which reclaims from the hash build
+/// by spilling. Each run reports the wall time, the bytes spilled at each
+/// spill level and the probe re-read amplification, which is the number of
+/// probe rows processed, including the ones read back from spill, divided by
+/// the number of probe input rows.
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::test;
+
+namespace {
+
+struct RunStats {
+  bool failed{false};
+  std::string error;
+  uint64_t wallUs{0};
+  int64_t peakBytes{0};
+  uint64_t buildSpilledBytes{0};
+  uint64_t buildSpilledRows{0};
+  int32_t maxSpillLevel{-1};
+  // Spilled bytes of build and probe side, keyed by spill level.
+  std::map<int32_t, uint64_t> spilledBytesPerLevel;
+  uint64_t probeInputRows{0};
+  uint64_t probeSpillReadRows{0};
+  uint64_t numArbitrations{0};
+  uint64_t reclaimedBytes{0};
+
+  double probeAmplification() const {
+    if (probeInputRows == 0) {
+      return 0;
+    }
+    return (probeInputRows + probeSpillReadRows) /
+        static_cast<double>(probeInputRows);
+  }
+
+  std::string toString() const {
+    if (failed) {
+      return fmt::format("failed: {}", error);
+    }
+    std::vector<std::string> levels;
+    for (const auto& [level, bytes] : spilledBytesPerLevel) {
+      levels.push_back(fmt::format("L{} {}", level, succinctBytes(bytes)));
+    }
+    return fmt::format(
+        "{} peak {} build spilled {} / {} rows max level {} per level [{}] "
+        "probe amplification {:.2f}x arbitrations {} reclaimed {}",
+        succinctMicros(wallUs),
+        succinctBytes(peakBytes),
+        succinctBytes(buildSpilledBytes),
+        buildSpilledRows,
+        maxSpillLevel,
+        folly::join(", ", levels),
+        probeAmplification(),
+        numArbitrations,
+        succinctBytes(reclaimedBytes));
+  }
+};
+
+class HashJoinSpillBenchmark : public VectorTestBase {
+ public:
+  HashJoinSpillBenchmark() {
+    memory::IMemoryManager::Options options;
+    options.capacity = FLAGS_memory_capacity_mb << 20;
+    options.arbitratorConfig = {
+        .kind = memory::MemoryArbitrator::Kind::kShared,
+        .capacity = options.capacity,
+        .initMemoryPoolCapacity = 16 << 20,
+        .minMemoryPoolCapacityTransferSize = 8 << 20};
+    memoryManager_ = std::make_unique<memory::MemoryManager>(options);
+    executor_ =
+        std::make_unique<folly::CPUThreadPoolExecutor>(FLAGS_num_drivers * 2);
+  }
+
+  // Makes orders and lineitem with TPC-H key distributions. Order keys are
+  // sparse, 8 of every 32 are used, and each order has 1 to 7 line items.
+  void makeData() {
+    const int32_t numOrders = 1'500'000 * FLAGS_scale_factor;
+    const int32_t numCustomers = std::max<int32_t>(1, numOrders / 10);
+    const int32_t numParts = std::max<int32_t>(1, numOrders * 2 / 15);
+    auto orderKey = [](int64_t order) { return (order / 8) * 32 + order % 8; };
+    auto numLines = [](int64_t order) { return 1 + (order * 2654435761) % 7; };
+
+    for (int32_t start = 0; start < numOrders; start += kBatchSize) {
+      const auto size = std::min(kBatchSize, numOrders - start);
+      orders_.push_back(makeRowVector(
+          {"o_orderkey", "o_custkey", "o_totalprice", "o_comment"},
+          {makeFlatVector<int64_t>(
+               size, [&](auto row) { return orderKey(start + row); }),
+           makeFlatVector<int64_t>(
+               size,
+               [&](auto row) { return (start + row) * 7 % numCustomers; }),
+           makeFlatVector<double>(
+               size, [&](auto row) { return (start + row) % 500'000 / 1.7; }),
+           makeFlatVector<StringView>(size, [&](auto row) {
+             return StringView(kComment.data(), 19 + (start + row) % 60);
+           })}));
+    }
+
+    std::vector<int64_t> lineOrders;
+    for (int64_t order = 0; order < numOrders; ++order) {
+      lineOrders.insert(lineOrders.end(), numLines(order), order);
+    }
+    numLineItems_ = lineOrders.size();
+    for (int32_t start = 0; start < numLineItems_; start += kBatchSize) {
+      const auto size = std::min<int32_t>(kBatchSize, numLineItems_ - start);
+      lineItems_.push_back(makeRowVector(
+          {"l_orderkey",
+           "l_partkey",
+           "l_quantity",
+           "l_extendedprice",
+           "l_comment"},
+          {makeFlatVector<int64_t>(
+               size,
+               [&](auto row) { return orderKey(lineOrders[start + row]); }),
+           makeFlatVector<int64_t>(
+               size, [&](auto row) { return (start + row) * 13 % numParts; }),
+           makeFlatVector<double>(
+               size, [&](auto row) { return 1 + (start + row) % 50; }),
+           makeFlatVector<double>(
+               size, [&](auto row) { return (start + row) % 100'000 / 3.1; }),
+           makeFlatVector<StringView>(size, [&](auto row) {
+             return StringView(kComment.data(), 10 + (start + row) % 34);
+           })}));
+    }
+    std::cout << fmt::format(
+                     "{} orders, {} line items, {} drivers",
+                     numOrders,
+                     numLineItems_,
+                     FLAGS_num_drivers)
+              << std::endl;
+  }
+
+  // Runs the join with a query memory cap of 'memoryCap'. Spilling is
+  // disabled if 'partitionBits' is 0.
+  RunStats
+  run(int64_t memoryCap, int32_t partitionBits, int32_t maxSpillLevel) {
+    RunStats stats;
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    auto plan = PlanBuilder(planNodeIdGenerator)
+                    .values(lineItems_, true)
+                    .hashJoin(
+                        {"l_orderkey"},
+                        {"o_orderkey"},
+                        PlanBuilder(planNodeIdGenerator)
+                            .values(orders_, true)
+                            .planNode(),
+                        "",
+                        {"l_partkey",
+                         "l_extendedprice",
+                         "o_custkey",
+                         "o_totalprice",
+                         "o_comment"})
+                    .partialAggregation(
+                        {}, {"count(1)", "sum(l_extendedprice)"})
+                    .localPartition({})
+                    .finalAggregation()
+                    .planNode();
+
+    std::unordered_map<std::string, std::string> config;
+    if (partitionBits > 0) {
+      config[core::QueryConfig::kSpillEnabled] = "true";
+      config[core::QueryConfig::kJoinSpillEnabled] = "true";
+      config[core::QueryConfig::kSpillPartitionBits] =
+          std::to_string(partitionBits);
+      config[core::QueryConfig::kMaxSpillLevel] =
+          std::to_string(maxSpillLevel);
+    }
+    auto queryCtx = std::make_shared<core::QueryCtx>(
+        executor_.get(),
+        std::move(config),
+        std::unordered_map<std::string, std::shared_ptr<Config>>{},
+        memory::MemoryAllocator::getInstance(),
+        memoryManager_->addRootPool(
+            fmt::format("HashJoinSpillBenchmark{}", numRuns_++),
+            memoryCap,
+            memory::MemoryReclaimer::create()));
+    auto spillDirectory = TempDirectoryPath::create();
+
+    CursorParameters params;
+    params.planNode = plan;
+    params.queryCtx = queryCtx;
+    params.maxDrivers = FLAGS_num_drivers;
+    params.spillDirectory = spillDirectory->path;
+
+    const auto oldArbitratorStats = memoryManager_->arbitrator()->stats();
+    std::shared_ptr<Task> task;
+    {
+      MicrosecondTimer timer(&stats.wallUs);
+      try {
+        TaskCursor cursor(params);
+        int64_t count = 0;
+        while (cursor.moveNext()) {
+          auto* counts =
+              cursor.current()->childAt(0)->as<SimpleVector<int64_t>>();
+          for (auto i = 0; i < counts->size(); ++i) {
+            count += counts->valueAt(i);
+          }
+        }
+        task = cursor.task();
+        // Each driver reads all of lineitem and orders.
+        const int64_t expectedCount =
+            numLineItems_ * FLAGS_num_drivers * FLAGS_num_drivers;
+        VELOX_CHECK_EQ(count, expectedCount, "Wrong join result");
+      } catch (const VeloxException& e) {
+        stats.failed = true;
+        stats.error = e.message();
+        return stats;
+      }
+    }
+    const auto newArbitratorStats = memoryManager_->arbitrator()->stats();
+    stats.numArbitrations =
+        newArbitratorStats.numRequests - oldArbitratorStats.numRequests;
+    stats.reclaimedBytes = newArbitratorStats.numReclaimedBytes -
+        oldArbitratorStats.numReclaimedBytes;
+    stats.peakBytes = queryCtx->pool()->peakBytes();
+
+    static const std::string kLevelPrefix = "spilledBytesAtLevel";
+    for (auto& pipeline : task->taskStats().pipelineStats) {
+      for (auto& op : pipeline.operatorStats) {
+        const bool isBuild = op.operatorType == "HashBuild";
+        if (!isBuild && op.operatorType != "HashProbe") {
+          continue;
+        }
+        for (const auto& [name, metric] : op.runtimeStats) {
+          if (name.compare(0, kLevelPrefix.size(), kLevelPrefix) == 0) {
+            stats.spilledBytesPerLevel[std::stoi(
+                name.substr(kLevelPrefix.size()))] += metric.sum;
+          }
+        }
+        if (isBuild) {
+          stats.buildSpilledBytes += op.spilledBytes;
+          stats.buildSpilledRows += op.spilledRows;
+          auto it = op.runtimeStats.find("maxSpillLevel");
+          if (it != op.runtimeStats.end()) {
+            stats.maxSpillLevel =
+                std::max<int32_t>(stats.maxSpillLevel, it->second.max);
+          }
+        } else {
+          stats.probeInputRows += op.inputPositions;
+          auto it = op.runtimeStats.find("spillReadRows");
+          if (it != op.runtimeStats.end()) {
+            stats.probeSpillReadRows += it->second.sum;
+          }
+        }
+      }
+    }
+    return stats;
+  }
+
+  void runAll() {
+    const auto baseline = run(memory::kMaxMemory, 0, 0);
+    std::cout << "No spill: " << baseline.toString() << std::endl;
+    if (baseline.failed) {
+      return;
+    }
+    std::vector<int32_t> partitionBits;
+    folly::split(',', FLAGS_partition_bits, partitionBits);
+    std::vector<int32_t> maxSpillLevels;
+    folly::split(',', FLAGS_max_spill_levels, maxSpillLevels);
+    for (auto i = 1; i <= FLAGS_num_caps; ++i) {
+      const int64_t cap = baseline.peakBytes >> i;
+      for (auto bits : partitionBits) {
+        for (auto maxSpillLevel : maxSpillLevels) {
+          const auto stats = run(cap, bits, maxSpillLevel);
+          std::cout << fmt::format(
+                           "Cap {} partition bits {} max spill level {}: {}",
+                           succinctBytes(cap),
+                           bits,
+                           maxSpillLevel,
+                           stats.toString())
+                    << std::endl;
+        }
+      }
+    }
+  }
+
+ private:
+  static constexpr int32_t kBatchSize = 10'000;
+  static inline const std::string kComment = std::string(100, 'x');
+
+  std::unique_ptr<memory::MemoryManager> memoryManager_;
+  std::unique_ptr<folly::CPUThreadPoolExecutor> executor_;
+  std::vector<RowVectorPtr> orders_;
+  std::vector<RowVectorPtr> lineItems_;
+  int64_t numLineItems_{0};
+  int32_t numRuns_{0};
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  functions::prestosql::registerAllScalarFunctions();
+  aggregate::prestosql::registerAllAggregateFunctions();
+  parse::registerTypeResolver();
+  HashJoinSpillBenchmark bm;
+  bm.makeData();
+  bm.runAll();
+  return 0;
+}
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include <thread>
+
+#include "velox/exec/LocalPartition.h"
+#include "velox/vector/tests/utils/VectorMaker.h"
+
+DEFINE_int32(num_consumers, 4, "Number of threads fetching from the queue");
+DEFINE_int32(
+    batch_rows,
+    16,
+    "Rows per enqueued vector. Small batches stress the queue itself");
+DEFINE_int64(buffer_mb, 32, "Memory limit of the local exchange");
+
+/// Measures contention on a single LocalExchangeQueue. A varying number of
+/// producer threads each enqueue the benchmark iteration count of small
+/// vectors while FLAGS_num_consumers threads fetch them. Producers and
+/// consumers block on the returned futures like drivers would.
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::test;
+
+namespace {
+
+void produce(LocalExchangeQueue& queue, const RowVectorPtr& data, int32_t n) {
+  for (auto i = 0; i < n; ++i) {
+    ContinueFuture future;
+    if (queue.enqueue(data, &future) != BlockingReason::kNotBlocked) {
+      future.wait();
+    }
+  }
+  queue.noMoreData();
+}
+
+int64_t consume(LocalExchangeQueue& queue, memory::MemoryPool* pool) {
+  int64_t numRows = 0;
+  for (;;) {
+    RowVectorPtr data;
+    ContinueFuture future;
+    if (queue.next(&future, pool, &data) != BlockingReason::kNotBlocked) {
+      future.wait();
+      continue;
+    }
+    if (data == nullptr) {
+      return numRows;
+    }
+    numRows += data->size();
+  }
+}
+
+void contention(uint32_t iters, int32_t numProducers) {
+  folly::BenchmarkSuspender suspender;
+  auto pool = memory::addDefaultLeafMemoryPool();
+  VectorMaker vectorMaker(pool.get());
+  auto data = vectorMaker.rowVector(
+      {vectorMaker.flatVector<int64_t>(
+          FLAGS_batch_rows, [](auto row) { return row; })});
+
+  auto memoryManager =
+      std::make_shared<LocalExchangeMemoryManager>(FLAGS_buffer_mb << 20);
+  LocalExchangeQueue queue(memoryManager, 0);
+  for (auto i = 0; i < numProducers; ++i) {
+    queue.addProducer();
+  }
+  queue.noMoreProducers();
+
+  std::vector<int64_t> numRows(FLAGS_num_consumers);
+  std::vector<std::thread> threads;
+  threads.reserve(numProducers + FLAGS_num_consumers);
+  suspender.dismiss();
+
+  for (auto i = 0; i < FLAGS_num_consumers; ++i) {
+    threads.emplace_back(
+        [&, i]() { numRows[i] = consume(queue, pool.get()); });
+  }
+  for (auto i = 0; i < numProducers; ++i) {
+    threads.emplace_back([&]() { produce(queue, data, iters); });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  suspender.rehire();
+  int64_t totalRows = 0;
+  for (auto rows : numRows) {
+    totalRows += rows;
+  }
+  VELOX_CHECK_EQ(
+      totalRows, static_cast<int64_t>(iters) * numProducers * data->size());
+  VELOX_CHECK(queue.isFinished());
+}
+
+} // namespace
+
+BENCHMARK_PARAM(contention, 1);
+BENCHMARK_PARAM(contention, 4);
+BENCHMARK_PARAM(contention, 16);
+BENCHMARK_PARAM(contention, 32);
+BENCHMARK_PARAM(contention, 64);
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
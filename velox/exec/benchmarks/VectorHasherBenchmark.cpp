@@ -15,6 +15,7 @@
  */
 #include <folly/Benchmark.h>
 #include <folly/init/Init.h>
+#include "velox/exec/HashTable.h"
 #include "velox/exec/VectorHasher.h"
 #include "velox/vector/tests/utils/VectorMaker.h"
 
@@ -29,6 +30,10 @@ class BenchmarkBase {
     return vectorMaker_;
   }
 
+  memory::MemoryPool* pool() const {
+    return pool_.get();
+  }
+
   BufferPtr makeIndices(
       vector_size_t size,
       std::function<vector_size_t(vector_size_t)> indexAt) {
@@ -80,6 +85,85 @@ void benchmarkComputeValueIds(bool withNulls) {
     folly::doNotOptimizeAway(ok);
   }
 }
+
+// Builds a join table on two bigint keys with widely spaced values, which puts
+// the table in kNormalizedKey mode, and probes it with batches where
+// 'hitPct' percent of the rows have a match. Both keys of a miss exist in
+// the table, so that the miss is found by the probe and not by the value id
+// lookup.
+void benchmarkNormalizedKeyJoinProbe(int32_t hitPct) {
+  folly::BenchmarkSuspender suspender;
+  constexpr vector_size_t kNumBuildRows = 100'000;
+  constexpr vector_size_t kBatchSize = 1'000;
+  BenchmarkBase base;
+  auto makeKeys = [&](vector_size_t size,
+                      std::function<int64_t(vector_size_t)> key0,
+                      std::function<int64_t(vector_size_t)> key1) {
+    return base.vectorMaker().rowVector(
+        {base.vectorMaker().flatVector<int64_t>(
+             size, [&](auto row) { return key0(row) * 1'000; }),
+         base.vectorMaker().flatVector<int64_t>(
+             size, [&](auto row) { return key1(row) * 7'919; })});
+  };
+  auto build = makeKeys(
+      kNumBuildRows,
+      [](auto row) { return row; },
+      [](auto row) { return row; });
+
+  std::vector<std::unique_ptr<VectorHasher>> hashers;
+  hashers.push_back(std::make_unique<VectorHasher>(BIGINT(), 0));
+  hashers.push_back(std::make_unique<VectorHasher>(BIGINT(), 1));
+  auto table = HashTable<true>::createForJoin(
+      std::move(hashers), {}, false, false, base.pool());
+
+  SelectivityVector buildRows(kNumBuildRows);
+  raw_vector<uint64_t> valueIds(kNumBuildRows);
+  std::vector<DecodedVector> decoded(build->childrenSize());
+  for (auto i = 0; i < build->childrenSize(); ++i) {
+    decoded[i].decode(*build->childAt(i), buildRows);
+    auto& hasher = table->hashers()[i];
+    hasher->decode(*build->childAt(i), buildRows);
+    hasher->computeValueIds(buildRows, valueIds);
+  }
+  auto* rowContainer = table->rows();
+  for (auto row = 0; row < kNumBuildRows; ++row) {
+    auto* newRow = rowContainer->newRow();
+    for (auto i = 0; i < decoded.size(); ++i) {
+      rowContainer->store(decoded[i], row, newRow, i);
+    }
+  }
+  table->prepareJoinTable({});
+  VELOX_CHECK(
+      table->hashMode() == BaseHashTable::HashMode::kNormalizedKey,
+      "Unexpected hash mode: {}",
+      BaseHashTable::modeString(table->hashMode()));
+
+  auto probe = makeKeys(
+      kBatchSize,
+      [](auto row) { return (row * 97) % kNumBuildRows; },
+      [&](auto row) {
+        const auto key = (row * 97) % kNumBuildRows;
+        return row % 100 < hitPct ? key : (key + 1) % kNumBuildRows;
+      });
+  HashLookup lookup(table->hashers());
+  VectorHasher::ScratchMemory scratchMemory;
+  SelectivityVector probeRows(kBatchSize);
+  suspender.dismiss();
+
+  int32_t numHits = 0;
+  for (auto i = 0; i < 10'000; ++i) {
+    probeRows.setAll();
+    lookup.reset(kBatchSize);
+    for (auto key = 0; key < probe->childrenSize(); ++key) {
+      table->hashers()[key]->lookupValueIds(
+          *probe->childAt(key), probeRows, scratchMemory, lookup.hashes);
+    }
+    std::iota(lookup.rows.begin(), lookup.rows.end(), 0);
+    table->joinProbe(lookup);
+    numHits += lookup.hits[0] != nullptr;
+  }
+  folly::doNotOptimizeAway(numHits);
+}
 } // namespace
 
 // Uses SIMD acceleration
@@ -177,6 +261,18 @@ BENCHMARK_RELATIVE(computeValueIdsFlatStrings) {
   benchmarkComputeValueIdsForStrings(true);
 }
 
+BENCHMARK(joinProbeNormalizedKeyAllHits) {
+  benchmarkNormalizedKeyJoinProbe(100);
+}
+
+BENCHMARK_RELATIVE(joinProbeNormalizedKeyHalfHits) {
+  benchmarkNormalizedKeyJoinProbe(50);
+}
+
+BENCHMARK_RELATIVE(joinProbeNormalizedKeyNoHits) {
+  benchmarkNormalizedKeyJoinProbe(0);
+}
+
 int main(int argc, char** argv) {
   folly::init(&argc, &argv);
   folly::runBenchmarks();
@@ -793,6 +793,49 @@ TEST_F(AggregationTest, partialDistinctWithAbandon) {
              .assertResults("SELECT distinct c0, sum(c0) FROM tmp group by c0");
 }
 
+TEST_F(AggregationTest, adaptivePartialAggregation) {
+  // Even rows repeat a few keys, odd rows have keys that never repeat. The
+  // hash partitions that see only unique keys are expected to be passed
+  // through while the ones with the repeating keys keep aggregating.
+  constexpr int32_t kBatchSize = 1'600;
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 10; ++i) {
+    vectors.push_back(makeRowVector(
+        {makeFlatVector<int64_t>(
+             kBatchSize,
+             [&](auto row) {
+               return row % 2 == 0 ? row % 8 : 1'000 + i * kBatchSize + row;
+             }),
+         makeFlatVector<int64_t>(kBatchSize, [](auto row) { return row; })}));
+  }
+  createDuckDbTable(vectors);
+
+  core::PlanNodeId aggNodeId;
+  auto task =
+      AssertQueryBuilder(duckDbQueryRunner_)
+          .config(QueryConfig::kAdaptivePartialAggregationEnabled, "true")
+          .config(
+              QueryConfig::kAbandonPartialAggregationMinRows,
+              std::to_string(kBatchSize))
+          .config("max_drivers_per_task", "1")
+          .plan(PlanBuilder()
+                    .values(vectors)
+                    .partialAggregation({"c0"}, {"sum(c1)", "count(1)"})
+                    .capturePlanNodeId(aggNodeId)
+                    .finalAggregation()
+                    .planNode())
+          .assertResults("SELECT c0, sum(c1), count(1) FROM tmp GROUP BY 1");
+
+  auto stats = toPlanStats(task->taskStats()).at(aggNodeId).customStats;
+  EXPECT_GT(stats.at("passThroughRows").sum, 0);
+  EXPECT_LT(stats.at("passThroughRows").sum, vectors.size() * kBatchSize / 2);
+  EXPECT_GT(stats.at("passThroughPartitions").max, 0);
+  EXPECT_LT(
+      stats.at("passThroughPartitions").max,
+      GroupingSet::kNumPassThroughPartitions);
+  EXPECT_EQ(0, stats.count("abandonedPartialAggregation"));
+}
+
 TEST_F(AggregationTest, largeValueRangeArray) {
   // We have keys that map to integer range. The keys are
   // a little under max array hash table size apart. This wastes 16MB of
@@ -3964,6 +3964,118 @@ TEST_F(HashJoinTest, dynamicFilters) {
   }
 }
 
+TEST_F(HashJoinTest, bloomFilterPushdown) {
+  const int32_t numSplits = 10;
+  const int32_t numRowsProbe = 2'000;
+  // More than 10K distinct string keys longer than 7 bytes make the join table
+  // use kHash mode which can't produce exact dynamic filters.
+  const int32_t numRowsBuild = 20'000;
+
+  auto makeKeys = [&](int32_t size, std::function<int64_t(int32_t)> valueAt) {
+    std::vector<std::string> keys;
+    keys.reserve(size);
+    for (auto row = 0; row < size; ++row) {
+      keys.push_back(fmt::format("key-{:08}", valueAt(row)));
+    }
+    return makeFlatVector<std::string>(keys);
+  };
+
+  std::vector<RowVectorPtr> probeVectors;
+  std::vector<std::shared_ptr<TempFilePath>> tempFiles;
+  for (int32_t i = 0; i < numSplits; ++i) {
+    // Only one in three probe keys has a match on the build side.
+    auto rowVector = makeRowVector({
+        makeKeys(
+            numRowsProbe,
+            [&](auto row) { return 3 * (i * numRowsProbe + row); }),
+        makeFlatVector<int64_t>(numRowsProbe, [](auto row) { return row; }),
+    });
+    probeVectors.push_back(rowVector);
+    tempFiles.push_back(TempFilePath::create());
+    writeToFile(tempFiles.back()->path, rowVector);
+  }
+  auto makeInputSplits = [&](const core::PlanNodeId& nodeId) {
+    return [&] {
+      std::vector<exec::Split> probeSplits;
+      for (auto& file : tempFiles) {
+        probeSplits.push_back(exec::Split(makeHiveConnectorSplit(file->path)));
+      }
+      SplitInput splits;
+      splits.emplace(nodeId, probeSplits);
+      return splits;
+    };
+  };
+
+  std::vector<RowVectorPtr> buildVectors;
+  for (int i = 0; i < 5; ++i) {
+    buildVectors.push_back(makeRowVector({
+        makeKeys(
+            numRowsBuild / 5,
+            [&](auto row) { return row + i * numRowsBuild / 5; }),
+        makeFlatVector<int64_t>(numRowsBuild / 5, [](auto row) { return row; }),
+    }));
+  }
+
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  auto probeType = ROW({"c0", "c1"}, {VARCHAR(), BIGINT()});
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto buildSide = PlanBuilder(planNodeIdGenerator, pool_.get())
+                       .values(buildVectors)
+                       .project({"c0 AS u_c0", "c1 AS u_c1"})
+                       .planNode();
+
+  for (const auto& joinType :
+       {core::JoinType::kInner, core::JoinType::kLeftSemiFilter}) {
+    for (bool enabled : {false, true}) {
+      SCOPED_TRACE(fmt::format(
+          "joinType: {}, enabled: {}", core::joinTypeName(joinType), enabled));
+      core::PlanNodeId probeScanId;
+      const bool isInner = joinType == core::JoinType::kInner;
+      auto op = PlanBuilder(planNodeIdGenerator, pool_.get())
+                    .tableScan(probeType)
+                    .capturePlanNodeId(probeScanId)
+                    .hashJoin(
+                        {"c0"},
+                        {"u_c0"},
+                        buildSide,
+                        "",
+                        isInner ? std::vector<std::string>{"c0", "c1", "u_c1"}
+                                : std::vector<std::string>{"c0", "c1"},
+                        joinType)
+                    .planNode();
+      HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+          .planNode(std::move(op))
+          .makeInputSplits(makeInputSplits(probeScanId))
+          .config(
+              core::QueryConfig::kHashJoinBloomFilterPushdownEnabled,
+              enabled ? "true" : "false")
+          .referenceQuery(
+              isInner
+                  ? "SELECT t.c0, t.c1, u.c1 FROM t, u WHERE t.c0 = u.c0"
+                  : "SELECT t.c0, t.c1 FROM t WHERE t.c0 IN (SELECT c0 FROM u)")
+          .verifier([&](const std::shared_ptr<Task>& task, bool hasSpill) {
+            SCOPED_TRACE(fmt::format("hasSpill:{}", hasSpill));
+            if (hasSpill || !enabled) {
+              ASSERT_EQ(0, getFiltersProduced(task, 1).sum);
+              ASSERT_EQ(0, getFiltersAccepted(task, 0).sum);
+              ASSERT_EQ(getInputPositions(task, 1), numRowsProbe * numSplits);
+            } else {
+              ASSERT_EQ(1, getFiltersProduced(task, 1).sum);
+              ASSERT_EQ(1, getFiltersAccepted(task, 0).sum);
+              // The Bloom filter is approximate and can't replace the join.
+              ASSERT_EQ(0, getReplacedWithFilterRows(task, 1).sum);
+              // About 1/3 of the probe rows match plus ~1% false positives.
+              ASSERT_LT(
+                  getInputPositions(task, 1), numRowsProbe * numSplits / 2);
+            }
+          })
+          .run();
+    }
+  }
+}
+
 TEST_F(HashJoinTest, dynamicFiltersWithSkippedSplits) {
   const int32_t numSplits = 20;
   const int32_t numNonSkippedSplits = 10;
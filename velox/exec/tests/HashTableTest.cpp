@@ -402,7 +402,11 @@ class HashTableTest : public testing::TestWithParam<bool> {
         {
           numProbed += lookup->rows.size();
           SelectivityTimer timer(probeTime, 0);
-          topTable_->joinProbe(*lookup);
+          if (checkSimdProbe_) {
+            checkSimdProbe(*lookup);
+          } else {
+            topTable_->joinProbe(*lookup);
+          }
         }
         for (auto i = 0; i < lookup->rows.size(); ++i) {
           auto key = lookup->rows[i];
@@ -422,6 +426,23 @@ class HashTableTest : public testing::TestWithParam<bool> {
         << std::endl;
   }
 
+  // Probes 'lookup' with the scalar and the SIMD batch probe of a
+  // kNormalizedKey table and checks that both find the same hits.
+  void checkSimdProbe(HashLookup& lookup) {
+    ASSERT_EQ(topTable_->hashMode(), BaseHashTable::HashMode::kNormalizedKey);
+    // The probe replaces the value ids in 'hashes' with hash numbers.
+    std::vector<uint64_t> hashes(lookup.hashes.begin(), lookup.hashes.end());
+    topTable_->testingSetSimdNormalizedKeyProbe(false);
+    topTable_->joinProbe(lookup);
+    std::vector<char*> scalarHits(lookup.hits.begin(), lookup.hits.end());
+    std::copy(hashes.begin(), hashes.end(), lookup.hashes.data());
+    topTable_->testingSetSimdNormalizedKeyProbe(true);
+    topTable_->joinProbe(lookup);
+    for (auto row : lookup.rows) {
+      ASSERT_EQ(scalarHits[row], lookup.hits[row]);
+    }
+  }
+
   // Erases every strideth non-erased item in the hash table.
   void testEraseEveryN(int32_t stride) {
     std::vector<char*> toErase;
@@ -490,6 +511,9 @@ class HashTableTest : public testing::TestWithParam<bool> {
   // Spacing between consecutive generated keys. Affects whether
   // Vectorhashers make ranges or ids of distinct values.
   int64_t keySpacing_ = 1;
+  // If true, testProbe() compares the SIMD and the scalar probe of a
+  // kNormalizedKey table.
+  bool checkSimdProbe_ = false;
   std::unique_ptr<folly::CPUThreadPoolExecutor> executor_;
 };
 
@@ -527,6 +551,14 @@ TEST_P(HashTableTest, int2SparseNormalizedMostMiss) {
   testCycle(BaseHashTable::HashMode::kNormalizedKey, 100000, 2, type, 2);
 }
 
+TEST_P(HashTableTest, int2SparseNormalizedSimdProbe) {
+  auto type = ROW({"k1", "k2"}, {BIGINT(), BIGINT()});
+  keySpacing_ = 1000;
+  insertPct_ = 50;
+  checkSimdProbe_ = true;
+  testCycle(BaseHashTable::HashMode::kNormalizedKey, 10000, 2, type, 2);
+}
+
 TEST_P(HashTableTest, structKey) {
   auto type =
       ROW({"key"}, {ROW({"k1", "k2", "k3"}, {BIGINT(), VARCHAR(), BIGINT()})});
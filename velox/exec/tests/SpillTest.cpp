@@ -18,6 +18,7 @@
 #include <algorithm>
 #include <memory>
 #include "velox/common/base/RuntimeMetrics.h"
+#include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/file/FileSystems.h"
 #include "velox/exec/OperatorUtils.h"
 #include "velox/exec/tests/utils/TempDirectoryPath.h"
@@ -372,6 +373,71 @@ TEST_F(SpillTest, spillTimestamp) {
   ASSERT_EQ(nullptr, merge->next());
 }
 
+TEST_F(SpillTest, spillCompression) {
+  const std::vector<folly::io::CodecType> compressionKinds = {
+      folly::io::CodecType::LZ4,
+      folly::io::CodecType::ZSTD,
+      folly::io::CodecType::SNAPPY};
+  const int32_t numRows = 10'000;
+  for (const auto compressionKind : compressionKinds) {
+    if (!folly::io::hasCodec(compressionKind)) {
+      continue;
+    }
+    SCOPED_TRACE(fmt::format(
+        "compressionKind: {}", static_cast<int>(compressionKind)));
+    auto tempDirectory = exec::test::TempDirectoryPath::create();
+    const std::string spillPath = tempDirectory->path + "/test";
+    SpillState state(
+        spillPath, 1, 1, {}, 1 << 30, *pool(), compressionKind);
+    ASSERT_EQ(state.compressionKind(), compressionKind);
+    const int partitionIndex = 0;
+    state.setPartitionSpilled(partitionIndex);
+    // Sorted keys with a small value range compress well.
+    state.appendToPartition(
+        partitionIndex,
+        makeRowVector({makeFlatVector<int64_t>(
+            numRows, [](auto row) { return row / 100; })}));
+    state.finishWrite(partitionIndex);
+    ASSERT_TRUE(state.hasFiles(partitionIndex));
+    ASSERT_GT(state.spilledUncompressedBytes(), 0);
+    ASSERT_LT(state.spilledBytes(), state.spilledUncompressedBytes());
+
+    auto merge = state.startMerge(partitionIndex, nullptr);
+    for (auto i = 0; i < numRows; ++i) {
+      auto stream = merge->next();
+      ASSERT_NE(nullptr, stream);
+      ASSERT_EQ(
+          i / 100,
+          stream->decoded(0).valueAt<int64_t>(stream->currentIndex()));
+      stream->pop();
+    }
+    ASSERT_EQ(nullptr, merge->next());
+  }
+}
+
+TEST_F(SpillTest, spillCompressionKindFromString) {
+  ASSERT_EQ(
+      spillCompressionKindFromString("none"),
+      folly::io::CodecType::NO_COMPRESSION);
+  const std::vector<std::pair<std::string, folly::io::CodecType>> kinds = {
+      {"lz4", folly::io::CodecType::LZ4},
+      {"zstd", folly::io::CodecType::ZSTD},
+      {"snappy", folly::io::CodecType::SNAPPY}};
+  for (const auto& [name, kind] : kinds) {
+    if (folly::io::hasCodec(kind)) {
+      ASSERT_EQ(spillCompressionKindFromString(name), kind);
+    } else {
+      // A codec missing from the folly build is rejected up front instead of
+      // failing at the first spill.
+      VELOX_ASSERT_THROW(
+          spillCompressionKindFromString(name), "is not available");
+    }
+  }
+  VELOX_ASSERT_THROW(
+      spillCompressionKindFromString("gzip"),
+      "Unsupported spill compression kind: gzip");
+}
+
 TEST_F(SpillTest, spillStateWithSmallTargetFileSize) {
   // Set the target file size to a small value to open a new file on each batch
   // write.
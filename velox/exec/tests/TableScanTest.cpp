@@ -16,6 +16,7 @@
 #include "velox/exec/TableScan.h"
 #include "velox/common/base/Fs.h"
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/caching/SsdCache.h"
 #include "velox/connectors/hive/HiveConnector.h"
 #include "velox/connectors/hive/HiveConnectorSplit.h"
 #include "velox/dwio/common/tests/utils/DataFiles.h"
@@ -25,6 +26,7 @@
 #include "velox/exec/tests/utils/Cursor.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
 #include "velox/expression/ExprToSubfieldFilter.h"
 #include "velox/type/Timestamp.h"
 #include "velox/type/Type.h"
@@ -2528,6 +2530,60 @@ TEST_F(TableScanTest, errorInLoadLazy) {
   }
 }
 
+TEST_F(TableScanTest, ssdAdmissionStats) {
+  // A cache with SSD that admits data of columns read at least twice. Scans
+  // with this cache report their references and reads to its group stats.
+  gflags::FlagSaver flagSaver;
+  FLAGS_ssd_odirect = false;
+  auto ssdDirectory = TempDirectoryPath::create();
+  auto asyncCache = std::make_shared<cache::AsyncDataCache>(
+      memory::MemoryAllocator::createDefaultInstance(),
+      1UL << 30,
+      std::make_unique<cache::SsdCache>(
+          fmt::format("{}/cache", ssdDirectory->path),
+          64 << 20,
+          1,
+          ioExecutor_.get(),
+          0,
+          false,
+          2));
+  auto queryCtx = std::make_shared<core::QueryCtx>(
+      driverExecutor_.get(),
+      std::unordered_map<std::string, std::string>{},
+      std::unordered_map<std::string, std::shared_ptr<Config>>{},
+      asyncCache.get());
+
+  auto vectors = makeVectors(10, 1'000);
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->path, vectors);
+  auto plan = tableScanNode(ROW({"c0"}, {BIGINT()}));
+  auto& groupStats = asyncCache->ssdCache()->groupStats();
+  EXPECT_EQ(
+      "<FileGroupStats: 0 groups 0 columns, 0 columns 0MB qualify for SSD, "
+      "tracked working set 0MB 100% cacheable, min reuse 2>",
+      groupStats.toString(64 << 20));
+  for (auto i = 0; i < 2; ++i) {
+    AssertQueryBuilder(plan)
+        .queryCtx(queryCtx)
+        .split(makeHiveSplit(filePath->path))
+        .copyResults(pool());
+  }
+
+  // The file and the streams of the scanned column are tracked.
+  int32_t numGroups = 0;
+  int32_t numColumns = 0;
+  ASSERT_EQ(
+      2,
+      sscanf(
+          groupStats.toString(64 << 20).c_str(),
+          "<FileGroupStats: %d groups %d columns",
+          &numGroups,
+          &numColumns));
+  EXPECT_EQ(1, numGroups);
+  EXPECT_LT(0, numColumns);
+  asyncCache->ssdCache()->deleteFiles();
+}
+
 TEST_F(TableScanTest, parallelPrepare) {
   constexpr int32_t kNumParallel = 100;
   const char* kLargeRemainingFilter =
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "folly/experimental/EventCount.h"
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/file/FileSystems.h"
+#include "velox/common/testutil/TestValue.h"
+#include "velox/core/QueryConfig.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
+#include "velox/functions/prestosql/window/WindowFunctionsRegistration.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::common::testutil;
+using namespace facebook::velox::exec::test;
+
+class WindowTest : public OperatorTestBase {
+ protected:
+  void SetUp() override {
+    OperatorTestBase::SetUp();
+    filesystems::registerLocalFileSystem();
+    window::prestosql::registerAllWindowFunctions();
+  }
+
+  std::vector<RowVectorPtr> makeInput(int32_t numBatches, int32_t batchSize) {
+    std::vector<RowVectorPtr> batches;
+    for (int32_t i = 0; i < numBatches; ++i) {
+      const auto offset = i * batchSize;
+      batches.push_back(makeRowVector({
+          makeFlatVector<int32_t>(
+              batchSize, [&](auto row) { return (offset + row) % 17; }),
+          makeFlatVector<int64_t>(
+              batchSize, [&](auto row) { return (offset + row) % 101; }),
+          makeFlatVector<StringView>(
+              batchSize,
+              [&](auto row) {
+                return StringView(
+                    fmt::format("string value {}", (offset + row) % 31));
+              }),
+      }));
+    }
+    return batches;
+  }
+
+  core::PlanNodePtr makePlan(const std::vector<RowVectorPtr>& input) {
+    return PlanBuilder()
+        .values(input)
+        .window(
+            {"rank() over (partition by c0 order by c1 nulls last, c2)",
+             "dense_rank() over (partition by c0 order by c1 nulls last, c2)",
+             "cume_dist() over (partition by c0 order by c1 nulls last, c2)"})
+        .planNode();
+  }
+};
+
+DEBUG_ONLY_TEST_F(WindowTest, reclaimDuringInputProcessing) {
+  constexpr int32_t kNumBatches = 10;
+  const auto batches = makeInput(kNumBatches, 1'000);
+
+  // Results of a run without spilling.
+  const auto expectedResult =
+      AssertQueryBuilder(makePlan(batches)).copyResults(pool_.get());
+
+  for (const int32_t reclaimAtInput : {2, kNumBatches}) {
+    SCOPED_TRACE(fmt::format("reclaimAtInput {}", reclaimAtInput));
+
+    folly::EventCount driverWait;
+    auto driverWaitKey = driverWait.prepareWait();
+    folly::EventCount testWait;
+    auto testWaitKey = testWait.prepareWait();
+
+    std::atomic<int32_t> numInputs{0};
+    Operator* op{nullptr};
+    SCOPED_TESTVALUE_SET(
+        "facebook::velox::exec::Driver::runInternal::addInput",
+        std::function<void(Operator*)>(([&](Operator* testOp) {
+          if (testOp->operatorType() != "Window") {
+            return;
+          }
+          if (++numInputs != reclaimAtInput) {
+            return;
+          }
+          op = testOp;
+          testWait.notify();
+          driverWait.wait(driverWaitKey);
+        })));
+
+    auto spillDirectory = TempDirectoryPath::create();
+    std::shared_ptr<Task> task;
+    std::thread taskThread([&]() {
+      task = AssertQueryBuilder(makePlan(batches))
+                 .spillDirectory(spillDirectory->path)
+                 .config(core::QueryConfig::kSpillEnabled, "true")
+                 .config(core::QueryConfig::kWindowSpillEnabled, "true")
+                 .maxDrivers(1)
+                 .assertResults(expectedResult);
+    });
+
+    testWait.wait(testWaitKey);
+    ASSERT_TRUE(op != nullptr);
+    ASSERT_TRUE(op->canReclaim());
+    uint64_t reclaimableBytes{0};
+    ASSERT_TRUE(op->reclaimableBytes(reclaimableBytes));
+
+    auto pausedTask = op->testingOperatorCtx()->task();
+    auto taskPauseWait = pausedTask->requestPause();
+    driverWait.notify();
+    taskPauseWait.wait();
+
+    op->reclaim(0);
+
+    Task::resume(pausedTask);
+    taskThread.join();
+
+    const auto stats = task->taskStats().pipelineStats;
+    ASSERT_GT(stats[0].operatorStats[1].spilledBytes, 0);
+    ASSERT_GT(stats[0].operatorStats[1].spilledRows, 0);
+    ASSERT_EQ(stats[0].operatorStats[1].spilledPartitions, 1);
+    OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
+  }
+}
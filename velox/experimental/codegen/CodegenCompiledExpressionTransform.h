@@ -406,12 +406,12 @@ class CompiledExpressionTransformVisitor {
   /// into                    {PlusExpr,MinusExpr}
   /// [   -> FieldsAccess(c) -> CompiledEpr{c,d}  -> FieldsAccess(b) ->
   /// InputExpr({a,b},{DOUBLE,DOUBLE}) [   -> FieldsAccess(d) / \
-  /// FieldsAccess(a) / \param dynamicObjectPath  compiled code path \param
+  /// FieldsAccess(a) / \param dynamicObject  compiled code library \param
   /// callOutputType compiled expression output row type \param callInputType
   /// compiled expression input  row type \param projectionInputType input type
   /// of the original projection \return
   std::vector<std::shared_ptr<const ITypedExpr>> buildCompiledCallExpr(
-      const std::filesystem::path& dynamicObjectPath,
+      const compiler_utils::CompiledLibraryCache::Library& dynamicObject,
       const std::shared_ptr<const RowType>& callOutputType,
       const std::shared_ptr<const RowType>& callInputType,
       const std::shared_ptr<const RowType>& projectionInputType) {
@@ -421,7 +421,7 @@ class CompiledExpressionTransformVisitor {
 
     // Create ICompiledExpression
     auto compiledExpression = std::make_shared<codegen::ICompiledCall>(
-        dynamicObjectPath, inputFieldAccessVector, callOutputType);
+        dynamicObject, inputFieldAccessVector, callOutputType);
 
     // Create the field accessor to read the output of the compiled call
     auto outputFieldAccessVector =
@@ -487,8 +487,8 @@ class CompiledExpressionTransformVisitor {
             fmt::arg(
                 "isDefaultNullStrict",
                 isDefaultNullStrict(filter.id()) ? "true" : "false")));
-    auto compiledObject = codeManager_.compiler().compileString({}, fileString);
-    auto dynamicObject = codeManager_.compiler().link({}, {compiledObject});
+    auto dynamicObject =
+        codeManager_.compiler().compileAndLinkCached({}, fileString);
 
     // Extract the row input expression from the current filter
     const auto inputType = filter.sources()[0]->outputType();
@@ -586,8 +586,8 @@ class CompiledExpressionTransformVisitor {
                 "isDefaultNullStrict",
                 isDefaultNullStrict ? "true" : "false")));
 
-    auto compiledObject = codeManager_.compiler().compileString({}, fileString);
-    auto dynamicObject = codeManager_.compiler().link({}, {compiledObject});
+    auto dynamicObject =
+        codeManager_.compiler().compileAndLinkCached({}, fileString);
     std::vector<std::shared_ptr<const ITypedExpr>> newProjections;
 
     // Extract the row input expression from the current projection
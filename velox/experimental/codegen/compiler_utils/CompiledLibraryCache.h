@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <folly/container/EvictingCacheMap.h>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace facebook::velox::codegen::compiler_utils {
+
+/// Process wide cache of dynamic libraries produced by Compiler, keyed by a
+/// hash of the generated source and of the compile and link commands.
+/// Compiling and linking a generated expression takes seconds, so a plan
+/// that repeats an expression already seen by this process reuses the
+/// library linked for it instead. The cache holds at most 'maxEntries'
+/// libraries and evicts the least recently used one beyond that. The file of
+/// a library is deleted when the cache and all the users of the library have
+/// dropped it.
+class CompiledLibraryCache {
+ public:
+  /// Path of a dynamic library. The file is deleted with the last reference.
+  using Library = std::shared_ptr<const std::filesystem::path>;
+
+  static constexpr size_t kDefaultMaxEntries = 1'000;
+
+  explicit CompiledLibraryCache(size_t maxEntries = kDefaultMaxEntries)
+      : libraries_(maxEntries) {}
+
+  static CompiledLibraryCache& instance() {
+    static CompiledLibraryCache cache;
+    return cache;
+  }
+
+  /// Returns a Library that owns the file at 'path'.
+  static Library makeLibrary(std::filesystem::path path) {
+    return Library(
+        new std::filesystem::path(std::move(path)),
+        [](const std::filesystem::path* path) {
+          std::error_code error;
+          std::filesystem::remove(*path, error);
+          delete path;
+        });
+  }
+
+  /// Returns the library for 'key', calling 'create' to build it if there is
+  /// no entry or if the file of the entry no longer exists. 'create' returns
+  /// the path of the new library, which the cache then owns. 'create' runs
+  /// outside of the lock. If two threads build the same key at the same time,
+  /// the first to finish is kept and the other library is deleted.
+  Library getOrCreate(
+      const std::string& key,
+      const std::function<std::filesystem::path()>& create) {
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      auto it = libraries_.find(key);
+      if (it != libraries_.end()) {
+        if (std::filesystem::exists(*it->second)) {
+          ++numHits_;
+          return it->second;
+        }
+        libraries_.erase(it);
+      }
+      ++numMisses_;
+    }
+    auto library = makeLibrary(create());
+    std::lock_guard<std::mutex> l(mutex_);
+    auto it = libraries_.find(key);
+    if (it != libraries_.end()) {
+      return it->second;
+    }
+    libraries_.set(key, library);
+    return library;
+  }
+
+  size_t size() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return libraries_.size();
+  }
+
+  uint64_t numHits() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return numHits_;
+  }
+
+  uint64_t numMisses() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return numMisses_;
+  }
+
+  /// Drops all entries. Libraries already loaded stay loaded. The files that
+  /// are no longer referenced are deleted.
+  void clear() {
+    std::lock_guard<std::mutex> l(mutex_);
+    libraries_.clear();
+    numHits_ = 0;
+    numMisses_ = 0;
+  }
+
+ private:
+  mutable std::mutex mutex_;
+  folly::EvictingCacheMap<std::string, Library> libraries_;
+  uint64_t numHits_{0};
+  uint64_t numMisses_{0};
+};
+} // namespace facebook::velox::codegen::compiler_utils
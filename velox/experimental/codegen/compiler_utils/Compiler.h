@@ -14,8 +14,10 @@
  * limitations under the License.
  */
 #pragma once
+#include <folly/hash/SpookyHashV2.h>
 #include "glog/logging.h"
 #include "velox/common/base/Exceptions.h"
+#include "velox/experimental/codegen/compiler_utils/CompiledLibraryCache.h"
 #include "velox/experimental/codegen/compiler_utils/CompilerOptions.h"
 #include "velox/experimental/codegen/external_process/Command.h"
 #include "velox/experimental/codegen/external_process/subprocess.h"
@@ -189,6 +191,48 @@ class Compiler {
     return dynamicLibPath;
   }
 
+  /// Compiles and links a given c++ string, reusing the library of an earlier
+  /// call with the same content, libraries and options in this process.
+  /// \param additionalLibraries
+  /// \param cppContent c++ file content
+  /// \return the generated .so, deleted when no longer referenced
+  CompiledLibraryCache::Library compileAndLinkCached(
+      const std::vector<LibraryDescriptor>& additionalLibraries,
+      const std::string& cppContent) {
+    return CompiledLibraryCache::instance().getOrCreate(
+        fingerprint(additionalLibraries, cppContent), [&]() {
+          auto objectPath = compileString(additionalLibraries, cppContent);
+          auto libraryPath = link(additionalLibraries, {objectPath});
+          std::error_code error;
+          std::filesystem::remove(objectPath, error);
+          return libraryPath;
+        });
+  }
+
+  /// Key of the library built from a c++ string: a 128 bit hash of the
+  /// content and of the compile and link commands without their file
+  /// arguments.
+  /// \param additionalLibraries
+  /// \param cppContent c++ file content
+  /// \return fingerprint string
+  std::string fingerprint(
+      const std::vector<LibraryDescriptor>& additionalLibraries,
+      const std::string& cppContent) {
+    folly::hash::SpookyHashV2 hasher;
+    hasher.Init(0, 0);
+    auto update = [&](const std::string& text) {
+      hasher.Update(text.data(), text.size());
+      hasher.Update("\n", 1);
+    };
+    update(compileCommand(additionalLibraries, {}, {}).toString());
+    update(linkCommand(additionalLibraries, {}, {}).toString());
+    update(cppContent);
+    uint64_t high;
+    uint64_t low;
+    hasher.Final(&high, &low);
+    return fmt::format("{:016x}{:016x}", high, low);
+  }
+
   /// Construct a command object which execution would compile the give files.
   /// \param additionalLibraries
   /// \param cppFile
@@ -17,6 +17,7 @@
 
 #include "velox/core/Expressions.h"
 #include "velox/core/ITypedExpr.h"
+#include "velox/experimental/codegen/compiler_utils/CompiledLibraryCache.h"
 #include "velox/experimental/codegen/vector_function/GeneratedVectorFunction-inl.h"
 
 namespace facebook {
@@ -39,6 +40,15 @@ class ICompiledCall : public core::CallTypedExpr {
       const std::shared_ptr<const RowType>& rowType)
       : core::CallTypedExpr(rowType, inputs, ""),
         dynamicLibPath_{dynamicLibPath} {}
+
+  /// Keeps the file of 'library' until this call is destroyed.
+  ICompiledCall(
+      compiler_utils::CompiledLibraryCache::Library library,
+      const std::vector<std::shared_ptr<const ITypedExpr>>& inputs,
+      const std::shared_ptr<const RowType>& rowType)
+      : core::CallTypedExpr(rowType, inputs, ""),
+        dynamicLibPath_{*library},
+        library_{std::move(library)} {}
   ICompiledCall(const ICompiledCall&) = delete;
   ICompiledCall(ICompiledCall&&) = delete;
 
@@ -118,6 +128,8 @@ class ICompiledCall : public core::CallTypedExpr {
   };
 
   std::filesystem::path dynamicLibPath_;
+  // The library of 'dynamicLibPath_' if it is owned by CompiledLibraryCache.
+  compiler_utils::CompiledLibraryCache::Library library_;
   mutable std::optional<std::string> name_;
   mutable std::optional<NewInstanceSignature> newInstanceFunction_;
 };
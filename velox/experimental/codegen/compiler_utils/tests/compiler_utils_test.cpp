@@ -50,6 +50,77 @@ TEST(CompilerUtils, Command) {
   ASSERT_EQ(command.toString(), expected);
 }
 
+TEST(CompilerUtils, fingerprint) {
+  auto testOptions = CompilerOptions()
+                         .withCompilerPath("/usr/bin/clang")
+                         .withOptimizationLevel("-O3")
+                         .withExtraCompileOptions({"-std=c++17"});
+  DefaultScopedTimer::EventSequence eventSequence;
+  Compiler compiler(testOptions, eventSequence);
+  Compiler otherCompiler(
+      CompilerOptions(testOptions).withOptimizationLevel("-O0"),
+      eventSequence);
+
+  const auto key = compiler.fingerprint({}, "int f() { return 1; }");
+  // A 128 bit hash in hex, not the source text.
+  ASSERT_EQ(key.size(), 32);
+  ASSERT_EQ(key, compiler.fingerprint({}, "int f() { return 1; }"));
+  ASSERT_NE(key, compiler.fingerprint({}, "int f() { return 2; }"));
+  ASSERT_NE(key, otherCompiler.fingerprint({}, "int f() { return 1; }"));
+}
+
+TEST(CompilerUtils, compiledLibraryCache) {
+  auto& cache = CompiledLibraryCache::instance();
+  cache.clear();
+  filesystem::PathGenerator pathGenerator;
+  int32_t numCreates = 0;
+  auto create = [&]() {
+    ++numCreates;
+    return pathGenerator.tempPath("dyn", ".so");
+  };
+
+  auto first = cache.getOrCreate("a", create);
+  ASSERT_EQ(first, cache.getOrCreate("a", create));
+  ASSERT_EQ(numCreates, 1);
+  ASSERT_NE(*first, *cache.getOrCreate("b", create));
+  ASSERT_EQ(numCreates, 2);
+  ASSERT_EQ(cache.size(), 2);
+  ASSERT_EQ(cache.numHits(), 1);
+  ASSERT_EQ(cache.numMisses(), 2);
+
+  // A library removed from disk is built again.
+  std::filesystem::remove(*first);
+  ASSERT_NE(*first, *cache.getOrCreate("a", create));
+  ASSERT_EQ(numCreates, 3);
+
+  cache.clear();
+  ASSERT_EQ(cache.size(), 0);
+}
+
+TEST(CompilerUtils, compiledLibraryCacheEviction) {
+  CompiledLibraryCache cache(2);
+  filesystem::PathGenerator pathGenerator;
+  auto create = [&]() { return pathGenerator.tempPath("dyn", ".so"); };
+
+  const auto firstPath = *cache.getOrCreate("a", create);
+  auto second = cache.getOrCreate("b", create);
+  ASSERT_TRUE(std::filesystem::exists(firstPath));
+
+  // The least recently used library is evicted and its file deleted.
+  cache.getOrCreate("c", create);
+  ASSERT_EQ(cache.size(), 2);
+  ASSERT_FALSE(std::filesystem::exists(firstPath));
+
+  // A library still referenced outside of the cache keeps its file.
+  cache.getOrCreate("a", create);
+  ASSERT_TRUE(std::filesystem::exists(*second));
+  const auto secondPath = *second;
+  second.reset();
+  ASSERT_FALSE(std::filesystem::exists(secondPath));
+
+  cache.clear();
+}
+
 struct LibraryDescriptorProtoTest : public ::testing::Test {
   void SetUp() override {
     testLibraryDescriptor.withName("libraryDescriptorName")
@@ -153,7 +153,11 @@ void ConjunctExpr::evalSpecialForm(
       activeRows->updateBounds();
     }
     numActive = activeRows->countSelected();
-    selectivity_[inputOrder_[i]].addOutput(numActive);
+    auto& selectivity = selectivity_[inputOrder_[i]];
+    selectivity.addOutput(numActive);
+    if (selectivity.numIn() > kMaxSelectivityHistory) {
+      selectivity.decay();
+    }
 
     if (!numActive) {
       break;
@@ -183,7 +187,7 @@ void ConjunctExpr::maybeReorderInputs() {
     }
   }
   if (reorder) {
-    std::sort(
+    std::stable_sort(
         inputOrder_.begin(),
         inputOrder_.end(),
         [this](size_t left, size_t right) {
@@ -74,6 +74,12 @@ class ConjunctExpr : public SpecialForm {
     propagatesNulls_ = false;
   }
 
+  // Halves the selectivity history of an input once it has seen this many
+  // rows, so that the input order follows the recent data.
+  static constexpr uint64_t kMaxSelectivityHistory = 1 << 17;
+
+  // Orders the inputs by ascending time per dropped row, i.e. the cost per row
+  // over the fraction of rows decided.
   void maybeReorderInputs();
 
   void updateResult(
@@ -1154,7 +1154,7 @@ void Expr::evalWithMemo(
   VectorPtr base;
   distinctFields_[0]->evalSpecialForm(rows, context, base);
   ++numCachableInput_;
-  if (baseDictionary_ == base) {
+  if (baseDictionary_ == base || restoreMemo(base)) {
     ++numCacheableRepeats_;
     if (cachedDictionaryIndices_) {
       LocalSelectivityVector cachedHolder(context, rows);
@@ -1210,7 +1210,7 @@ void Expr::evalWithMemo(
     context.releaseVector(base);
     return;
   }
-  context.releaseVector(baseDictionary_);
+  saveMemo();
   baseDictionary_ = base;
   evalWithNulls(rows, context, result);
 
@@ -1224,6 +1224,45 @@ void Expr::evalWithMemo(
   context.deselectErrors(*cachedDictionaryIndices_);
 }
 
+bool Expr::restoreMemo(const VectorPtr& base) {
+  auto it = std::find_if(
+      previousMemos_.begin(), previousMemos_.end(), [&](const auto& memo) {
+        return memo.base == base;
+      });
+  if (it == previousMemos_.end()) {
+    return false;
+  }
+  auto memo = std::move(*it);
+  previousMemos_.erase(it);
+  previousMemoBytes_ -= memo.bytes;
+  saveMemo();
+  baseDictionary_ = std::move(memo.base);
+  dictionaryCache_ = std::move(memo.values);
+  cachedDictionaryIndices_ = std::move(memo.rows);
+  return true;
+}
+
+void Expr::saveMemo() {
+  if (!baseDictionary_ || !dictionaryCache_ || !cachedDictionaryIndices_) {
+    baseDictionary_ = nullptr;
+    dictionaryCache_ = nullptr;
+    return;
+  }
+  const auto bytes =
+      baseDictionary_->retainedSize() + dictionaryCache_->retainedSize();
+  previousMemos_.push_back(
+      {std::move(baseDictionary_),
+       std::move(dictionaryCache_),
+       std::move(cachedDictionaryIndices_),
+       bytes});
+  previousMemoBytes_ += bytes;
+  while (previousMemos_.size() > kMaxPreviousMemos ||
+         previousMemoBytes_ > kMaxPreviousMemoBytes) {
+    previousMemoBytes_ -= previousMemos_.front().bytes;
+    previousMemos_.erase(previousMemos_.begin());
+  }
+}
+
 void Expr::setAllNulls(
     const SelectivityVector& rows,
     EvalCtx& context,
@@ -1686,7 +1725,11 @@ ExprSet::~ExprSet() {
       auto uuid = makeUuid();
       for (const auto& listener : listeners) {
         listener->onCompletion(
-            uuid, {exprStats, sqls, execCtx()->queryCtx()->queryId()});
+            uuid,
+            {exprStats,
+             sqls,
+             execCtx()->queryCtx()->queryId(),
+             simplifications_});
       }
     }
   });
@@ -245,6 +245,8 @@ class Expr {
     baseDictionary_ = nullptr;
     dictionaryCache_ = nullptr;
     cachedDictionaryIndices_ = nullptr;
+    previousMemos_.clear();
+    previousMemoBytes_ = 0;
   }
 
   const TypePtr& type() const {
@@ -417,6 +419,14 @@ class Expr {
       EvalCtx& context,
       VectorPtr& result);
 
+  // Makes the memo of 'base' in 'previousMemos_' current and keeps the
+  // current memo in its place. Returns false if 'base' has no memo.
+  bool restoreMemo(const VectorPtr& base);
+
+  // Moves the current memo to 'previousMemos_', dropping the least recently
+  // used ones to stay within kMaxPreviousMemos and kMaxPreviousMemoBytes.
+  void saveMemo();
+
   void evalWithNulls(
       const SelectivityVector& rows,
       EvalCtx& context,
@@ -597,6 +607,29 @@ class Expr {
   // The indices that are valid in 'dictionaryCache_'.
   std::unique_ptr<SelectivityVector> cachedDictionaryIndices_;
 
+  // Memo of a dictionary base other than 'baseDictionary_'.
+  struct DictionaryMemo {
+    VectorPtr base;
+    VectorPtr values;
+    std::unique_ptr<SelectivityVector> rows;
+    // Retained size of 'base' and 'values'.
+    uint64_t bytes;
+  };
+
+  // Maximum number of entries in 'previousMemos_'.
+  static constexpr int32_t kMaxPreviousMemos = 4;
+
+  // Maximum retained size of 'previousMemos_'.
+  static constexpr uint64_t kMaxPreviousMemoBytes = 16 << 20;
+
+  // Memos of dictionary bases seen before 'baseDictionary_', least recently
+  // used first. Batches that alternate between a few dictionaries, e.g. rows
+  // of different stripes of a file, keep the values computed for each.
+  std::vector<DictionaryMemo> previousMemos_;
+
+  // Sum of the bytes of 'previousMemos_'.
+  uint64_t previousMemoBytes_{0};
+
   // Count of executions where this is wrapped in a dictionary so that
   // results could be cached.
   int32_t numCachableInput_{0};
@@ -691,6 +724,17 @@ class ExprSet {
     memoizingExprs_.insert(expr);
   }
 
+  /// Counts a rewrite of an expression by the compiler rule 'rule'.
+  void addSimplification(const std::string& rule) {
+    ++simplifications_[rule];
+  }
+
+  /// Returns the number of expressions rewritten by each compiler rule, keyed
+  /// on rule name. Rules apply only if constant folding is enabled.
+  const std::unordered_map<std::string, int64_t>& simplifications() const {
+    return simplifications_;
+  }
+
   /// Returns text representation of the expression set.
   /// @param compact If true, uses one-line representation for each expression.
   /// Otherwise, prints a tree of expressions one node per line.
@@ -720,6 +764,9 @@ class ExprSet {
 
   // Exprs which retain memoized state, e.g. from running over dictionaries.
   std::unordered_set<Expr*> memoizingExprs_;
+
+  // Count of compile time rewrites keyed on rule name.
+  std::unordered_map<std::string, int64_t> simplifications_;
   core::ExecCtx* FOLLY_NONNULL const execCtx_;
 };
 
@@ -769,6 +816,10 @@ struct ExprSetCompletionEvent {
   std::vector<std::string> sqls;
   // Query id corresponding query
   std::string queryId;
+  /// Number of expressions rewritten by each expression compiler rule, keyed
+  /// on rule name, e.g. identity, redundant_cast, conjunct_constant or
+  /// coalesce.
+  std::unordered_map<std::string, int64_t> simplifications;
 };
 
 /// Listener invoked on ExprSet destruction.
@@ -36,6 +36,7 @@ using core::TypedExprPtr;
 
 const char* const kAnd = "and";
 const char* const kOr = "or";
+const char* const kCoalesce = "coalesce";
 const char* const kRowConstructor = "row_constructor";
 
 struct ITypedExprHasher {
@@ -343,6 +344,155 @@ std::vector<VectorPtr> getConstantInputs(const std::vector<ExprPtr>& exprs) {
   return constants;
 }
 
+// Returns the value of 'expr' if this is a non-null constant of an integer
+// type.
+std::optional<int64_t> integerConstant(const ExprPtr& expr) {
+  auto constant = std::dynamic_pointer_cast<ConstantExpr>(expr);
+  if (!constant || constant->value()->isNullAt(0)) {
+    return std::nullopt;
+  }
+  const auto& value = constant->value();
+  switch (value->typeKind()) {
+    case TypeKind::TINYINT:
+      return value->as<SimpleVector<int8_t>>()->valueAt(0);
+    case TypeKind::SMALLINT:
+      return value->as<SimpleVector<int16_t>>()->valueAt(0);
+    case TypeKind::INTEGER:
+      return value->as<SimpleVector<int32_t>>()->valueAt(0);
+    case TypeKind::BIGINT:
+      return value->as<SimpleVector<int64_t>>()->valueAt(0);
+    default:
+      return std::nullopt;
+  }
+}
+
+// Returns the value of 'expr' if this is a non-null BOOLEAN constant.
+std::optional<bool> booleanConstant(const ExprPtr& expr) {
+  auto constant = std::dynamic_pointer_cast<ConstantExpr>(expr);
+  if (!constant || constant->value()->isNullAt(0) ||
+      constant->value()->typeKind() != TypeKind::BOOLEAN) {
+    return std::nullopt;
+  }
+  return constant->value()->as<SimpleVector<bool>>()->valueAt(0);
+}
+
+bool isNullConstant(const ExprPtr& expr) {
+  auto constant = std::dynamic_pointer_cast<ConstantExpr>(expr);
+  return constant && constant->value()->isNullAt(0);
+}
+
+// x + 0, 0 + x, x - 0, x * 1, 1 * x and x / 1 over integers are x.
+ExprPtr simplifyIdentity(
+    const std::string& name,
+    const TypePtr& type,
+    const std::vector<ExprPtr>& inputs) {
+  if (inputs.size() != 2 ||
+      !(type->kind() == TypeKind::TINYINT ||
+        type->kind() == TypeKind::SMALLINT ||
+        type->kind() == TypeKind::INTEGER ||
+        type->kind() == TypeKind::BIGINT)) {
+    return nullptr;
+  }
+  auto identity = [&](int32_t i, int64_t value) {
+    return integerConstant(inputs[i]) == value &&
+        *inputs[1 - i]->type() == *type;
+  };
+  if (name == "plus" || name == "multiply") {
+    const int64_t value = name == "plus" ? 0 : 1;
+    if (identity(1, value)) {
+      return inputs[0];
+    }
+    if (identity(0, value)) {
+      return inputs[1];
+    }
+  } else if (name == "minus" || name == "divide") {
+    if (identity(1, name == "minus" ? 0 : 1)) {
+      return inputs[0];
+    }
+  }
+  return nullptr;
+}
+
+// Drops TRUE inputs of AND and FALSE inputs of OR. Returns the remaining input
+// if only one is left or the constant if none is left. Otherwise returns
+// nullptr and leaves the remaining inputs in 'inputs'.
+ExprPtr simplifyConjunct(
+    bool isAnd,
+    std::vector<ExprPtr>& inputs,
+    memory::MemoryPool* pool,
+    ExprSet* exprSet) {
+  const auto numInputs = inputs.size();
+  inputs.erase(
+      std::remove_if(
+          inputs.begin(),
+          inputs.end(),
+          [&](const auto& input) { return booleanConstant(input) == isAnd; }),
+      inputs.end());
+  if (inputs.size() == numInputs) {
+    return nullptr;
+  }
+  exprSet->addSimplification("conjunct_constant");
+  if (inputs.empty()) {
+    return std::make_shared<ConstantExpr>(
+        BaseVector::createConstant(BOOLEAN(), isAnd, 1, pool));
+  }
+  return inputs.size() == 1 ? inputs[0] : nullptr;
+}
+
+// Drops null constants and the inputs after the first non-null constant of a
+// COALESCE. Returns the remaining input if only one is left. Otherwise returns
+// nullptr and leaves the remaining inputs in 'inputs'.
+ExprPtr simplifyCoalesce(std::vector<ExprPtr>& inputs, ExprSet* exprSet) {
+  std::vector<ExprPtr> kept;
+  for (auto& input : inputs) {
+    if (isNullConstant(input)) {
+      continue;
+    }
+    kept.push_back(input);
+    if (std::dynamic_pointer_cast<ConstantExpr>(input)) {
+      break;
+    }
+  }
+  if (kept.empty()) {
+    // All inputs are null constants.
+    kept.push_back(inputs[0]);
+  }
+  if (kept.size() == inputs.size() && inputs.size() > 1) {
+    return nullptr;
+  }
+  exprSet->addSimplification("coalesce");
+  inputs = std::move(kept);
+  return inputs.size() == 1 ? inputs[0] : nullptr;
+}
+
+// Rule based rewrites of a call to 'name' with compiled 'inputs'. Returns an
+// equivalent Expr or nullptr if the call is to be compiled as is. A rule may
+// remove redundant inputs from 'inputs'. Each rewrite is counted in
+// ExprSet::simplifications() under the name of the rule.
+ExprPtr trySimplifyCall(
+    const std::string& name,
+    const TypePtr& type,
+    std::vector<ExprPtr>& inputs,
+    memory::MemoryPool* pool,
+    ExprSet* exprSet) {
+  if (name == kAnd || name == kOr) {
+    return simplifyConjunct(name == kAnd, inputs, pool, exprSet);
+  }
+  if (name == kCoalesce) {
+    if (auto simplified = simplifyCoalesce(inputs, exprSet)) {
+      if (*simplified->type() == *type) {
+        return simplified;
+      }
+    }
+    return nullptr;
+  }
+  if (auto simplified = simplifyIdentity(name, type, inputs)) {
+    exprSet->addSimplification("identity");
+    return simplified;
+  }
+  return nullptr;
+}
+
 ExprPtr compileExpression(
     const TypedExprPtr& expr,
     Scope* scope,
@@ -376,6 +526,12 @@ ExprPtr compileExpression(
         resultType, std::move(compiledInputs), trackCpuUsage);
   } else if (auto cast = dynamic_cast<const core::CastTypedExpr*>(expr.get())) {
     VELOX_CHECK(!compiledInputs.empty());
+    if (enableConstantFolding && *compiledInputs[0]->type() == *resultType) {
+      // A cast to the type of the input is a no-op and cannot fail.
+      scope->exprSet->addSimplification("redundant_cast");
+      scope->visited[expr.get()] = compiledInputs[0];
+      return compiledInputs[0];
+    }
     auto castExpr = std::make_shared<CastExpr>(
         resultType, std::move(compiledInputs[0]), trackCpuUsage);
     if (cast->nullOnFailure()) {
@@ -384,6 +540,14 @@ ExprPtr compileExpression(
       result = castExpr;
     }
   } else if (auto call = dynamic_cast<const core::CallTypedExpr*>(expr.get())) {
+    if (enableConstantFolding) {
+      if (auto simplified = trySimplifyCall(
+              call->name(), resultType, compiledInputs, pool, scope->exprSet)) {
+        scope->visited[expr.get()] = simplified;
+        return simplified;
+      }
+      inputTypes = getTypes(compiledInputs);
+    }
     if (auto specialForm = getSpecialForm(
             call->name(),
             resultType,
@@ -133,6 +133,14 @@ class SimpleFunctionAdapter : public VectorFunction {
     }() && ...);
   }
 
+  /// When true, the UDF's callBatch() is used for batches where all arguments
+  /// are flat and null-free and all rows are selected.
+  constexpr bool static callBatchEligible() {
+    return FUNC::udf_has_callBatch && fastPathIteration &&
+        return_type_traits::typeKind != TypeKind::BOOLEAN &&
+        allArgsFlatConstantFastPathEligible();
+  }
+
   /// When true, a fast path for each possible combination of encodings will be
   /// used for reading arguments when all arguments are flat or constant
   /// primitivies.
@@ -284,12 +292,18 @@ class SimpleFunctionAdapter : public VectorFunction {
     // - the argument has flat encoding,
     // - the argument is singly-referenced and has singly-referenced values
     // and nulls buffers.
+    // The result is not reused with callBatch(), so that the input is intact
+    // if callBatch() throws and the rows are evaluated again one by one.
     bool isResultReused = false;
+    bool useCallBatch = false;
+    if constexpr (callBatchEligible()) {
+      useCallBatch = canCallBatch(rows, args);
+    }
     if constexpr (
         !FUNC::can_produce_null_output && !FUNC::udf_has_callNullFree &&
         return_type_traits::isPrimitiveType &&
         return_type_traits::isFixedWidth) {
-      if (!reusableResult->get()) {
+      if (!reusableResult->get() && !useCallBatch) {
         if (auto* arg = findReusableArg<0>(args)) {
           reusableResult = arg;
           isResultReused = true;
@@ -331,7 +345,9 @@ class SimpleFunctionAdapter : public VectorFunction {
     }
 
     std::vector<std::optional<LocalDecodedVector>> decoded;
-    if (allPrimitiveArgsFlatConstant(args)) {
+    if (useCallBatch && applyBatch(applyContext, args)) {
+      // All rows are computed.
+    } else if (allPrimitiveArgsFlatConstant(args)) {
       if constexpr (
           allArgsFlatConstantFastPathEligible() && specializeForAllEncodings) {
         unpackSpecializeForAllEncodings<0>(applyContext, args);
@@ -430,6 +446,57 @@ class SimpleFunctionAdapter : public VectorFunction {
   }
 
  private:
+  // Returns true if all of 'rows' can be computed with one call to
+  // callBatch() over the raw values of 'args'.
+  static bool canCallBatch(
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args) {
+    if (!rows.isAllSelected()) {
+      return false;
+    }
+    for (const auto& arg : args) {
+      if (!arg->isFlatEncoding() || arg->mayHaveNulls()) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Computes all rows with one call to callBatch(). Returns false if
+  // callBatch() throws. The caller then evaluates the rows one by one so that
+  // errors are set only for the failing rows.
+  bool applyBatch(
+      ApplyContext& applyContext,
+      const std::vector<VectorPtr>& args) const {
+    return applyBatchImpl(
+        applyContext, args, std::make_index_sequence<FUNC::num_args>());
+  }
+
+  template <size_t... Is>
+  bool applyBatchImpl(
+      ApplyContext& applyContext,
+      const std::vector<VectorPtr>& args,
+      std::index_sequence<Is...>) const {
+    try {
+      (*fn_).callBatch(
+          applyContext.resultWriter.data_,
+          rawArgValues<Is>(args)...,
+          applyContext.rows->end());
+    } catch (const std::exception&) {
+      return false;
+    }
+    return true;
+  }
+
+  template <int32_t POSITION>
+  static auto rawArgValues(const std::vector<VectorPtr>& args) {
+    using type =
+        typename VectorExec::template resolver<arg_at<POSITION>>::in_type;
+    return args[POSITION]
+        ->template asUnchecked<FlatVector<type>>()
+        ->rawValues();
+  }
+
   // This is called only when we know that all args are flat or constant and are
   // eligible for the optimization and the optimization is enabled.
   template <int32_t POSITION, typename... TReader>
@@ -43,6 +43,12 @@
 // expect simpleMinIntegerNullFreeFastPath to do about as well as
 // simpleMinInteger when null arrays or null elements are present because they
 // use the same code path after a quick additional check once per batch.
+//
+// simpleMultiplyAdd and simpleMultiplyAddCallBatch compute a * b + a over two
+// flat BIGINT columns without nulls. We expect the callBatch() version to be
+// faster because the loop over rows is inside the function and the compiler
+// can vectorize it, while call() is invoked once per row through the
+// SelectivityVector iteration.
 
 namespace facebook::velox::functions {
 
@@ -186,6 +192,36 @@ struct ArrayMinNullFreeFastPathFunction {
   }
 };
 
+template <typename T>
+struct MultiplyAddFunction {
+  VELOX_DEFINE_FUNCTION_TYPES(T);
+
+  FOLLY_ALWAYS_INLINE void
+  call(int64_t& out, const int64_t& a, const int64_t& b) {
+    out = a * b + a;
+  }
+};
+
+template <typename T>
+struct MultiplyAddCallBatchFunction {
+  VELOX_DEFINE_FUNCTION_TYPES(T);
+
+  FOLLY_ALWAYS_INLINE void
+  call(int64_t& out, const int64_t& a, const int64_t& b) {
+    out = a * b + a;
+  }
+
+  FOLLY_ALWAYS_INLINE void callBatch(
+      int64_t* FOLLY_NONNULL out,
+      const int64_t* FOLLY_NONNULL a,
+      const int64_t* FOLLY_NONNULL b,
+      int32_t size) {
+    for (auto i = 0; i < size; ++i) {
+      out[i] = a[i] * b[i] + a[i];
+    }
+  }
+};
+
 void registerSimpleFunctions() {
   registerFunction<ArrayMinSimpleFunction, int32_t, Array<int32_t>>(
       {"array_min_simple"});
@@ -197,6 +233,11 @@ void registerSimpleFunctions() {
 
   registerFunction<ArrayMinNullFreeFastPathFunction, int32_t, Array<int32_t>>(
       {"array_min_null_free_fast_path"});
+
+  registerFunction<MultiplyAddFunction, int64_t, int64_t, int64_t>(
+      {"multiply_add"});
+  registerFunction<MultiplyAddCallBatchFunction, int64_t, int64_t, int64_t>(
+      {"multiply_add_call_batch"});
 }
 
 namespace {
@@ -221,6 +262,15 @@ class CallNullFreeBenchmark : public functions::test::FunctionBenchmarkBase {
     return vectorMaker_.rowVector({arrayVector});
   }
 
+  RowVectorPtr makeFlatData() {
+    const vector_size_t size = 1'000;
+    return vectorMaker_.rowVector(
+        {vectorMaker_.flatVector<int64_t>(
+             size, [](auto row) { return row % 17; }),
+         vectorMaker_.flatVector<int64_t>(
+             size, [](auto row) { return row % 31; })});
+  }
+
   size_t runFast() {
     folly::BenchmarkSuspender suspender;
     auto arrayVector = makeData()->childAt(0);
@@ -244,6 +294,16 @@ class CallNullFreeBenchmark : public functions::test::FunctionBenchmarkBase {
     return doRun(exprSet, rowVector);
   }
 
+  size_t runMultiplyAdd(const std::string& functionName) {
+    folly::BenchmarkSuspender suspender;
+    auto rowVector = makeFlatData();
+    auto exprSet = compileExpression(
+        fmt::format("{}(c0, c1)", functionName), rowVector->type());
+    suspender.dismiss();
+
+    return doRun(exprSet, rowVector);
+  }
+
   size_t doRun(exec::ExprSet& exprSet, const RowVectorPtr& rowVector) {
     int cnt = 0;
     for (auto i = 0; i < 100; i++) {
@@ -286,6 +346,14 @@ class CallNullFreeBenchmark : public functions::test::FunctionBenchmarkBase {
         VELOX_UNREACHABLE(fmt::format("testing failed at function {}", name));
       }
     }
+
+    auto flatInput = makeFlatData();
+    auto expected = evaluate("multiply_add(c0, c1)", flatInput);
+    auto callBatch =
+        compileExpression("multiply_add_call_batch(c0, c1)", flatInput->type());
+    if (!hasSameResults(expected, callBatch, flatInput)) {
+      VELOX_UNREACHABLE("testing failed at function multiply_add_call_batch");
+    }
   }
 };
 
@@ -308,6 +376,18 @@ BENCHMARK_MULTI(simpleMinIntegerNullFreeFastPath) {
   CallNullFreeBenchmark benchmark;
   return benchmark.runInteger("array_min_null_free_fast_path");
 }
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_MULTI(simpleMultiplyAdd) {
+  CallNullFreeBenchmark benchmark;
+  return benchmark.runMultiplyAdd("multiply_add");
+}
+
+BENCHMARK_MULTI(simpleMultiplyAddCallBatch) {
+  CallNullFreeBenchmark benchmark;
+  return benchmark.runMultiplyAdd("multiply_add_call_batch");
+}
 } // namespace
 } // namespace facebook::velox::functions
 
@@ -154,6 +154,7 @@ struct Event {
   std::string uuid;
   std::unordered_map<std::string, exec::ExprStats> stats;
   std::vector<std::string> sqls;
+  std::unordered_map<std::string, int64_t> simplifications;
 };
 
 class TestListener : public exec::ExprSetListener {
@@ -166,7 +167,7 @@ class TestListener : public exec::ExprSetListener {
   void onCompletion(
       const std::string& uuid,
       const exec::ExprSetCompletionEvent& event) override {
-    events_.push_back({uuid, event.stats, event.sqls});
+    events_.push_back({uuid, event.stats, event.sqls, event.simplifications});
   }
 
   void onError(
@@ -303,6 +304,54 @@ TEST_F(ExprStatsTest, listener) {
   ASSERT_EQ(3, events.size());
 }
 
+TEST_F(ExprStatsTest, simplifications) {
+  std::vector<Event> events;
+  std::vector<std::string> exceptions;
+  auto listener = std::make_shared<TestListener>(events, exceptions);
+  ASSERT_TRUE(exec::registerExprSetListener(listener));
+
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>({1, 2, 3}),
+      makeFlatVector<int32_t>({10, 20, 30}),
+  });
+
+  auto rowType = asRowType(data->type());
+  {
+    auto exprSet = compileExpressions(
+        {"c0 + 0",
+         "1 * c0",
+         "cast(c1 as integer)",
+         "c0 > 1 AND true",
+         "coalesce(c1, 5, c1)"},
+        rowType);
+    ASSERT_EQ(
+        exprSet->toString(),
+        "c0\n"
+        "c0\n"
+        "c1\n"
+        "gt(c0, 1:BIGINT)\n"
+        "coalesce(c1, 5:INTEGER)");
+    evaluate(*exprSet, data);
+  }
+  ASSERT_EQ(1, events.size());
+  const auto& simplifications = events.back().simplifications;
+  ASSERT_EQ(4, simplifications.size());
+  ASSERT_EQ(2, simplifications.at("identity"));
+  ASSERT_EQ(1, simplifications.at("redundant_cast"));
+  ASSERT_EQ(1, simplifications.at("conjunct_constant"));
+  ASSERT_EQ(1, simplifications.at("coalesce"));
+
+  // Expressions without redundant parts are compiled as is.
+  {
+    auto exprSet = compileExpressions({"c0 + 1", "c0 > 1 AND c1 < 5"}, rowType);
+    evaluate(*exprSet, data);
+  }
+  ASSERT_EQ(2, events.size());
+  ASSERT_TRUE(events.back().simplifications.empty());
+
+  ASSERT_TRUE(exec::unregisterExprSetListener(listener));
+}
+
 TEST_F(ExprStatsTest, specialForms) {
   vector_size_t size = 1'024;
 
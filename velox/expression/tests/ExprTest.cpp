@@ -451,6 +451,43 @@ TEST_F(ExprTest, reorder) {
   }
 }
 
+TEST_F(ExprTest, reorderFollowsData) {
+  constexpr int32_t kBatchSize = 10'000;
+  // A long first phase builds up a history that, without decay, would keep
+  // the old order for hundreds of batches after the data changes. With the
+  // history halved every kMaxSelectivityHistory rows, the order switches
+  // within the short second phase.
+  constexpr int32_t kNumOldBatches = 5'000;
+  constexpr int32_t kNumNewBatches = 30;
+
+  // 'selective' passes 1% of the rows and 'nonSelective' 99%. The rows
+  // passed by 'selective' all pass 'nonSelective'.
+  auto selective = makeFlatVector<int64_t>(
+      kBatchSize, [](auto row) { return row % 100 == 0 ? 0 : 1'000; });
+  auto nonSelective = makeFlatVector<int64_t>(
+      kBatchSize, [](auto row) { return row % 100 == 1 ? 1'000 : 0; });
+  auto exprSet = compileExpression(
+      "c0 < 100 and c1 < 100", ROW({"c0", "c1"}, {BIGINT(), BIGINT()}));
+  auto condition =
+      std::dynamic_pointer_cast<exec::ConjunctExpr>(exprSet->expr(0));
+  ASSERT_TRUE(condition != nullptr);
+
+  // The first input to run should be the selective column.
+  auto oldData = makeRowVector({selective, nonSelective});
+  for (auto i = 0; i < kNumOldBatches; ++i) {
+    evaluate(exprSet.get(), oldData);
+  }
+  const auto* oldFirst = &condition->selectivityAt(0);
+  ASSERT_LT(oldFirst->numOut() * 10, oldFirst->numIn());
+
+  // After the columns swap, the other input should run first.
+  auto newData = makeRowVector({nonSelective, selective});
+  for (auto i = 0; i < kNumNewBatches; ++i) {
+    evaluate(exprSet.get(), newData);
+  }
+  ASSERT_NE(oldFirst, &condition->selectivityAt(0));
+}
+
 TEST_F(ExprTest, constant) {
   auto exprSet = compileExpression("1 + 2 + 3 + 4", ROW({}));
   auto constExpr = dynamic_cast<exec::ConstantExpr*>(exprSet->expr(0).get());
@@ -584,6 +621,18 @@ TEST_F(ExprTest, constantFolding) {
     exec::ExprSet exprSetFolded({expression}, execCtx_.get(), true);
     EXPECT_EQ(10, extractConstant(exprSetFolded.exprs().front().get()));
   }
+
+  {
+    // Additive and multiplicative identities are removed only when folding.
+    auto expression = parseExpression("c0 * 1 + 0", ROW({"c0"}, {BIGINT()}));
+    exec::ExprSet exprSetFolded({expression}, execCtx_.get(), true);
+    EXPECT_EQ("c0", exprSetFolded.toString());
+    EXPECT_EQ(2, exprSetFolded.simplifications().at("identity"));
+
+    exec::ExprSet exprSetUnfolded({expression}, execCtx_.get(), false);
+    EXPECT_EQ("plus", exprSetUnfolded.exprs().front()->name());
+    EXPECT_TRUE(exprSetUnfolded.simplifications().empty());
+  }
 }
 
 TEST_F(ExprTest, constantArray) {
@@ -2035,6 +2084,49 @@ TEST_F(ExprTest, memo) {
   assertEqualVectors(expectedResult, result);
 }
 
+TEST_F(ExprTest, memoAlternatingDictionaries) {
+  auto makeBase = [&](const std::string& prefix) {
+    return makeFlatVector<StringView>(1'000, [&](auto row) {
+      return StringView(fmt::format("{}{}", prefix, row));
+    });
+  };
+  auto firstBase = makeBase("a");
+  auto secondBase = makeBase("b");
+  auto indices = makeIndices(100, [](auto row) { return row * 3; });
+
+  auto rowType = ROW({"c0"}, {VARCHAR()});
+  auto exprSet = compileExpression("upper(c0)", rowType);
+  auto numUpperRows = [&]() {
+    return exprSet->stats()["upper"].numProcessedRows;
+  };
+  auto evaluateAndCheck = [&](const VectorPtr& base,
+                              const std::string& prefix) {
+    auto result = evaluate(
+        exprSet.get(), makeRowVector({wrapInDictionary(indices, 100, base)}));
+    auto expected = makeFlatVector<StringView>(100, [&](auto row) {
+      return StringView(fmt::format("{}{}", prefix, row * 3));
+    });
+    assertEqualVectors(expected, result);
+  };
+
+  evaluateAndCheck(firstBase, "A");
+  evaluateAndCheck(secondBase, "B");
+  ASSERT_EQ(numUpperRows(), 200);
+
+  // Both dictionaries have been seen with the same indices. Going back and
+  // forth between them reuses the values memoized for each.
+  evaluateAndCheck(firstBase, "A");
+  evaluateAndCheck(secondBase, "B");
+  evaluateAndCheck(firstBase, "A");
+  ASSERT_EQ(numUpperRows(), 200);
+
+  // A dictionary not seen before is computed.
+  evaluateAndCheck(makeBase("c"), "C");
+  ASSERT_EQ(numUpperRows(), 300);
+  evaluateAndCheck(secondBase, "B");
+  ASSERT_EQ(numUpperRows(), 300);
+}
+
 // This test triggers the situation when peelEncodings() produces an empty
 // selectivity vector, which if passed to evalWithMemo() causes the latter to
 // produce null Expr::dictionaryCache_, which leads to a crash in evaluation
@@ -3227,10 +3319,10 @@ TEST_F(ExprTest, applyFunctionNoResult) {
   // not.  Conjuncts have the nice property that they set throwOnError to
   // false and don't check if the result VectorPtr is nullptr.
   assertError(
-      "always_throws_vector_function(c0) AND true",
+      "always_throws_vector_function(c0) AND c0 IS NOT NULL",
       makeFlatVector<int32_t>({1, 2, 3}),
       "always_throws_vector_function(c0)",
-      "and(always_throws_vector_function(c0), true:BOOLEAN)",
+      "and(always_throws_vector_function(c0), not(is_null(c0)))",
       TestingAlwaysThrowsVectorFunction::kVeloxErrorMessage);
 
   exec::registerVectorFunction(
@@ -3239,10 +3331,10 @@ TEST_F(ExprTest, applyFunctionNoResult) {
       std::make_unique<NoOpVectorFunction>());
 
   assertError(
-      "no_op(c0) AND true",
+      "no_op(c0) AND c0 IS NOT NULL",
       makeFlatVector<int32_t>({1, 2, 3}),
       "no_op(c0)",
-      "and(no_op(c0), true:BOOLEAN)",
+      "and(no_op(c0), not(is_null(c0)))",
       "Function neither returned results nor threw exception.");
 }
 
@@ -1109,6 +1109,68 @@ TEST_F(SimpleFunctionTest, testAllNotNull) {
   assertEqualVectors(expected, result);
 }
 
+int32_t numCallBatch = 0;
+
+template <typename T>
+struct BatchPlusFunction {
+  VELOX_DEFINE_FUNCTION_TYPES(T);
+
+  void call(int64_t& out, const int64_t& a, const int64_t& b) {
+    VELOX_USER_CHECK_GE(a, 0);
+    out = a + b;
+  }
+
+  void callBatch(int64_t* out, const int64_t* a, const int64_t* b, int32_t n) {
+    ++numCallBatch;
+    for (auto i = 0; i < n; ++i) {
+      VELOX_USER_CHECK_GE(a[i], 0);
+      out[i] = a[i] + b[i];
+    }
+  }
+};
+
+// Test that callBatch() is used for flat null-free input and that other input
+// and errors are handled by call().
+TEST_F(SimpleFunctionTest, callBatch) {
+  registerFunction<BatchPlusFunction, int64_t, int64_t, int64_t>(
+      {"batch_plus"});
+  auto b = makeFlatVector<int64_t>(100, [](auto row) { return row * 10; });
+
+  numCallBatch = 0;
+  auto a = makeFlatVector<int64_t>(100, [](auto row) { return row; });
+  auto result = evaluate("batch_plus(c0, c1)", makeRowVector({a, b}));
+  auto expected =
+      makeFlatVector<int64_t>(100, [](auto row) { return row * 11; });
+  assertEqualVectors(expected, result);
+  EXPECT_EQ(numCallBatch, 1);
+
+  // Nulls go through call().
+  a = makeFlatVector<int64_t>(
+      100, [](auto row) { return row; }, nullEvery(7));
+  result = evaluate("batch_plus(c0, c1)", makeRowVector({a, b}));
+  expected = makeFlatVector<int64_t>(
+      100, [](auto row) { return row * 11; }, nullEvery(7));
+  assertEqualVectors(expected, result);
+  EXPECT_EQ(numCallBatch, 1);
+
+  // A constant argument goes through call().
+  a = makeFlatVector<int64_t>(100, [](auto row) { return row; });
+  result = evaluate("batch_plus(c0, 5)", makeRowVector({a}));
+  expected = makeFlatVector<int64_t>(100, [](auto row) { return row + 5; });
+  assertEqualVectors(expected, result);
+  EXPECT_EQ(numCallBatch, 1);
+
+  // If callBatch() throws, the rows are evaluated again with call() and only
+  // the failing rows get an error.
+  a = makeFlatVector<int64_t>(
+      100, [](auto row) { return row % 10 == 3 ? -1 : row; });
+  result = evaluate("try(batch_plus(c0, c1))", makeRowVector({a, b}));
+  expected = makeFlatVector<int64_t>(
+      100, [](auto row) { return row * 11; }, nullEvery(10, 3));
+  assertEqualVectors(expected, result);
+  EXPECT_EQ(numCallBatch, 2);
+}
+
 // Test that SimpleFunctionRegistry does not crash in multithreaded environment.
 TEST_F(SimpleFunctionTest, simpleFunctionRegistryThreadSafe) {
   std::vector<std::thread> threads;
@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
 #include "velox/functions/lib/window/tests/WindowTestBase.h"
 #include "velox/functions/prestosql/window/WindowFunctionsRegistration.h"
 
@@ -103,5 +105,59 @@ VELOX_INSTANTIATE_TEST_SUITE_P(
     RankTest,
     testing::ValuesIn(getRankTestParams()));
 
+class RankSpillTest : public WindowTestBase {
+ protected:
+  void SetUp() override {
+    WindowTestBase::SetUp();
+    window::prestosql::registerAllWindowFunctions();
+  }
+};
+
+TEST_F(RankSpillTest, spill) {
+  std::vector<RowVectorPtr> input;
+  for (int i = 0; i < 10; ++i) {
+    input.push_back(makeSimpleVector(1'000));
+  }
+  createDuckDbTable(input);
+
+  struct {
+    uint64_t windowMemLimit;
+    bool expectSpill;
+
+    std::string debugString() const {
+      return fmt::format(
+          "windowMemLimit:{}, expectSpill:{}", windowMemLimit, expectSpill);
+    }
+  } testSettings[] = {// Memory limit is disabled so spilling is not triggered.
+                      {0, false},
+                      // Memory limit is too small so always trigger spilling.
+                      {1, true},
+                      // Memory limit is too large so spilling is not triggered.
+                      {1'000'000'000, false}};
+  for (const auto& testData : testSettings) {
+    SCOPED_TRACE(testData.debugString());
+    for (const auto& function : kRankFunctions) {
+      SCOPED_TRACE(function);
+      auto queryInfo = buildWindowQuery(
+          input, function, "partition by c0 order by c1, c2, c3", "");
+      auto spillDirectory = TempDirectoryPath::create();
+      auto task =
+          AssertQueryBuilder(queryInfo.planNode, duckDbQueryRunner_)
+              .spillDirectory(spillDirectory->path)
+              .config(core::QueryConfig::kSpillEnabled, "true")
+              .config(core::QueryConfig::kWindowSpillEnabled, "true")
+              .config(
+                  core::QueryConfig::kWindowSpillMemoryThreshold,
+                  std::to_string(testData.windowMemLimit))
+              .assertResults(queryInfo.querySql);
+
+      auto stats = task->taskStats().pipelineStats;
+      ASSERT_EQ(
+          testData.expectSpill, stats[0].operatorStats[1].spilledBytes > 0);
+      OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
+    }
+  }
+}
+
 }; // namespace
 }; // namespace facebook::velox::window::test
@@ -21,6 +21,7 @@
 #include <string>
 
 #include "velox/common/base/Exceptions.h"
+#include "velox/common/encode/Base64.h"
 #include "velox/type/Filter.h"
 
 namespace facebook::velox::common {
@@ -88,6 +89,9 @@ std::string Filter::toString() const {
     case FilterKind::kHugeintRange:
       strKind = "HugeintRange";
       break;
+    case FilterKind::kValuesUsingBloomFilter:
+      strKind = "ValuesUsingBloomFilter";
+      break;
   };
 
   return fmt::format(
@@ -122,6 +126,7 @@ std::unordered_map<FilterKind, std::string> filterKindNames() {
       {FilterKind::kBigintMultiRange, "kBigintMultiRange"},
       {FilterKind::kMultiRange, "kMultiRange"},
       {FilterKind::kHugeintRange, "kHugeintRange"},
+      {FilterKind::kValuesUsingBloomFilter, "kValuesUsingBloomFilter"},
   };
 }
 
@@ -174,6 +179,7 @@ void Filter::registerSerDe() {
   registry.Register("BigintMultiRange", BigintMultiRange::create);
   registry.Register("NegatedBytesValues", NegatedBytesValues::create);
   registry.Register("MultiRange", MultiRange::create);
+  registry.Register("ValuesUsingBloomFilter", ValuesUsingBloomFilter::create);
 }
 
 folly::dynamic Filter::serializeBase(std::string_view name) const {
@@ -711,6 +717,43 @@ bool MultiRange::testingEquals(const Filter& other) const {
   return true;
 }
 
+folly::dynamic ValuesUsingBloomFilter::serialize() const {
+  auto obj = Filter::serializeBase("ValuesUsingBloomFilter");
+  std::string bloomFilter;
+  bloomFilter.resize(bloomFilter_.serializedSize());
+  bloomFilter_.serialize(bloomFilter.data());
+  obj["bloomFilter"] = encoding::Base64::encode(bloomFilter);
+  if (exactFilter_ != nullptr) {
+    obj["exactFilter"] = exactFilter_->serialize();
+  }
+  return obj;
+}
+
+FilterPtr ValuesUsingBloomFilter::create(const folly::dynamic& obj) {
+  auto nullAllowed = deserializeNullAllowed(obj);
+  const auto serialized =
+      encoding::Base64::decode(obj["bloomFilter"].asString());
+  SplitBlockBloomFilter<> bloomFilter;
+  bloomFilter.deserialize(serialized.data());
+  std::shared_ptr<const Filter> exactFilter;
+  if (obj.count("exactFilter")) {
+    exactFilter = ISerializable::deserialize<Filter>(obj["exactFilter"]);
+  }
+  return std::make_unique<ValuesUsingBloomFilter>(
+      std::move(bloomFilter), nullAllowed, std::move(exactFilter));
+}
+
+bool ValuesUsingBloomFilter::testingEquals(const Filter& other) const {
+  auto otherBloom = dynamic_cast<const ValuesUsingBloomFilter*>(&other);
+  if (otherBloom == nullptr || !Filter::testingBaseEquals(other) ||
+      !(bloomFilter_ == otherBloom->bloomFilter_) ||
+      (exactFilter_ == nullptr) != (otherBloom->exactFilter_ == nullptr)) {
+    return false;
+  }
+  return exactFilter_ == nullptr ||
+      exactFilter_->testingEquals(*otherBloom->exactFilter_);
+}
+
 BigintValuesUsingBitmask::BigintValuesUsingBitmask(
     int64_t min,
     int64_t max,
@@ -1433,6 +1476,7 @@ std::unique_ptr<Filter> MultiRange::mergeWith(const Filter* other) const {
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kValuesUsingBloomFilter:
     case FilterKind::kNegatedBytesRange:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
@@ -1712,6 +1756,7 @@ std::unique_ptr<Filter> BigintRange::mergeWith(const Filter* other) const {
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kValuesUsingBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
       return std::make_unique<BigintRange>(lower_, upper_, false);
@@ -1780,6 +1825,7 @@ std::unique_ptr<Filter> NegatedBigintRange::mergeWith(
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kValuesUsingBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
       return this->clone(false);
@@ -1873,6 +1919,7 @@ std::unique_ptr<Filter> BigintValuesUsingHashTable::mergeWith(
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kValuesUsingBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
       return std::make_unique<BigintValuesUsingHashTable>(*this, false);
@@ -1964,6 +2011,7 @@ std::unique_ptr<Filter> BigintValuesUsingBitmask::mergeWith(
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kValuesUsingBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
       return std::make_unique<BigintValuesUsingBitmask>(*this, false);
@@ -2047,6 +2095,7 @@ std::unique_ptr<Filter> NegatedBigintValuesUsingHashTable::mergeWith(
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kValuesUsingBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
       return std::make_unique<NegatedBigintValuesUsingHashTable>(*this, false);
@@ -2086,6 +2135,7 @@ std::unique_ptr<Filter> NegatedBigintValuesUsingBitmask::mergeWith(
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kValuesUsingBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
       return std::make_unique<NegatedBigintValuesUsingBitmask>(*this, false);
@@ -2121,6 +2171,7 @@ std::unique_ptr<Filter> BigintMultiRange::mergeWith(const Filter* other) const {
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kValuesUsingBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull: {
       std::vector<std::unique_ptr<BigintRange>> ranges;
@@ -2202,6 +2253,7 @@ std::unique_ptr<Filter> BytesRange::mergeWith(const Filter* other) const {
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kValuesUsingBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
       return this->clone(false);
@@ -2281,6 +2333,7 @@ std::unique_ptr<Filter> NegatedBytesRange::mergeWith(
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kValuesUsingBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
       return this->clone(false);
@@ -2303,6 +2356,7 @@ std::unique_ptr<Filter> BytesValues::mergeWith(const Filter* other) const {
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kValuesUsingBloomFilter:
     case FilterKind::kMultiRange:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
@@ -2415,6 +2469,7 @@ std::unique_ptr<Filter> NegatedBytesValues::mergeWith(
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kValuesUsingBloomFilter:
     case FilterKind::kBytesValues:
     case FilterKind::kNegatedBytesRange:
     case FilterKind::kMultiRange:
@@ -2510,4 +2565,88 @@ std::unique_ptr<Filter> NegatedBytesValues::mergeWith(
       VELOX_UNREACHABLE();
   }
 }
+
+bool ValuesUsingBloomFilter::testInt64Range(
+    int64_t min,
+    int64_t max,
+    bool hasNull) const {
+  if (hasNull && nullAllowed_) {
+    return true;
+  }
+  if (exactFilter_ != nullptr &&
+      !exactFilter_->testInt64Range(min, max, hasNull)) {
+    return false;
+  }
+  if (min == max) {
+    return bloomFilter_.mayContain(hashInt64(min));
+  }
+  return true;
+}
+
+bool ValuesUsingBloomFilter::testBytesRange(
+    std::optional<std::string_view> min,
+    std::optional<std::string_view> max,
+    bool hasNull) const {
+  if (hasNull && nullAllowed_) {
+    return true;
+  }
+  if (exactFilter_ != nullptr &&
+      !exactFilter_->testBytesRange(min, max, hasNull)) {
+    return false;
+  }
+  if (min.has_value() && max.has_value() && min.value() == max.value()) {
+    return bloomFilter_.mayContain(
+        hashBytes(min.value().data(), min.value().size()));
+  }
+  return true;
+}
+
+std::unique_ptr<Filter> ValuesUsingBloomFilter::mergeWith(
+    const Filter* other) const {
+  switch (other->kind()) {
+    case FilterKind::kAlwaysTrue:
+    case FilterKind::kAlwaysFalse:
+    case FilterKind::kIsNull:
+      return other->mergeWith(this);
+    case FilterKind::kIsNotNull:
+      return this->clone(/*nullAllowed=*/false);
+    case FilterKind::kValuesUsingBloomFilter: {
+      auto otherBloom = static_cast<const ValuesUsingBloomFilter*>(other);
+      const bool bothNullAllowed = nullAllowed_ && other->testNull();
+      std::shared_ptr<const Filter> exactFilter = exactFilter_;
+      if (otherBloom->exactFilter_ != nullptr) {
+        exactFilter = exactFilter_ == nullptr
+            ? otherBloom->exactFilter_
+            : std::shared_ptr<const Filter>(
+                  exactFilter_->mergeWith(otherBloom->exactFilter_.get()));
+      }
+      if (exactFilter != nullptr &&
+          (exactFilter->kind() == FilterKind::kAlwaysFalse ||
+           exactFilter->kind() == FilterKind::kIsNull)) {
+        return nullOrFalse(bothNullAllowed);
+      }
+      auto bloomFilter = bloomFilter_;
+      // Bloom filters of different sizes cannot be intersected. Keeping only
+      // one of them is safe since the filter is approximate anyway.
+      if (bloomFilter.numBytes() == otherBloom->bloomFilter_.numBytes()) {
+        bloomFilter.intersect(otherBloom->bloomFilter_);
+      }
+      return std::make_unique<ValuesUsingBloomFilter>(
+          std::move(bloomFilter), bothNullAllowed, std::move(exactFilter));
+    }
+    default: {
+      // 'other' is an exact filter on the same column.
+      const bool bothNullAllowed = nullAllowed_ && other->testNull();
+      std::shared_ptr<const Filter> exactFilter = exactFilter_ == nullptr
+          ? std::shared_ptr<const Filter>(other->clone())
+          : std::shared_ptr<const Filter>(exactFilter_->mergeWith(other));
+      if (exactFilter->kind() == FilterKind::kAlwaysFalse ||
+          exactFilter->kind() == FilterKind::kIsNull) {
+        return nullOrFalse(bothNullAllowed);
+      }
+      return std::make_unique<ValuesUsingBloomFilter>(
+          bloomFilter_, bothNullAllowed, std::move(exactFilter));
+    }
+  }
+}
 } // namespace facebook::velox::common
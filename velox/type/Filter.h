@@ -24,7 +24,10 @@
 
 #include <folly/Range.h>
 #include <folly/container/F14Set.h>
+#include <folly/hash/Hash.h>
+#include <folly/hash/SpookyHashV2.h>
 
+#include "velox/common/base/BloomFilter.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/SimdUtil.h"
 #include "velox/common/serialization/Serializable.h"
@@ -55,6 +58,7 @@ enum class FilterKind {
   kBigintMultiRange,
   kMultiRange,
   kHugeintRange,
+  kValuesUsingBloomFilter,
 };
 
 class Filter;
@@ -1898,6 +1902,111 @@ class MultiRange final : public Filter {
   const bool nanAllowed_;
 };
 
+/// Approximate IN-list filter for integer and string data types backed by a
+/// split block Bloom filter. Produced from the build side of a hash join and
+/// pushed down into the probe side scan. Values that were not added to the
+/// Bloom filter fail with a high probability, values that were added always
+/// pass. Integer values are hashed with hashInt64() and strings with
+/// hashBytes(). The filter may be combined with an exact filter on the same
+/// column, e.g. a range filter from the query, which is then evaluated first.
+class ValuesUsingBloomFilter final : public Filter {
+ public:
+  /// @param bloomFilter Bloom filter over the hashes of the values that pass.
+  /// Must not be empty.
+  /// @param nullAllowed Null values are passing the filter if true.
+  /// @param exactFilter Optional filter that must also pass.
+  ValuesUsingBloomFilter(
+      SplitBlockBloomFilter<> bloomFilter,
+      bool nullAllowed,
+      std::shared_ptr<const Filter> exactFilter = nullptr)
+      : Filter(true, nullAllowed, FilterKind::kValuesUsingBloomFilter),
+        bloomFilter_(std::move(bloomFilter)),
+        exactFilter_(std::move(exactFilter)) {
+    VELOX_CHECK(bloomFilter_.isSet(), "Bloom filter must not be empty");
+    VELOX_CHECK(
+        exactFilter_ == nullptr ||
+            exactFilter_->kind() != FilterKind::kValuesUsingBloomFilter,
+        "Bloom filters must be merged with intersect()");
+  }
+
+  ValuesUsingBloomFilter(const ValuesUsingBloomFilter& other, bool nullAllowed)
+      : Filter(true, nullAllowed, FilterKind::kValuesUsingBloomFilter),
+        bloomFilter_(other.bloomFilter_),
+        exactFilter_(other.exactFilter_) {}
+
+  static uint64_t hashInt64(int64_t value) {
+    return folly::hasher<int64_t>()(value);
+  }
+
+  static uint64_t hashBytes(const char* value, int32_t length) {
+    return folly::hash::SpookyHashV2::Hash64(value, length, 0);
+  }
+
+  folly::dynamic serialize() const override;
+
+  static FilterPtr create(const folly::dynamic& obj);
+
+  std::unique_ptr<Filter> clone(
+      std::optional<bool> nullAllowed = std::nullopt) const final {
+    if (nullAllowed) {
+      return std::make_unique<ValuesUsingBloomFilter>(
+          *this, nullAllowed.value());
+    } else {
+      return std::make_unique<ValuesUsingBloomFilter>(*this);
+    }
+  }
+
+  bool testInt64(int64_t value) const final {
+    return (exactFilter_ == nullptr || exactFilter_->testInt64(value)) &&
+        bloomFilter_.mayContain(hashInt64(value));
+  }
+
+  bool testBytes(const char* value, int32_t length) const final {
+    return (exactFilter_ == nullptr ||
+            exactFilter_->testBytes(value, length)) &&
+        bloomFilter_.mayContain(hashBytes(value, length));
+  }
+
+  bool hasTestLength() const final {
+    return exactFilter_ != nullptr && exactFilter_->hasTestLength();
+  }
+
+  bool testLength(int32_t length) const final {
+    return exactFilter_ == nullptr || exactFilter_->testLength(length);
+  }
+
+  bool testInt64Range(int64_t min, int64_t max, bool hasNull) const final;
+
+  bool testBytesRange(
+      std::optional<std::string_view> min,
+      std::optional<std::string_view> max,
+      bool hasNull) const final;
+
+  std::unique_ptr<Filter> mergeWith(const Filter* other) const final;
+
+  const SplitBlockBloomFilter<>& bloomFilter() const {
+    return bloomFilter_;
+  }
+
+  const std::shared_ptr<const Filter>& exactFilter() const {
+    return exactFilter_;
+  }
+
+  std::string toString() const final {
+    return fmt::format(
+        "ValuesUsingBloomFilter: {} bytes{}{}",
+        bloomFilter_.numBytes(),
+        exactFilter_ ? " AND " + exactFilter_->toString() : "",
+        nullAllowed_ ? " with nulls" : " no nulls");
+  }
+
+  bool testingEquals(const Filter& other) const final;
+
+ private:
+  const SplitBlockBloomFilter<> bloomFilter_;
+  const std::shared_ptr<const Filter> exactFilter_;
+};
+
 // Helper for applying filters to different types
 template <typename TFilter, typename T>
 static inline bool applyFilter(TFilter& filter, T value) {
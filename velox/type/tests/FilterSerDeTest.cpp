@@ -138,3 +138,15 @@ TEST_F(FilterSerDeTest, multiFilter) {
   MultiRange multiRange(std::move(filters), true, true);
   testSerde(multiRange);
 }
+
+TEST_F(FilterSerDeTest, bloomFilter) {
+  SplitBlockBloomFilter<> bloomFilter;
+  bloomFilter.reset(100);
+  for (auto i = 0; i < 100; ++i) {
+    bloomFilter.insert(ValuesUsingBloomFilter::hashInt64(i));
+  }
+  testSerde(ValuesUsingBloomFilter(bloomFilter, true));
+  testSerde(ValuesUsingBloomFilter(bloomFilter, false));
+  testSerde(ValuesUsingBloomFilter(
+      bloomFilter, false, std::make_shared<BigintRange>(0, 50, false)));
+}
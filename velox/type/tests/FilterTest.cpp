@@ -1820,3 +1820,71 @@ TEST(FilterTest, dateRange) {
   EXPECT_TRUE(applyFilter(*filter, Date(10)));
   EXPECT_FALSE(applyFilter(*filter, Date(101)));
 }
+
+TEST(FilterTest, valuesUsingBloomFilter) {
+  SplitBlockBloomFilter<> bloomFilter;
+  bloomFilter.reset(1'000);
+  for (auto i = 0; i < 1'000; ++i) {
+    bloomFilter.insert(ValuesUsingBloomFilter::hashInt64(i * 2));
+  }
+  const std::string kValue = "a long enough string value";
+  bloomFilter.insert(
+      ValuesUsingBloomFilter::hashBytes(kValue.data(), kValue.size()));
+  auto filter = std::make_unique<ValuesUsingBloomFilter>(bloomFilter, false);
+
+  int32_t numFalsePositives = 0;
+  for (auto i = 0; i < 1'000; ++i) {
+    EXPECT_TRUE(filter->testInt64(i * 2));
+    numFalsePositives += filter->testInt64(i * 2 + 1);
+  }
+  EXPECT_LT(numFalsePositives, 20);
+  EXPECT_TRUE(filter->testBytes(kValue.data(), kValue.size()));
+  EXPECT_FALSE(filter->testNull());
+  EXPECT_FALSE(filter->hasTestLength());
+
+  // Ranges can only be decided on a single value.
+  EXPECT_TRUE(filter->testInt64Range(1, 3, false));
+  EXPECT_TRUE(filter->testInt64Range(2, 2, false));
+  EXPECT_TRUE(filter->testBytesRange(kValue, kValue, false));
+  EXPECT_TRUE(filter->testBytesRange(std::nullopt, kValue, false));
+
+  EXPECT_TRUE(filter->clone(true)->testNull());
+
+  // Merge with an exact filter keeps both.
+  BigintRange range(0, 100, false);
+  auto merged = filter->mergeWith(&range);
+  ASSERT_EQ(FilterKind::kValuesUsingBloomFilter, merged->kind());
+  EXPECT_TRUE(merged->testInt64(100));
+  EXPECT_FALSE(merged->testInt64(102));
+  EXPECT_FALSE(merged->testInt64Range(200, 300, false));
+  ASSERT_EQ(
+      FilterKind::kValuesUsingBloomFilter,
+      range.mergeWith(filter.get())->kind());
+
+  // Merge with an exact filter that excludes all the values of the other one.
+  BigintRange disjointRange(-10, -1, true);
+  EXPECT_EQ(
+      FilterKind::kAlwaysFalse, merged->mergeWith(&disjointRange)->kind());
+
+  // Merge with null filters.
+  IsNotNull isNotNull;
+  IsNull isNull;
+  EXPECT_FALSE(filter->clone(true)->mergeWith(&isNotNull)->testNull());
+  EXPECT_EQ(FilterKind::kAlwaysFalse, filter->mergeWith(&isNull)->kind());
+
+  // Merge with another Bloom filter of the same size intersects them.
+  SplitBlockBloomFilter<> otherBloomFilter;
+  otherBloomFilter.reset(1'000);
+  for (auto i = 0; i < 500; ++i) {
+    otherBloomFilter.insert(ValuesUsingBloomFilter::hashInt64(i * 2));
+  }
+  ValuesUsingBloomFilter other(otherBloomFilter, false);
+  merged = filter->mergeWith(&other);
+  ASSERT_EQ(FilterKind::kValuesUsingBloomFilter, merged->kind());
+  int32_t numPassed = 0;
+  for (auto i = 0; i < 500; ++i) {
+    EXPECT_TRUE(merged->testInt64(i * 2));
+    numPassed += merged->testInt64(1'000 + i * 2);
+  }
+  EXPECT_LT(numPassed, 50);
+}